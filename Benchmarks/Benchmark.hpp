@@ -0,0 +1,349 @@
+#pragma once
+#include <algorithm>      // max(), min()
+#include <chrono>         // steady_clock, duration
+#include <cstddef>        // size_t
+#include <cstdint>        // int64_t, uint64_t
+#include <ctime>          // clock(), time(), strftime()
+#include <fstream>        // ofstream
+#include <iomanip>        // setw(), setprecision()
+#include <iostream>       // cout, cerr
+#include <ostream>
+#include <sstream>        // ostringstream
+#include <string>
+#include <string_view>
+#include <utility>        // move()
+#include <vector>
+
+
+// A small, dependency free micro benchmark harness in the spirit of Google Benchmark.  A benchmark is a function taking a State,
+// registered once under a name and (optionally) a list of arguments - typically sizes - it should be run with:
+//
+//    Benchmark::Register findBenchmark( "GroceryList/find", []( Benchmark::State & state )
+//    {
+//      auto list = makeList( state.range() );                                  // setup, not timed
+//      for( auto _ : state )   Benchmark::doNotOptimize( list.find( target ) ); // only the loop is timed
+//    }, { 8, 64, 512 } );
+//
+// Each (benchmark, argument) pair is run with more and more iterations until a run takes at least the minimum time, and that run
+// is reported as time per iteration.  Benchmark::runAll() is meant to be called from main() and understands these command line
+// options:
+//
+//    --benchmark_filter=<text>     run only benchmarks whose name, including the argument, contains <text>
+//    --benchmark_min_time=<secs>   minimum time per measurement, default 0.1
+//    --benchmark_format=<format>   console (default), json, or csv written to standard output
+//    --benchmark_out=<file>        also write the results to <file> ...
+//    --benchmark_out_format=<fmt>  ... as json (default) or csv
+namespace Benchmark
+{
+  // Keeps the compiler from optimizing away a value computed only to be measured.  The empty assembly statement claims to read the
+  // value through its address and to touch all of memory, so the value must really be computed and stored.
+  template<typename T>
+  inline void doNotOptimize( T const & value )
+  {
+    asm volatile( "" : : "g"( &value ) : "memory" );
+  }
+
+
+
+  // The benchmark's view of a measurement in progress
+  class State
+  {
+    public:
+      State( std::int64_t argument, std::uint64_t iterations ) : _argument( argument ), _iterations( iterations ) {}
+
+      // Range-for support:  for( auto _ : state ) { ... }  runs the body iterations() times, timing only the loop
+      struct Sentinel {};
+      struct [[maybe_unused]] Value {};                                                    // the loop variable, marked so it isn't reported as unused
+      class Iterator
+      {
+        public:
+          explicit Iterator( State & state ) : _state( state ), _remaining( state._iterations ) {}
+
+          bool       operator!=( Sentinel ) const  { if( _remaining != 0 ) return true;  _state.stop();  return false; }
+          void       operator++()                  { --_remaining; }
+          Value      operator* () const            { return {}; }
+
+        private:
+          State &       _state;
+          std::uint64_t _remaining;
+      };
+
+      Iterator begin()  { start();  return Iterator( *this ); }
+      Sentinel end  ()  { return {}; }
+
+
+      // Queries
+      std::int64_t  range     () const noexcept  { return _argument;   }                      // the argument this run was registered with
+      std::uint64_t iterations() const noexcept  { return _iterations; }
+
+
+      // Modifiers
+      void pauseTiming ()                               { accumulate();  _running = false; }  // exclude per iteration setup or cleanup from the
+      void resumeTiming()                               { _running = true;  mark();        }  // measurement, at a cost of a couple of clock reads
+      void setItemsProcessed( std::int64_t items )      { _items = items;                  }  // totals over all iterations, reported as rates
+      void setBytesProcessed( std::int64_t bytes )      { _bytes = bytes;                  }  // per second
+      void setLabel         ( std::string  label )      { _label = std::move( label );     }  // reported after the rates, for anything else worth noting
+
+
+    private:
+      friend struct Runner;
+
+      void start()       { _running = true;  mark(); }
+      void stop ()       { accumulate();  _running = false; }
+      // The wall clock is read innermost so the (comparatively slow) processor clock reads don't count against the benchmark
+      void mark ()       { _cpuStart = std::clock();  _realStart = std::chrono::steady_clock::now(); }
+      void accumulate()
+      {
+        if( !_running ) return;
+        _realSeconds += std::chrono::duration<double>( std::chrono::steady_clock::now() - _realStart ).count();
+        _cpuSeconds  += static_cast<double>( std::clock() - _cpuStart ) / CLOCKS_PER_SEC;
+      }
+
+      std::int64_t                          _argument;
+      std::uint64_t                         _iterations;
+      bool                                  _running     = false;
+      std::chrono::steady_clock::time_point _realStart   = {};
+      std::clock_t                          _cpuStart    = 0;
+      double                                _realSeconds = 0.0;
+      double                                _cpuSeconds  = 0.0;
+      std::int64_t                          _items       = 0;
+      std::int64_t                          _bytes       = 0;
+      std::string                           _label;
+  };
+
+
+
+  using Function = void (*)( State & );
+
+  struct Registration
+  {
+    std::string               name;
+    Function                  function;
+    std::vector<std::int64_t> arguments;                                                      // empty means run once, with range() == 0
+  };
+
+  inline std::vector<Registration> & registry()                                              // function local, so safe to use during static initialization
+  {
+    static std::vector<Registration> benchmarks;
+    return benchmarks;
+  }
+
+  struct Register
+  {
+    Register( std::string name, Function function, std::vector<std::int64_t> arguments = {} )
+    { registry().push_back( { std::move( name ), function, std::move( arguments ) } ); }
+  };
+
+
+
+  // One reported measurement
+  struct Result
+  {
+    std::string   name;
+    std::uint64_t iterations     = 0;
+    double        realNanoseconds = 0.0;                                                      // per iteration
+    double        cpuNanoseconds  = 0.0;                                                      // per iteration
+    double        itemsPerSecond  = 0.0;                                                      // 0 if not reported
+    double        bytesPerSecond  = 0.0;                                                      // 0 if not reported
+    std::string   label;                                                                      // empty if not reported
+  };
+
+
+
+  struct Runner
+  {
+    double      minimumSeconds = 0.1;
+    std::string filter;
+
+    Result run( Registration const & benchmark, std::string name, std::int64_t argument ) const
+    {
+      // Keep growing the iteration count, aiming a little past the minimum time, until a run takes long enough to trust
+      std::uint64_t iterations = 1;
+      while( true )
+      {
+        State state( argument, iterations );
+        benchmark.function( state );
+
+        if( state._realSeconds >= minimumSeconds  ||  iterations >= 1'000'000'000 )
+        {
+          Result result;
+          result.name            = std::move( name );
+          result.iterations      = iterations;
+          result.realNanoseconds = state._realSeconds * 1e9 / static_cast<double>( iterations );
+          result.cpuNanoseconds  = state._cpuSeconds  * 1e9 / static_cast<double>( iterations );
+          result.label           = std::move( state._label );
+          if( state._realSeconds > 0.0 )
+          {
+            result.itemsPerSecond = static_cast<double>( state._items ) / state._realSeconds;
+            result.bytesPerSecond = static_cast<double>( state._bytes ) / state._realSeconds;
+          }
+          return result;
+        }
+
+        auto const scale = state._realSeconds > 0.0 ? 1.4 * minimumSeconds / state._realSeconds : 10.0;
+        iterations = static_cast<std::uint64_t>( static_cast<double>( iterations ) * std::min( 10.0, std::max( 2.0, scale ) ) );
+      }
+    }
+  };
+
+
+
+  // Reporters
+  inline void reportConsoleHeader( std::ostream & stream )
+  {
+    stream << std::left << std::setw( 48 ) << "Benchmark" << std::right << std::setw( 15 ) << "Time (ns)" << std::setw( 15 ) << "CPU (ns)"
+           << std::setw( 14 ) << "Iterations" << "  Rate\n" << std::string( 100, '-' ) << '\n';
+  }
+
+  inline void reportConsole( std::ostream & stream, Result const & result )
+  {
+    stream << std::left << std::setw( 48 ) << result.name << std::right << std::fixed << std::setprecision( 1 )
+           << std::setw( 15 ) << result.realNanoseconds << std::setw( 15 ) << result.cpuNanoseconds << std::setw( 14 ) << result.iterations;
+    if( result.bytesPerSecond > 0.0 ) stream << "  " << std::setprecision( 2 ) << result.bytesPerSecond / ( 1024.0 * 1024.0 ) << " MiB/s";
+    if( result.itemsPerSecond > 0.0 ) stream << "  " << std::setprecision( 0 ) << result.itemsPerSecond                       << " items/s";
+    if( !result.label.empty()       ) stream << "  " << result.label;
+    stream << std::endl;
+  }
+
+  inline std::string jsonString( std::string_view text )
+  {
+    std::string quoted = "\"";
+    for( char c : text )
+    {
+      if     ( c == '"'  ||  c == '\\' )   { quoted += '\\';  quoted += c; }
+      else if( c == '\n'               )   quoted += "\\n";
+      else                                 quoted += c;
+    }
+    return quoted + '"';
+  }
+
+  inline void reportJson( std::ostream & stream, std::vector<Result> const & results )
+  {
+    char        date[32] = {};
+    std::time_t now      = std::time( nullptr );
+    std::strftime( date, sizeof( date ), "%Y-%m-%dT%H:%M:%S", std::localtime( &now ) );
+
+    #if defined( __clang__ )
+      std::string const compiler = "clang++ " __clang_version__;
+    #elif defined( __GNUC__ )
+      std::string const compiler = "g++ " __VERSION__;
+    #else
+      std::string const compiler = "unknown";
+    #endif
+
+    stream << std::setprecision( 17 ) << "{\n"
+           << "  \"context\": {\n"
+           << "    \"date\": "       << jsonString( date     ) << ",\n"
+           << "    \"compiler\": "   << jsonString( compiler ) << ",\n"
+           #if defined( NDEBUG )
+           << "    \"build_type\": \"release\"\n"
+           #else
+           << "    \"build_type\": \"debug\"\n"
+           #endif
+           << "  },\n"
+           << "  \"benchmarks\": [";
+
+    for( std::size_t i = 0; i < results.size(); ++i )
+    {
+      auto const & result = results[i];
+      stream << ( i == 0 ? "\n" : ",\n" )
+             << "    {\n"
+             << "      \"name\": "       << jsonString( result.name ) << ",\n"
+             << "      \"iterations\": " << result.iterations         << ",\n"
+             << "      \"real_time\": "  << result.realNanoseconds    << ",\n"
+             << "      \"cpu_time\": "   << result.cpuNanoseconds     << ",\n";
+      if( result.bytesPerSecond > 0.0 ) stream << "      \"bytes_per_second\": " << result.bytesPerSecond << ",\n";
+      if( result.itemsPerSecond > 0.0 ) stream << "      \"items_per_second\": " << result.itemsPerSecond << ",\n";
+      if( !result.label.empty()       ) stream << "      \"label\": "            << jsonString( result.label ) << ",\n";
+      stream << "      \"time_unit\": \"ns\"\n"
+             << "    }";
+    }
+    stream << "\n  ]\n}\n";
+  }
+
+  inline void reportCsv( std::ostream & stream, std::vector<Result> const & results )
+  {
+    stream << std::setprecision( 17 ) << "name,iterations,real_time,cpu_time,time_unit,bytes_per_second,items_per_second,label\n";
+    for( auto const & result : results )
+    {
+      stream << '"' << result.name << "\"," << result.iterations << ',' << result.realNanoseconds << ',' << result.cpuNanoseconds << ",ns,";
+      if( result.bytesPerSecond > 0.0 ) stream << result.bytesPerSecond;
+      stream << ',';
+      if( result.itemsPerSecond > 0.0 ) stream << result.itemsPerSecond;
+      stream << ",\"" << result.label << "\"\n";
+    }
+  }
+
+
+
+  // Runs every registered benchmark matching the command line's filter, reports the results as asked, and returns main()'s exit
+  // status
+  inline int runAll( int argc, char * argv[] )
+  {
+    Runner      runner;
+    std::string format    = "console";
+    std::string outFile;
+    std::string outFormat = "json";
+
+    for( int i = 1; i < argc; ++i )
+    {
+      std::string_view const argument = argv[i];
+      auto const value = [&]( std::string_view option ) { return std::string( argument.substr( option.size() ) ); };
+
+      if     ( argument.starts_with( "--benchmark_filter="     ) )   runner.filter         = value( "--benchmark_filter="     );
+      else if( argument.starts_with( "--benchmark_min_time="   ) )   runner.minimumSeconds = std::stod( value( "--benchmark_min_time=" ) );
+      else if( argument.starts_with( "--benchmark_format="     ) )   format                = value( "--benchmark_format="     );
+      else if( argument.starts_with( "--benchmark_out="        ) )   outFile               = value( "--benchmark_out="        );
+      else if( argument.starts_with( "--benchmark_out_format=" ) )   outFormat             = value( "--benchmark_out_format=" );
+      else
+      {
+        std::cerr << "Unrecognized option \"" << argument << "\"\n";
+        return 2;
+      }
+    }
+
+    if( ( format    != "console"  &&  format    != "json"  &&  format    != "csv" )
+     || ( outFormat != "json"     &&  outFormat != "csv"                          ) )
+    {
+      std::cerr << "Formats are console, json, or csv\n";
+      return 2;
+    }
+
+
+    // Console results are shown as they come in, the others are written once everything has run
+    std::vector<Result> results;
+    if( format == "console" )   reportConsoleHeader( std::cout );
+
+    for( auto const & benchmark : registry() )
+    {
+      auto const measure = [&]( std::int64_t argument, bool hasArgument )
+      {
+        auto name = hasArgument ? benchmark.name + '/' + std::to_string( argument ) : benchmark.name;
+        if( name.find( runner.filter ) == std::string::npos ) return;
+
+        results.push_back( runner.run( benchmark, std::move( name ), argument ) );
+        if( format == "console" )   reportConsole( std::cout, results.back() );
+      };
+
+      if( benchmark.arguments.empty() )   measure( 0, false );
+      for( auto const argument : benchmark.arguments )   measure( argument, true );
+    }
+
+    if     ( format == "json" )   reportJson( std::cout, results );
+    else if( format == "csv"  )   reportCsv ( std::cout, results );
+
+    if( !outFile.empty() )
+    {
+      std::ofstream out( outFile );
+      if( outFormat == "csv" )   reportCsv ( out, results );
+      else                       reportJson( out, results );
+      if( !out )
+      {
+        std::cerr << "Unable to write \"" << outFile << "\"\n";
+        return 1;
+      }
+    }
+
+    return 0;
+  }
+}    // namespace Benchmark
@@ -0,0 +1,133 @@
+#include <algorithm>                                                                  // sort()
+#include <compare>                                                                    // weak_ordering
+#include <cstddef>                                                                    // size_t
+#include <cstdint>                                                                    // int64_t
+#include <sstream>                                                                    // istringstream, ostringstream
+#include <string>
+#include <utility>                                                                    // move()
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "GroceryItem.hpp"
+
+
+// The cost of GroceryItem's value semantics:  copies, moves, comparisons, and the stream operators.  The attributes are long enough
+// that none of them fit in a short string buffer, so copies really do allocate.
+namespace
+{
+  GroceryItem const sample( "Heinz Tomato Ketchup - 2 Ct",   "Heinz Ketchup Company", "00013000001236", 4.97 );
+  GroceryItem const twin  ( "Heinz Tomato Ketchup - 2 Ct",   "Heinz Ketchup Company", "00013000001236", 4.97 );    // equal to sample, but not the same object
+  GroceryItem const other ( "Heinz Tomato Ketchup - 2 Ct",   "Heinz Ketchup Company", "00013000001243", 4.97 );    // differs only in the UPC, compared after the name and brand
+
+
+
+  Benchmark::Register copying( "GroceryItem/copy", []( Benchmark::State & state )
+  {
+    for( auto _ : state )
+    {
+      GroceryItem copy( sample );
+      Benchmark::doNotOptimize( copy );
+    }
+  } );
+
+
+
+  // One iteration is a move construction and a move assignment back, so the source is always worth moving
+  Benchmark::Register moving( "GroceryItem/move", []( Benchmark::State & state )
+  {
+    GroceryItem source( sample );
+    for( auto _ : state )
+    {
+      GroceryItem moved( std::move( source ) );
+      source = std::move( moved );
+      Benchmark::doNotOptimize( source );
+    }
+  } );
+
+
+
+  Benchmark::Register equal( "GroceryItem/operator==", []( Benchmark::State & state )
+  {
+    for( auto _ : state )   Benchmark::doNotOptimize( sample == twin );
+  } );
+
+
+
+  Benchmark::Register notEqual( "GroceryItem/operator==/differs", []( Benchmark::State & state )
+  {
+    for( auto _ : state )   Benchmark::doNotOptimize( sample == other );
+  } );
+
+
+
+  Benchmark::Register threeWay( "GroceryItem/operator<=>", []( Benchmark::State & state )
+  {
+    for( auto _ : state )   Benchmark::doNotOptimize( sample <=> twin );
+  } );
+
+
+
+  Benchmark::Register threeWayDiffers( "GroceryItem/operator<=>/differs", []( Benchmark::State & state )
+  {
+    for( auto _ : state )   Benchmark::doNotOptimize( sample <=> other );
+  } );
+
+
+
+  // Sorting 65,536 grocery items with the same UPC code (unlabeled store items, say), so every comparison comes down to the product
+  // names.  The names are long and mostly differ early on, as real ones do.  That's too many names to all stay in cache, as in a
+  // real catalog.  Items are copied back unsorted, untimed, every time.
+  Benchmark::Register sorting( "GroceryItem/sort/by name", []( Benchmark::State & state )
+  {
+    std::vector<GroceryItem> unsorted;
+    for( std::size_t i = 0; i < 65'536; ++i )
+    {
+      auto const id = ( i * 2'654'435'761U ) % 65'536;
+      unsorted.emplace_back( std::to_string( id ) + " Store Brand Product, Family Size - 12 Ct", "Store Brand" );
+    }
+
+    auto items = unsorted;
+    for( auto _ : state )
+    {
+      std::sort( items.begin(), items.end() );
+      Benchmark::doNotOptimize( items );
+      state.pauseTiming();
+      items = unsorted;
+      state.resumeTiming();
+    }
+    state.setItemsProcessed( static_cast<std::int64_t>( state.iterations() * unsorted.size() ) );
+  } );
+
+
+
+  Benchmark::Register insertion( "GroceryItem/operator<<", []( Benchmark::State & state )
+  {
+    std::ostringstream stream;
+    for( auto _ : state )
+    {
+      stream.seekp( 0 );
+      stream << sample;
+      Benchmark::doNotOptimize( stream );
+    }
+    state.setBytesProcessed( static_cast<std::int64_t>( state.iterations() * stream.str().size() ) );
+  } );
+
+
+
+  Benchmark::Register extraction( "GroceryItem/operator>>", []( Benchmark::State & state )
+  {
+    std::ostringstream text;
+    text << sample;
+
+    std::istringstream stream( text.str() );
+    GroceryItem        gItem;
+    for( auto _ : state )
+    {
+      stream.clear();
+      stream.seekg( 0 );
+      stream >> gItem;
+      Benchmark::doNotOptimize( gItem );
+    }
+    state.setBytesProcessed( static_cast<std::int64_t>( state.iterations() * text.str().size() ) );
+  } );
+}
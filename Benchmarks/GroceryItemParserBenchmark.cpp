@@ -0,0 +1,75 @@
+#include <cstddef>                                                                    // size_t
+#include <cstdint>                                                                    // int64_t
+#include <sstream>                                                                    // istringstream, ostringstream
+#include <string>
+
+#include "Benchmark.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemParser.hpp"
+
+
+// Compares reading a supplier price feed with GroceryItem's extraction operator against GroceryItemParser.  The feed is generated
+// in memory with GroceryItem's insertion operator (so it's exactly the format both readers expect), including the odd escaped
+// quote, and each iteration reads the whole feed.
+namespace
+{
+  constexpr std::size_t RECORDS = 500'000;
+
+
+
+  std::string const & feed()                                                          // built once, on first use
+  {
+    static std::string const text = []
+    {
+      std::ostringstream stream;
+      for( std::size_t i = 0; i < RECORDS; ++i )
+      {
+        GroceryItem gItem( "Product #" + std::to_string( i ) + ( i % 7 == 0 ? " \"Family Size\"" : "" ) + " - 12 Ct",
+                           "Brand "    + std::to_string( i % 997 ),
+                           std::to_string( 10'000'000'000'000 + i ),
+                           static_cast<double>( i % 10'000 ) / 100.0 );
+        stream << gItem << '\n';
+      }
+      return stream.str();
+    }();
+    return text;
+  }
+
+
+
+  void reportThroughput( Benchmark::State & state )
+  {
+    state.setItemsProcessed( static_cast<std::int64_t>( state.iterations() * RECORDS       ) );
+    state.setBytesProcessed( static_cast<std::int64_t>( state.iterations() * feed().size() ) );
+  }
+
+
+
+  Benchmark::Register extraction( "Feed/operator>>", []( Benchmark::State & state )
+  {
+    auto const & text = feed();
+    for( auto _ : state )
+    {
+      std::istringstream stream( text );
+      double             sum = 0.0;
+      for( GroceryItem gItem;  stream >> gItem; )   sum += gItem.price();
+      Benchmark::doNotOptimize( sum );
+    }
+    reportThroughput( state );
+  } );
+
+
+
+  Benchmark::Register parsing( "Feed/GroceryItemParser", []( Benchmark::State & state )
+  {
+    auto const & text = feed();
+    for( auto _ : state )
+    {
+      GroceryItemParser parser( text );
+      double            sum = 0.0;
+      for( GroceryItem gItem;  parser.next( gItem ); )   sum += gItem.price();
+      Benchmark::doNotOptimize( sum );
+    }
+    reportThroughput( state );
+  } );
+}
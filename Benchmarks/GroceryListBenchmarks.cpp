@@ -0,0 +1,617 @@
+#include <atomic>
+#include <chrono>                                                                     // milliseconds
+#include <cstddef>                                                                    // size_t
+#include <cstdint>                                                                    // int64_t
+#include <iterator>                                                                   // make_move_iterator()
+#include <memory_resource>                                                            // memory_resource, monotonic_buffer_resource, new_delete_resource()
+#include <mutex>
+#include <sstream>                                                                    // stringstream
+#include <string>
+#include <thread>                                                                     // jthread, sleep_for()
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "ConcurrentGroceryList.hpp"
+#include "GroceryCatalog.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemQueue.hpp"
+#include "GroceryList.hpp"
+#include "HeapAllocations.hpp"
+#include "Money.hpp"
+
+
+// GroceryList's modifiers, queries, and comparisons, each run across a range of list sizes.  Modifiers are measured one operation
+// at a time with the list put back the way it was, untimed, between iterations, so every iteration sees a list of the same size.
+namespace
+{
+  std::vector<std::int64_t> const SIZES = { 8, 64, 512, 4'096 };
+
+
+
+  GroceryItem makeItem( std::size_t id )
+  {
+    return { "Product #" + std::to_string( id ) + " - 12 Ct", "Brand " + std::to_string( id % 97 ), std::to_string( 10'000'000'000'000 + id ), 1.99 };
+  }
+
+  std::vector<GroceryItem> makeItems( std::int64_t count, std::size_t firstId = 0 )
+  {
+    std::vector<GroceryItem> items;
+    for( std::size_t i = 0; i < static_cast<std::size_t>( count ); ++i )   items.push_back( makeItem( firstId + i ) );
+    return items;
+  }
+
+  template<typename List = GroceryList>
+  List makeList( std::vector<GroceryItem> const & items, bool indexed = false )
+  {
+    List groceryList;
+    groceryList.indexed( indexed );
+    groceryList.appendRange( items );
+    return groceryList;
+  }
+
+  GroceryItem const newcomer = makeItem( 1'000'000 );                                 // never part of a list being measured
+
+
+
+  // insert( item, TOP ), insert( item, BOTTOM ), and insert( item, size()/2 )
+  Benchmark::Register insertTop( "GroceryList/insert/TOP", []( Benchmark::State & state )
+  {
+    auto groceryList = makeList( makeItems( state.range() ) );
+    for( auto _ : state )
+    {
+      groceryList.insert( newcomer, GroceryList::Position::TOP );
+      state.pauseTiming();
+      groceryList.remove( std::size_t{ 0 } );
+      state.resumeTiming();
+    }
+  }, SIZES );
+
+
+
+  Benchmark::Register insertBottom( "GroceryList/insert/BOTTOM", []( Benchmark::State & state )
+  {
+    auto groceryList = makeList( makeItems( state.range() ) );
+    for( auto _ : state )
+    {
+      groceryList.insert( newcomer, GroceryList::Position::BOTTOM );
+      state.pauseTiming();
+      groceryList.remove( groceryList.size() - 1 );
+      state.resumeTiming();
+    }
+  }, SIZES );
+
+
+
+  Benchmark::Register insertMiddle( "GroceryList/insert/middle", []( Benchmark::State & state )
+  {
+    auto       groceryList = makeList( makeItems( state.range() ) );
+    auto const middle      = groceryList.size() / 2;
+    for( auto _ : state )
+    {
+      groceryList.insert( newcomer, middle );
+      state.pauseTiming();
+      groceryList.remove( middle );
+      state.resumeTiming();
+    }
+  }, SIZES );
+
+
+
+  // An edit in the middle of a long list - an insertion and a removal, both timed - for the default storage policy, which shifts
+  // the trailing grocery items, and for TreeStorage, which doesn't
+  std::vector<std::int64_t> const LONG_SIZES = { 512, 4'096, 65'536 };
+
+  template<typename List>
+  void editMiddle( Benchmark::State & state )
+  {
+    List groceryList;
+    groceryList.appendRange( makeItems( state.range() ) );
+    auto const middle = groceryList.size() / 2;
+    for( auto _ : state )
+    {
+      groceryList.insert( newcomer, middle );
+      groceryList.remove( middle );
+    }
+  }
+
+  Benchmark::Register editMiddleDefault   ( "GroceryList/edit/middle",                   editMiddle<GroceryList>,                         LONG_SIZES );
+  Benchmark::Register editMiddleTree      ( "GroceryList/edit/middle/TreeStorage",       editMiddle<BasicGroceryList<TreeStorage>>,       LONG_SIZES );
+  Benchmark::Register editMiddlePersistent( "GroceryList/edit/middle/PersistentStorage", editMiddle<BasicGroceryList<PersistentStorage>>, LONG_SIZES );
+
+
+
+  // Copy a grocery list, then change the copy - an undo step, or a copy taken to work on for one request
+  template<typename List>
+  void copyAndEdit( Benchmark::State & state )
+  {
+    List groceryList;
+    groceryList.appendRange( makeItems( state.range() ) );
+    auto const middle = groceryList.size() / 2;
+    for( auto _ : state )
+    {
+      auto copy = groceryList;
+      copy.insert( newcomer, middle );
+      Benchmark::doNotOptimize( copy );
+    }
+  }
+
+  Benchmark::Register copyAndEditDefault   ( "GroceryList/copy+edit",                   copyAndEdit<GroceryList>,                         LONG_SIZES );
+  Benchmark::Register copyAndEditPersistent( "GroceryList/copy+edit/PersistentStorage", copyAndEdit<BasicGroceryList<PersistentStorage>>, LONG_SIZES );
+
+
+
+  // A request scoped grocery list, built and torn down, with everything its storage holds - the product names too long to store
+  // inline included, and every one here is - allocated one by one from the heap or carved out of an arena released all at once.
+  // The label counts every heap allocation per grocery list, and how many of them went through the storage's memory resource.  With
+  // an arena that's only the arena's own blocks, plus the few temporaries appendRange() builds, however long the grocery list.
+  class CountingResource : public std::pmr::memory_resource
+  {
+    public:
+      std::size_t allocations = 0;
+
+    private:
+      void * do_allocate  ( std::size_t bytes, std::size_t alignment ) override
+      {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate( bytes, alignment );
+      }
+
+      void do_deallocate( void * pointer, std::size_t bytes, std::size_t alignment ) override
+      {
+        std::pmr::new_delete_resource()->deallocate( pointer, bytes, alignment );
+      }
+
+      bool do_is_equal( std::pmr::memory_resource const & other ) const noexcept override   { return this == &other; }
+  };
+
+  template<typename List>
+  void requestScoped( Benchmark::State & state, bool arena )
+  {
+    auto const       items  = makeItems( state.range() );
+    auto const       before = Benchmark::heapAllocations();
+    CountingResource heap;
+    for( auto _ : state )
+    {
+      std::pmr::monotonic_buffer_resource pool( &heap );
+      List groceryList( arena ? static_cast<std::pmr::memory_resource *>( &pool ) : &heap );
+      groceryList.appendRange( items );
+      Benchmark::doNotOptimize( groceryList );
+    }
+    auto const total = Benchmark::heapAllocations() - before;
+    state.setLabel( std::to_string( total / state.iterations() ) + " heap allocations ("
+                  + std::to_string( heap.allocations / state.iterations() ) + " through the resource)" );
+  }
+
+  Benchmark::Register requestDefault  ( "GroceryList/request",                   []( Benchmark::State & state ) { requestScoped<GroceryList                  >( state, false ); }, LONG_SIZES );
+  Benchmark::Register requestArena    ( "GroceryList/request/arena",             []( Benchmark::State & state ) { requestScoped<GroceryList                  >( state, true  ); }, LONG_SIZES );
+  Benchmark::Register requestList     ( "GroceryList/request/ListStorage",       []( Benchmark::State & state ) { requestScoped<BasicGroceryList<ListStorage>>( state, false ); }, LONG_SIZES );
+  Benchmark::Register requestListArena( "GroceryList/request/ListStorage/arena", []( Benchmark::State & state ) { requestScoped<BasicGroceryList<ListStorage>>( state, true  ); }, LONG_SIZES );
+  Benchmark::Register requestTree     ( "GroceryList/request/TreeStorage",       []( Benchmark::State & state ) { requestScoped<BasicGroceryList<TreeStorage>>( state, false ); }, LONG_SIZES );
+  Benchmark::Register requestTreeArena( "GroceryList/request/TreeStorage/arena", []( Benchmark::State & state ) { requestScoped<BasicGroceryList<TreeStorage>>( state, true  ); }, LONG_SIZES );
+
+
+
+  // Scans over every grocery item's price, a grocery item at a time from a grocery list and a column at a time from a catalog of
+  // the same grocery items (see GroceryCatalog).  The catalog reads 8 bytes per grocery item, the grocery list the whole item.
+  std::vector<std::int64_t> const SCAN_SIZES = { 65'536, 1'048'576 };
+
+  Money const low  = Money::fromDollars( 1.00 );
+  Money const high = Money::fromDollars( 2.50 );
+
+  Benchmark::Register totalList( "GroceryList/scan/total", []( Benchmark::State & state )
+  {
+    auto const groceryList = makeList( makeItems( state.range() ) );
+    for( auto _ : state )   Benchmark::doNotOptimize( groceryList.total() );
+  }, SCAN_SIZES );
+
+  Benchmark::Register totalCatalog( "GroceryCatalog/scan/total", []( Benchmark::State & state )
+  {
+    GroceryCatalog const catalog( makeList( makeItems( state.range() ) ) );
+    for( auto _ : state )   Benchmark::doNotOptimize( catalog.total() );
+  }, SCAN_SIZES );
+
+  Benchmark::Register priceRangeList( "GroceryList/scan/priceRange", []( Benchmark::State & state )
+  {
+    auto const groceryList = makeList( makeItems( state.range() ) );
+    for( auto _ : state )   Benchmark::doNotOptimize( groceryList.priceRange( low, high ) );
+  }, SCAN_SIZES );
+
+  Benchmark::Register priceRangeCatalog( "GroceryCatalog/scan/priceRange", []( Benchmark::State & state )
+  {
+    GroceryCatalog const catalog( makeList( makeItems( state.range() ) ) );
+    for( auto _ : state )   Benchmark::doNotOptimize( catalog.priceRange( low, high ) );
+  }, SCAN_SIZES );
+
+
+
+  // Bring a replica up to date after a handful of changes - a removal, a move, and an insertion - by sending the whole list as text,
+  // or by sending a patch as text.  Both sides are timed:  writing and reading the text, and diffing and applying the patch.  The
+  // replica is put back untimed.
+  template<typename List = GroceryList>
+  struct SyncLists
+  {
+    List before, after;
+
+    explicit SyncLists( std::int64_t count ) : before( makeList<List>( makeItems( count ) ) ), after( before )
+    {
+      after.remove   ( after.size() / 3 );
+      after.moveToTop( makeItem( static_cast<std::size_t>( count ) / 2 ) );
+      after.insert   ( newcomer, after.size() * 2 / 3 );
+    }
+  };
+
+  Benchmark::Register syncResend( "GroceryList/sync/resend", []( Benchmark::State & state )
+  {
+    SyncLists<> const lists( state.range() );
+    for( auto _ : state )
+    {
+      std::stringstream text;
+      text << lists.after;
+
+      GroceryList replica;
+      text >> replica;
+      Benchmark::doNotOptimize( replica );
+    }
+  }, LONG_SIZES );
+
+  Benchmark::Register syncPatch( "GroceryList/sync/patch", []( Benchmark::State & state )
+  {
+    SyncLists<> const lists( state.range() );
+    auto              replica = lists.before;
+    for( auto _ : state )
+    {
+      std::stringstream text;
+      text << GroceryList::diff( lists.before, lists.after );
+
+      GroceryListPatch patch;
+      text >> patch;
+      replica.apply( patch );
+      Benchmark::doNotOptimize( replica );
+
+      state.pauseTiming();
+      replica = lists.before;
+      state.resumeTiming();
+    }
+  }, LONG_SIZES );
+
+  // The receiving side alone, for a replica kept in sync patch after patch:  the changes, then back again, so each patch's base is
+  // the hash the one before left, and the replica never needs putting back.  Checking the patch takes time with the change, not the
+  // list, and TreeStorage makes the edits themselves in logarithmic time too, where the default storage policy shifts the grocery
+  // items (and the hash index its offsets) below each one.
+  template<typename List>
+  void syncApply( Benchmark::State & state )
+  {
+    SyncLists<List> const  lists( state.range() );
+    GroceryListPatch const patches[] = { List::diff( lists.before, lists.after ), List::diff( lists.after, lists.before ) };
+    auto                   replica   = lists.before;
+    std::size_t            next      = 0;
+    replica.indexed( true );
+    for( auto _ : state )
+    {
+      replica.apply( patches[next] );
+      next ^= 1;
+    }
+  }
+
+  Benchmark::Register syncApplyDefault( "GroceryList/sync/apply/indexed",     syncApply<GroceryList>,                   LONG_SIZES );
+  Benchmark::Register syncApplyTree   ( "GroceryList/sync/apply/TreeStorage", syncApply<BasicGroceryList<TreeStorage>>, LONG_SIZES );
+
+
+
+  // find() with and without the hash index, cycling through every grocery item on the list so a hit lands anywhere, and for one
+  // that isn't on the list.  PersistentStorage turns away a miss on its own, but needs the hash index for a hit
+  template<typename List = GroceryList>
+  void findHit( Benchmark::State & state, bool indexed )
+  {
+    auto const  items       = makeItems( state.range() );
+    auto const  groceryList = makeList<List>( items, indexed );
+    std::size_t next        = 0;
+    for( auto _ : state )
+    {
+      Benchmark::doNotOptimize( groceryList.find( items[next] ) );
+      if( ++next == items.size() ) next = 0;
+    }
+  }
+
+  template<typename List = GroceryList>
+  void findMiss( Benchmark::State & state, bool indexed )
+  {
+    auto const groceryList = makeList<List>( makeItems( state.range() ), indexed );
+    for( auto _ : state )   Benchmark::doNotOptimize( groceryList.find( newcomer ) );
+  }
+
+  Benchmark::Register findHitLinear  ( "GroceryList/find/hit",          []( Benchmark::State & state ) { findHit ( state, false ); }, SIZES );
+  Benchmark::Register findMissLinear ( "GroceryList/find/miss",         []( Benchmark::State & state ) { findMiss( state, false ); }, SIZES );
+  Benchmark::Register findHitIndexed ( "GroceryList/find/hit/indexed",  []( Benchmark::State & state ) { findHit ( state, true  ); }, SIZES );
+  Benchmark::Register findMissIndexed( "GroceryList/find/miss/indexed", []( Benchmark::State & state ) { findMiss( state, true  ); }, SIZES );
+
+  using PersistentList = BasicGroceryList<PersistentStorage>;
+  Benchmark::Register findHitPersistent        ( "GroceryList/find/hit/PersistentStorage",          []( Benchmark::State & state ) { findHit <PersistentList>( state, false ); }, SIZES );
+  Benchmark::Register findMissPersistent       ( "GroceryList/find/miss/PersistentStorage",         []( Benchmark::State & state ) { findMiss<PersistentList>( state, false ); }, SIZES );
+  Benchmark::Register findHitPersistentIndexed ( "GroceryList/find/hit/PersistentStorage/indexed",  []( Benchmark::State & state ) { findHit <PersistentList>( state, true  ); }, SIZES );
+  Benchmark::Register findMissPersistentIndexed( "GroceryList/find/miss/PersistentStorage/indexed", []( Benchmark::State & state ) { findMiss<PersistentList>( state, true  ); }, SIZES );
+
+
+
+  // priceRange() for a one dollar band out of prices spread from $0.00 to $99.99, with and without the sorted indexes
+  void priceRange( Benchmark::State & state, bool ordered )
+  {
+    auto items = makeItems( state.range() );
+    for( std::size_t i = 0; i < items.size(); ++i )   items[i].price( static_cast<double>( i * 7'919 % 10'000 ) / 100 );
+
+    auto groceryList = makeList( items );
+    groceryList.ordered( ordered );
+    for( auto _ : state )   Benchmark::doNotOptimize( groceryList.priceRange( Money::fromDollars( 42.00 ), Money::fromDollars( 42.99 ) ) );
+  }
+
+  Benchmark::Register priceRangeSorting( "GroceryList/priceRange",         []( Benchmark::State & state ) { priceRange( state, false ); }, LONG_SIZES );
+  Benchmark::Register priceRangeOrdered( "GroceryList/priceRange/ordered", []( Benchmark::State & state ) { priceRange( state, true  ); }, LONG_SIZES );
+
+
+
+  // Typeahead:  startingWith() a prefix matching about one product name in sixty, and containing() text matching about one in a
+  // thousand, with and without the search index
+  void search( Benchmark::State & state, bool searchable, bool prefix )
+  {
+    auto groceryList = makeList( makeItems( state.range() ) );
+    groceryList.searchable( searchable );
+    for( auto _ : state )
+    {
+      if( prefix ) Benchmark::doNotOptimize( groceryList.startingWith( "product #42" ) );
+      else         Benchmark::doNotOptimize( groceryList.containing  ( "242 - 12"    ) );
+    }
+  }
+
+  Benchmark::Register searchPrefix          ( "GroceryList/startingWith",            []( Benchmark::State & state ) { search( state, false, true  ); }, LONG_SIZES );
+  Benchmark::Register searchPrefixIndexed   ( "GroceryList/startingWith/searchable", []( Benchmark::State & state ) { search( state, true,  true  ); }, LONG_SIZES );
+  Benchmark::Register searchSubstring       ( "GroceryList/containing",              []( Benchmark::State & state ) { search( state, false, false ); }, LONG_SIZES );
+  Benchmark::Register searchSubstringIndexed( "GroceryList/containing/searchable",   []( Benchmark::State & state ) { search( state, true,  false ); }, LONG_SIZES );
+
+
+
+  // remove( item ) finds, then removes, the grocery item from the middle of the list
+  Benchmark::Register removeMiddle( "GroceryList/remove", []( Benchmark::State & state )
+  {
+    auto const items       = makeItems( state.range() );
+    auto       groceryList = makeList( items );
+    auto const middle      = items.size() / 2;
+    for( auto _ : state )
+    {
+      groceryList.remove( items[middle] );
+      state.pauseTiming();
+      groceryList.insert( items[middle], middle );
+      state.resumeTiming();
+    }
+  }, SIZES );
+
+
+
+  // moveToTop() the grocery item at the bottom, the worst case for a linear search.  Each move rotates the list by one, so the
+  // list never needs restoring.  ListStorage and TreeStorage splice the grocery item to the top in place.  PersistentStorage
+  // removes and reinserts it, finding it with or without the hash index.
+  template<typename List, bool indexed = false>
+  void moveToTop( Benchmark::State & state )
+  {
+    auto const  items       = makeItems( state.range() );
+    auto        groceryList = makeList<List>( items, indexed );
+    std::size_t bottom      = items.size() - 1;
+    for( auto _ : state )
+    {
+      groceryList.moveToTop( items[bottom] );
+      bottom = ( bottom == 0 ? items.size() : bottom ) - 1;
+    }
+  }
+
+  Benchmark::Register moveToTopDefault( "GroceryList/moveToTop",             moveToTop<GroceryList>,                   SIZES );
+  Benchmark::Register moveToTopList   ( "GroceryList/moveToTop/ListStorage", moveToTop<BasicGroceryList<ListStorage>>, SIZES );
+  Benchmark::Register moveToTopTree   ( "GroceryList/moveToTop/TreeStorage", moveToTop<BasicGroceryList<TreeStorage>>, SIZES );
+
+  Benchmark::Register moveToTopPersistent       ( "GroceryList/moveToTop/PersistentStorage",         moveToTop<PersistentList>,       SIZES );
+  Benchmark::Register moveToTopPersistentIndexed( "GroceryList/moveToTop/PersistentStorage/indexed", moveToTop<PersistentList, true>, SIZES );
+
+
+
+  // operator+=( {...} ) appends four new grocery items, operator+=( list ) appends a list as long as the one appended to
+  Benchmark::Register appendBracedList( "GroceryList/operator+=/initializer_list", []( Benchmark::State & state )
+  {
+    auto        groceryList = makeList( makeItems( state.range() ) );
+    auto const  extras      = makeItems( 4, 1'000'000 );
+    std::size_t appended    = 0;
+    for( auto _ : state )
+    {
+      groceryList += { extras[0], extras[1], extras[2], extras[3] };
+      state.pauseTiming();
+      for( std::size_t i = 0; i < extras.size(); ++i ) groceryList.remove( groceryList.size() - 1 );
+      appended += extras.size();
+      state.resumeTiming();
+    }
+    state.setItemsProcessed( static_cast<std::int64_t>( appended ) );
+  }, SIZES );
+
+
+
+  Benchmark::Register appendList( "GroceryList/operator+=/GroceryList", []( Benchmark::State & state )
+  {
+    auto const original    = makeList( makeItems( state.range() ) );
+    auto const rhs         = makeList( makeItems( state.range(), 1'000'000 ) );
+    auto       groceryList = original;
+    for( auto _ : state )
+    {
+      groceryList += rhs;
+      state.pauseTiming();
+      groceryList = original;
+      state.resumeTiming();
+    }
+    state.setItemsProcessed( static_cast<std::int64_t>( state.iterations() * rhs.size() ) );
+  }, SIZES );
+
+
+
+  // Comparing equal lists, the worst case since every grocery item must be compared
+  Benchmark::Register equal( "GroceryList/operator==", []( Benchmark::State & state )
+  {
+    auto const lhs = makeList( makeItems( state.range() ) );
+    auto const rhs = lhs;
+    for( auto _ : state )   Benchmark::doNotOptimize( lhs == rhs );
+  }, SIZES );
+
+
+
+  // Comparing lists of the same size that differ only in their bottom grocery item.  The content hashes differ, so the grocery
+  // items needn't be compared at all.
+  Benchmark::Register notEqual( "GroceryList/operator==/differs", []( Benchmark::State & state )
+  {
+    auto const lhs = makeList( makeItems( state.range() ) );
+    auto       rhs = lhs;
+    rhs.remove( rhs.size() - 1 );
+    rhs.insert( newcomer, GroceryList::Position::BOTTOM );
+    for( auto _ : state )   Benchmark::doNotOptimize( lhs == rhs );
+  }, SIZES );
+
+
+
+  Benchmark::Register threeWay( "GroceryList/operator<=>", []( Benchmark::State & state )
+  {
+    auto const lhs = makeList( makeItems( state.range() ) );
+    auto const rhs = lhs;
+    for( auto _ : state )   Benchmark::doNotOptimize( lhs <=> rhs );
+  }, SIZES );
+
+
+
+  // unionOf() a thousand household lists of a thousand grocery items each, drawn from a catalog of 200,000, by 1 to 8 threads
+  Benchmark::Register unionOf( "GroceryList/unionOf/threads", []( Benchmark::State & state )
+  {
+    static std::vector<GroceryList> const households = []
+    {
+      std::vector<GroceryList> lists( 1'000 );
+      std::size_t              next = 0;
+      for( auto & list : lists )
+      {
+        std::vector<GroceryItem> items;
+        for( std::size_t i = 0; i < 1'000; ++i )   items.push_back( makeItem( ( next += 7'919 ) % 200'000 ) );
+        list.appendRange( items );
+      }
+      return lists;
+    }();
+
+    for( auto _ : state )   Benchmark::doNotOptimize( GroceryList::unionOf( households, static_cast<unsigned>( state.range() ) ) );
+    state.setItemsProcessed( static_cast<std::int64_t>( state.iterations() ) * 1'000'000 );
+  }, { 1, 2, 4, 8 } );
+
+
+
+  // find() on a shared, indexed grocery list of 1,000 grocery items by 1 to 64 reader threads, while a writer thread moves a grocery
+  // item to the top every millisecond.  Each iteration is 2^20 finds, split evenly among the readers.  First with a GroceryList
+  // behind one mutex, as callers had to share one before, then with a ConcurrentGroceryList.
+  template<typename Reader, typename Writer>
+  void readWhileWriting( Benchmark::State & state, Reader const & reader, Writer const & writer )
+  {
+    constexpr std::size_t FINDS   = 1 << 20;
+    auto const            threads = static_cast<std::size_t>( state.range() );
+
+    for( auto _ : state )
+    {
+      std::atomic<bool> done = false;
+      std::jthread      background( [&] { for( std::size_t i = 0; !done; ++i ) { writer( i );  std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) ); } } );
+      {
+        std::vector<std::jthread> readers;
+        for( std::size_t t = 0; t < threads; ++t )   readers.emplace_back( [&, t] { for( auto i = t; i < FINDS; i += threads )   reader( i ); } );
+      }
+      done = true;
+    }
+    state.setItemsProcessed( static_cast<std::int64_t>( state.iterations() * FINDS ) );
+  }
+
+  std::vector<GroceryItem> const sharedItems = makeItems( 1'000 );
+
+
+
+  Benchmark::Register findShared( "GroceryList/find/mutex/threads", []( Benchmark::State & state )
+  {
+    auto       groceryList = makeList( sharedItems, true );
+    std::mutex lock;
+
+    readWhileWriting( state,
+                      [&]( std::size_t i ) { std::lock_guard guard( lock );  Benchmark::doNotOptimize( groceryList.find( sharedItems[i % sharedItems.size()] ) ); },
+                      [&]( std::size_t i ) { std::lock_guard guard( lock );  groceryList.moveToTop( sharedItems[i % sharedItems.size()] ); } );
+  }, { 1, 2, 4, 8, 16, 32, 64 } );
+
+
+
+  Benchmark::Register findConcurrent( "ConcurrentGroceryList/find/threads", []( Benchmark::State & state )
+  {
+    ConcurrentGroceryList groceryList( makeList( sharedItems, true ) );
+
+    readWhileWriting( state,
+                      [&]( std::size_t i ) { Benchmark::doNotOptimize( groceryList.find( sharedItems[i % sharedItems.size()] ) ); },
+                      [&]( std::size_t i ) { groceryList.moveToTop( sharedItems[i % sharedItems.size()] ); } );
+  }, { 1, 2, 4, 8, 16, 32, 64 } );
+
+
+
+  // 1 to 64 producer threads adding 16,384 distinct grocery items, split evenly among them, to the bottom of one grocery list.  Both
+  // hand grocery items to one consumer thread that inserts them in batches, so only the hand over differs:  first each producer
+  // takes a mutex and appends to a shared vector the consumer swaps out, then producers push into a GroceryItemQueue without one.
+  std::vector<GroceryItem> const arrivals = makeItems( 16'384 );
+
+  template<typename Producer>
+  void produce( std::size_t threads, Producer const & producer )
+  {
+    std::vector<std::jthread> producers;
+    for( std::size_t t = 0; t < threads; ++t )   producers.emplace_back( [&, t] { for( auto i = t; i < arrivals.size(); i += threads )   producer( arrivals[i] ); } );
+  }
+
+
+
+  Benchmark::Register insertShared( "GroceryList/insert/mutex/producers", []( Benchmark::State & state )
+  {
+    for( auto _ : state )
+    {
+      GroceryList              groceryList;
+      std::vector<GroceryItem> pending;
+      std::mutex               lock;
+      std::atomic<bool>        done = false;
+
+      auto const drain = [&]
+      {
+        std::vector<GroceryItem> batch;
+        {
+          std::lock_guard guard( lock );
+          batch.swap( pending );
+        }
+        groceryList.insert( std::make_move_iterator( batch.begin() ), std::make_move_iterator( batch.end() ), groceryList.size() );
+      };
+      std::jthread consumer( [&] { while( !done ) drain();  drain(); } );
+
+      produce( static_cast<std::size_t>( state.range() ), [&]( GroceryItem const & groceryItem )
+      {
+        std::lock_guard guard( lock );
+        pending.push_back( groceryItem );
+      } );
+      done = true;
+      consumer.join();
+      Benchmark::doNotOptimize( groceryList );
+    }
+    state.setItemsProcessed( static_cast<std::int64_t>( state.iterations() * arrivals.size() ) );
+  }, { 1, 2, 4, 8, 16, 32, 64 } );
+
+
+
+  Benchmark::Register pushQueue( "GroceryItemQueue/push/producers", []( Benchmark::State & state )
+  {
+    for( auto _ : state )
+    {
+      GroceryList       groceryList;
+      GroceryItemQueue  queue;
+      std::atomic<bool> done = false;
+      std::jthread      consumer( [&] { while( !done ) queue.drainInto( groceryList );  queue.drainInto( groceryList ); } );
+
+      produce( static_cast<std::size_t>( state.range() ), [&]( GroceryItem const & groceryItem ) { queue.push( groceryItem ); } );
+      done = true;
+      consumer.join();
+      Benchmark::doNotOptimize( groceryList );
+    }
+    state.setItemsProcessed( static_cast<std::int64_t>( state.iterations() * arrivals.size() ) );
+  }, { 1, 2, 4, 8, 16, 32, 64 } );
+}
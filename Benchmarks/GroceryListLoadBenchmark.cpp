@@ -0,0 +1,164 @@
+#include <cstddef>                                                                    // size_t
+#include <cstdint>                                                                    // int64_t
+#include <filesystem>                                                                 // temp_directory_path(), file_size(), remove()
+#include <fstream>                                                                    // ifstream, ofstream
+#include <string>
+
+#include <fcntl.h>                                                                    // open()
+#include <unistd.h>                                                                   // close()
+
+#include "Benchmark.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryList.hpp"
+#include "GroceryListWriter.hpp"
+
+
+// Compares filling a grocery list from a file with GroceryList's extraction operator against GroceryList::loadFile(), and against
+// GroceryList::loadImage() reading the same grocery items in the binary image format.  The text file is generated with GroceryItem's
+// insertion operator, about one record in ten a duplicate of an earlier one, and each iteration loads the whole file.  Saving is
+// compared the same way, text against image.
+namespace
+{
+  constexpr std::size_t RECORDS = 1'000'000;
+
+
+
+  // The feed's file is written on first use and removed when the program ends
+  struct Feed
+  {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "GroceryListLoadBenchmark.txt";
+
+    Feed()
+    {
+      std::ofstream file( path );
+      for( std::size_t i = 0; i < RECORDS; ++i )
+      {
+        auto const id = i % 10 == 9 ? i / 2 : i;                                      // every 10th record repeats an earlier one
+        GroceryItem gItem( "Product #" + std::to_string( id ) + " - 12 Ct",
+                           "Brand "    + std::to_string( id % 997 ),
+                           std::to_string( 10'000'000'000'000 + id ),
+                           static_cast<double>( id % 10'000 ) / 100.0 );
+        file << gItem << '\n';
+      }
+    }
+
+    Feed            ( Feed const & ) = delete;
+    Feed & operator=( Feed const & ) = delete;
+   ~Feed            (              ) { std::error_code ignored;  std::filesystem::remove( path, ignored ); }
+  };
+
+  std::filesystem::path const & feed()
+  {
+    static Feed const file;
+    return file.path;
+  }
+
+
+
+  // The same grocery items, less the duplicates, as an image
+  struct Image
+  {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "GroceryListLoadBenchmark.glst";
+
+    Image()   { GroceryList::loadFile( feed() ).saveImage( path ); }
+
+    Image            ( Image const & ) = delete;
+    Image & operator=( Image const & ) = delete;
+   ~Image            (               ) { std::error_code ignored;  std::filesystem::remove( path, ignored ); }
+  };
+
+  std::filesystem::path const & image()
+  {
+    static Image const file;
+    return file.path;
+  }
+
+
+
+  void reportThroughput( Benchmark::State & state )
+  {
+    state.setItemsProcessed( static_cast<std::int64_t>( state.iterations() * RECORDS                                ) );
+    state.setBytesProcessed( static_cast<std::int64_t>( state.iterations() * std::filesystem::file_size( feed() ) ) );
+  }
+
+
+
+  Benchmark::Register extraction( "Load/operator>>", []( Benchmark::State & state )
+  {
+    auto const & path = feed();
+    for( auto _ : state )
+    {
+      GroceryList   groceryList;
+      std::ifstream file( path );
+      file >> groceryList;
+      Benchmark::doNotOptimize( groceryList );
+    }
+    reportThroughput( state );
+  } );
+
+
+
+  Benchmark::Register loadFile( "Load/GroceryList::loadFile", []( Benchmark::State & state )
+  {
+    auto const & path = feed();
+    for( auto _ : state )
+    {
+      auto groceryList = GroceryList::loadFile( path );
+      Benchmark::doNotOptimize( groceryList );
+    }
+    reportThroughput( state );
+  } );
+
+
+
+  Benchmark::Register loadImage( "Load/GroceryList::loadImage", []( Benchmark::State & state )
+  {
+    auto const & path = image();
+    for( auto _ : state )
+    {
+      auto groceryList = GroceryList::loadImage( path );
+      Benchmark::doNotOptimize( groceryList );
+    }
+    state.setItemsProcessed( static_cast<std::int64_t>( state.iterations() * RECORDS                                 ) );
+    state.setBytesProcessed( static_cast<std::int64_t>( state.iterations() * std::filesystem::file_size( image() ) ) );
+  } );
+
+
+
+  Benchmark::Register saveText( "Save/operator<<", []( Benchmark::State & state )
+  {
+    auto const groceryList = GroceryList::loadFile( feed() );
+    auto const path        = std::filesystem::temp_directory_path() / "GroceryListSaveBenchmark.txt";
+    for( auto _ : state )
+    {
+      std::ofstream file( path );
+      file << groceryList;
+    }
+    std::filesystem::remove( path );
+  } );
+
+
+
+  Benchmark::Register saveImage( "Save/GroceryList::saveImage", []( Benchmark::State & state )
+  {
+    auto const groceryList = GroceryList::loadFile( feed() );
+    auto const path        = std::filesystem::temp_directory_path() / "GroceryListSaveBenchmark.glst";
+    for( auto _ : state )   groceryList.saveImage( path );
+    std::filesystem::remove( path );
+  } );
+
+
+
+  Benchmark::Register saveWriter( "Save/GroceryListWriter", []( Benchmark::State & state )
+  {
+    auto const groceryList = GroceryList::loadFile( feed() );
+    auto const path        = std::filesystem::temp_directory_path() / "GroceryListSaveBenchmark.txt";
+    for( auto _ : state )
+    {
+      auto const fileDescriptor = ::open( path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+      GroceryListWriter( fileDescriptor ).write( groceryList ).flush();
+      ::close( fileDescriptor );
+    }
+    std::filesystem::remove( path );
+  } );
+}
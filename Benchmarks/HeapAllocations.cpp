@@ -0,0 +1,38 @@
+#include <cstddef>                                                                    // size_t
+#include <cstdlib>                                                                    // malloc(), aligned_alloc(), free()
+#include <new>                                                                        // align_val_t, bad_alloc
+
+#include "HeapAllocations.hpp"
+
+
+// The replacements are defined in a translation unit of their own, so the compiler never sees a call to free() inlined against
+// the pointer a new-expression returned.  The array and nothrow forms of operator new call these, so they're counted too.
+namespace
+{
+  thread_local std::size_t allocations = 0;
+}
+
+std::size_t Benchmark::heapAllocations() noexcept
+{
+  return allocations;
+}
+
+void * operator new( std::size_t bytes )
+{
+  ++allocations;
+  if( auto pointer = std::malloc( bytes == 0 ? 1 : bytes ) )   return pointer;
+  throw std::bad_alloc();
+}
+
+void * operator new( std::size_t bytes, std::align_val_t alignment )
+{
+  ++allocations;
+  auto const align = static_cast<std::size_t>( alignment );
+  if( auto pointer = std::aligned_alloc( align, ( bytes + align ) / align * align ) )   return pointer;   // a whole number of alignments, never 0
+  throw std::bad_alloc();
+}
+
+void operator delete( void * pointer                                ) noexcept   { std::free( pointer ); }
+void operator delete( void * pointer, std::size_t                   ) noexcept   { std::free( pointer ); }
+void operator delete( void * pointer,              std::align_val_t ) noexcept   { std::free( pointer ); }
+void operator delete( void * pointer, std::size_t, std::align_val_t ) noexcept   { std::free( pointer ); }
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>        // size_t
+
+
+// The benchmarks replace the global operator new and operator delete (see HeapAllocations.cpp) to count every allocation from the
+// global heap, so a benchmark can report the allocations a memory resource of its own never sees:
+//
+//    auto const before = Benchmark::heapAllocations();
+//    for( auto _ : state )   { ... }
+//    auto const perIteration = ( Benchmark::heapAllocations() - before ) / state.iterations();
+//
+// The count is kept per thread, so threads allocating at once don't contend for it, and counts only the calling thread's
+// allocations.
+namespace Benchmark
+{
+  std::size_t heapAllocations() noexcept;                                       // the calling thread's allocations from the global heap so far
+}
@@ -0,0 +1,8 @@
+#include "Benchmark.hpp"
+
+
+// Benchmarks register themselves as their translation units are initialized, see Benchmark.hpp for the command line options
+int main( int argc, char * argv[] )
+{
+  return Benchmark::runAll( argc, argv );
+}
@@ -339,7 +339,18 @@ fi
 # temporarily ignore spaces when globing words into file names
 temp=$IFS
   IFS=$'\n'
-  sourceFiles=( $(find -L ./ -path ./.\* -prune -o -name "*.cpp" -print) )              # create array of source files skipping hidden folders (folders that start with a dot)
+  sourceFiles=( $(find -L ./ -path ./.\* -prune -o -path ./Benchmarks -prune -o -name "*.cpp" -print) )   # create array of source files skipping hidden folders (folders that start with a dot)
+                                                                                                         # and benchmarks (they have their own main(), see below)
+
+  # The benchmarks are opt-in, for example:  BUILD_BENCHMARKS=yes ./Build_vsc.sh
+  # They're linked with the project's source files less main.cpp and the regression tests (which run before main() and would skew
+  # the timings) into "benchmarks_clang++" and "benchmarks_g++".  Run with --benchmark_format=json (or csv) for machine readable
+  # results, see Benchmarks/Benchmark.hpp for all the options.
+  benchmarkFiles=()
+  if [[ "${BUILD_BENCHMARKS,,}" = "yes"  ||  "${BUILD_BENCHMARKS,,}" = "y" ]]; then
+    benchmarkFiles=( $(find -L ./Benchmarks -name "*.cpp" -print)
+                     $(find -L ./ -path ./.\* -prune -o -path ./Benchmarks -prune -o -path ./RegressionTests -prune -o -name "*.cpp" ! -name main.cpp -print) )
+  fi
 IFS=$temp
 
 echo "Compiling in \"$PWD\" ..."
@@ -394,7 +405,11 @@ ClangOptions=" -stdlib=libc++ -Weverything          \
                -Wno-ctad-maybe-unsupported          "
 
 
-CommonOptions="-g0 -O3 -DNDEBUG -pthread -std=c++20 -I./ -DUSING_TOMS_SUGGESTIONS -D__func__=__PRETTY_FUNCTION__"
+# GroceryList internal consistency checks (FULL, SAMPLED, SIZES, or NONE).  Release builds ship with NONE, override from the
+# environment when chasing a bug, for example:  GROCERY_LIST_CHECKS=FULL ./Build_vsc.sh
+ConsistencyChecks="${GROCERY_LIST_CHECKS:-NONE}"
+
+CommonOptions="-g0 -O3 -DNDEBUG -pthread -std=c++20 -I./ -DUSING_TOMS_SUGGESTIONS -D__func__=__PRETTY_FUNCTION__ -DGROCERY_LIST_CHECKS=${ConsistencyChecks}"
 
 
 
@@ -408,6 +423,14 @@ else
   exit 1
 fi
 
+if [[ ${#benchmarkFiles[@]} -gt 0 ]]; then
+  if $ClangCommand -include "${complianceHelperFile_path}" -o "benchmarks_clang++"  "${benchmarkFiles[@]}"; then
+    echo -e "Successfully created  \"benchmarks_clang++\""
+  else
+    exit 1
+  fi
+fi
+
 echo ""
 
 GccCommand="g++ $CommonOptions $GccOptions ${CCOptions}"
@@ -419,3 +442,11 @@ if $GccCommand -include "${complianceHelperFile_path}" -o "${executableFileName}
 else
    exit 1
 fi
+
+if [[ ${#benchmarkFiles[@]} -gt 0 ]]; then
+  if $GccCommand -include "${complianceHelperFile_path}" -o "benchmarks_g++"  "${benchmarkFiles[@]}"; then
+    echo -e "Successfully created  \"benchmarks_g++\""
+  else
+    exit 1
+  fi
+fi
@@ -0,0 +1,245 @@
+#include <algorithm>                                                                // move()
+#include <atomic>
+#include <cstddef>                                                                  // size_t
+#include <iostream>
+#include <iterator>                                                                 // back_inserter()
+#include <memory>                                                                   // make_shared()
+#include <utility>                                                                  // move()
+#include <vector>
+
+#include "ConcurrentGroceryList.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryList.hpp"
+#include "GroceryListStorage.hpp"
+
+
+
+
+/*******************************************************************************
+**  Constructors, assignments, and destructor
+*******************************************************************************/
+
+// Default constructor
+template<typename StoragePolicy>
+BasicConcurrentGroceryList<StoragePolicy>::BasicConcurrentGroceryList()
+  : BasicConcurrentGroceryList( List{} )
+{}
+
+
+
+// Constructor - initial content
+template<typename StoragePolicy>
+BasicConcurrentGroceryList<StoragePolicy>::BasicConcurrentGroceryList( List initial )
+  : _current( std::make_shared<List const>( std::move( initial ) ) )
+{
+  _reading.store( _current.load().get() );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// snapshot() const
+template<typename StoragePolicy>
+typename BasicConcurrentGroceryList<StoragePolicy>::Snapshot BasicConcurrentGroceryList<StoragePolicy>::snapshot() const
+{
+  return _current.load( std::memory_order_acquire );
+}
+
+
+
+// size() const
+template<typename StoragePolicy>
+std::size_t BasicConcurrentGroceryList<StoragePolicy>::size() const
+{
+  return read( []( List const & groceryList ) { return groceryList.size(); } );
+}
+
+
+
+// find() const
+template<typename StoragePolicy>
+std::size_t BasicConcurrentGroceryList<StoragePolicy>::find( GroceryItem const & groceryItem ) const
+{
+  return read( [&]( List const & groceryList ) { return groceryList.find( groceryItem ); } );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// insert( position )
+template<typename StoragePolicy>
+void BasicConcurrentGroceryList<StoragePolicy>::insert( GroceryItem const & groceryItem, Position position )
+{
+  update( [&]( List & groceryList ) { groceryList.insert( groceryItem, position ); } );
+}
+
+
+
+// insert( offset )
+template<typename StoragePolicy>
+void BasicConcurrentGroceryList<StoragePolicy>::insert( GroceryItem const & groceryItem, std::size_t offsetFromTop )
+{
+  update( [&]( List & groceryList ) { groceryList.insert( groceryItem, offsetFromTop ); } );
+}
+
+
+
+// remove( groceryItem )
+template<typename StoragePolicy>
+void BasicConcurrentGroceryList<StoragePolicy>::remove( GroceryItem const & groceryItem )
+{
+  update( [&]( List & groceryList ) { groceryList.remove( groceryItem ); } );
+}
+
+
+
+// remove( offset )
+template<typename StoragePolicy>
+void BasicConcurrentGroceryList<StoragePolicy>::remove( std::size_t offsetFromTop )
+{
+  update( [&]( List & groceryList ) { groceryList.remove( offsetFromTop ); } );
+}
+
+
+
+// moveToTop()
+template<typename StoragePolicy>
+void BasicConcurrentGroceryList<StoragePolicy>::moveToTop( GroceryItem const & groceryItem )
+{
+  update( [&]( List & groceryList ) { groceryList.moveToTop( groceryItem ); } );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Private member functions
+*******************************************************************************/
+
+// readerShard()
+template<typename StoragePolicy>
+std::size_t BasicConcurrentGroceryList<StoragePolicy>::readerShard() noexcept
+{
+  // Threads take shards in turn, so a few threads reading at once seldom share one
+  static std::atomic<std::size_t> nextShard = 0;
+  thread_local std::size_t const  shard     = nextShard.fetch_add( 1, std::memory_order_relaxed ) % READER_SHARDS;
+  return shard;
+}
+
+
+
+// publish()
+template<typename StoragePolicy>
+void BasicConcurrentGroceryList<StoragePolicy>::publish( Snapshot next )
+{
+  // read() finds the new version from here on.  The one it replaced may still be in a read(), so it waits out a grace period.
+  _reading.store( next.get() );
+  _retired.push_back( _current.exchange( std::move( next ), std::memory_order_acq_rel ) );
+}
+
+
+
+// reclaim()
+template<typename StoragePolicy>
+std::vector<typename BasicConcurrentGroceryList<StoragePolicy>::Snapshot> BasicConcurrentGroceryList<StoragePolicy>::reclaim()
+{
+  // A read() reaches a version only through _reading, which has moved past every retired version.  So only a read() already under
+  // way can still be using one.
+  //
+  // A grace period starts after _reading has moved on, by advancing the epoch.  Readers counted in the old epoch's parity when its
+  // count is then seen to be zero have all returned.  Any reader counted there later changed the count after that, so it sees the
+  // new epoch, moves its count to the new parity, and reads _reading later still.  Often no read() was under way at all, and the
+  // grace period is over as soon as it starts.
+  std::vector<Snapshot> reclaimed;
+  auto graceOver = [&]
+  {
+    if( reading( ( _epoch.load() - 1 ) & 1 ) != 0 )   return;
+    std::move( _grace.begin(), _grace.end(), std::back_inserter( reclaimed ) );
+    _grace.clear();
+  };
+
+  if( !_grace.empty() )   graceOver();
+
+  if( _grace.empty()  &&  !_retired.empty() )
+  {
+    _grace.swap( _retired );
+    _epoch.fetch_add( 1 );
+    graceOver();
+  }
+
+  return reclaimed;
+}
+
+
+
+// reading() const
+template<typename StoragePolicy>
+std::size_t BasicConcurrentGroceryList<StoragePolicy>::reading( std::size_t parity ) const noexcept
+{
+  std::size_t count = 0;
+  for( auto const & shard : _readers )   count += shard.reading[parity].load();
+  return count;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Non-member functions
+*******************************************************************************/
+
+// operator<<
+template<typename StoragePolicy>
+std::ostream & operator<<( std::ostream & stream, BasicConcurrentGroceryList<StoragePolicy> const & groceryList )
+{
+  return stream << *groceryList.snapshot();
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Explicit instantiations
+*******************************************************************************/
+
+template class BasicConcurrentGroceryList<SmallVectorStorage<>>;
+template class BasicConcurrentGroceryList<VectorStorage       >;
+template class BasicConcurrentGroceryList<ListStorage         >;
+template class BasicConcurrentGroceryList<TreeStorage         >;
+template class BasicConcurrentGroceryList<PersistentStorage   >;
+template class BasicConcurrentGroceryList<ShadowStorage<>     >;
+
+template std::ostream & operator<<( std::ostream &, BasicConcurrentGroceryList<SmallVectorStorage<>> const & );
+template std::ostream & operator<<( std::ostream &, BasicConcurrentGroceryList<VectorStorage       > const & );
+template std::ostream & operator<<( std::ostream &, BasicConcurrentGroceryList<ListStorage         > const & );
+template std::ostream & operator<<( std::ostream &, BasicConcurrentGroceryList<TreeStorage         > const & );
+template std::ostream & operator<<( std::ostream &, BasicConcurrentGroceryList<PersistentStorage   > const & );
+template std::ostream & operator<<( std::ostream &, BasicConcurrentGroceryList<ShadowStorage<>     > const & );
@@ -0,0 +1,175 @@
+#pragma once                                                                                  // include guard
+
+#include <atomic>
+#include <concepts>                                                                           // invocable
+#include <cstddef>                                                                            // size_t
+#include <cstdint>                                                                            // uint64_t
+#include <functional>                                                                         // invoke()
+#include <iostream>
+#include <memory>                                                                             // shared_ptr, atomic<shared_ptr>
+#include <mutex>
+#include <utility>                                                                            // forward()
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "GroceryList.hpp"
+#include "GroceryListBase.hpp"
+#include "GroceryListStorage.hpp"
+
+
+// A grocery list shared by many threads.  Readers never wait for writers:  every version of the list is an immutable snapshot,
+// and a reader works with whichever snapshot was current when it started, for as long as it likes.  Writers take turns.  Each
+// copies the current snapshot, changes the copy, and publishes it as the new current snapshot - read-copy-update - so a change is
+// seen by readers all at once or not at all, and a writer never holds up a reader.  A snapshot is reclaimed when the last reader
+// holding it lets go.
+//
+// Copying makes every change O(n), so update() applies a batch of changes to a single copy (or, with PersistentStorage, copying is
+// constant time and each change logarithmic).  For example:
+//
+//    ConcurrentGroceryList shared;
+//    shared.update( [&]( GroceryList & groceryList ) { groceryList.insert( item1 );  groceryList.remove( item2 ); } );
+//    auto count = shared.read( []( GroceryList const & groceryList ) { return groceryList.size(); } );
+//
+// read() doesn't touch the snapshot's reference count at all.  Each read() is counted instead, on one of a few cache lines picked
+// per thread, under the epoch it started in.  A writer holds on to the versions it replaces until a grace period later:  it starts
+// a new epoch, and once every read() counted in the old one has returned, nothing can reach them (as GroceryItemQueue frees its
+// segments).  So nothing is kept alive once a read() returns, except that a version replaced while a read() was under way waits
+// for a later update() to find the grace period over, or for the list to be destroyed.
+template<typename StoragePolicy>  class BasicConcurrentGroceryList;
+
+using ConcurrentGroceryList = BasicConcurrentGroceryList<SmallVectorStorage<>>;
+
+
+
+// Insertion Operator - writes the current snapshot
+template<typename StoragePolicy>  std::ostream & operator<<( std::ostream & stream, BasicConcurrentGroceryList<StoragePolicy> const & groceryList );
+
+
+
+template<typename StoragePolicy>
+class BasicConcurrentGroceryList : public GroceryListBase
+{
+  public:
+    // Types and Exceptions (see GroceryListBase for Position and the exceptions)
+    using List     = BasicGroceryList<StoragePolicy>;
+    using Snapshot = std::shared_ptr<List const>;
+
+
+    // Constructors, destructor, and assignments
+    BasicConcurrentGroceryList(                      );                                       // constructs an empty grocery list
+    explicit BasicConcurrentGroceryList( List initial );                                      // constructs a shared grocery list starting out as initial
+
+    BasicConcurrentGroceryList            ( BasicConcurrentGroceryList const & ) = delete;  // shared by address, so neither copied nor moved
+    BasicConcurrentGroceryList & operator=( BasicConcurrentGroceryList const & ) = delete;
+
+
+    // Queries - never block
+    Snapshot    snapshot() const;                                                             // returns the current version, unchanged for as long as it's held
+
+    template<std::invocable<List const &> Function>
+    decltype(auto) read( Function && function ) const;                                        // calls function with the current version and returns what it returns.  The version
+                                                                                              // (and anything function returns referring into it) is only valid during the call
+
+    std::size_t size() const;                                                                 // returns the number of grocery items in the current version
+    std::size_t find( GroceryItem const & groceryItem ) const;                                // returns the grocery item's offset in the current version, size() if not found
+
+
+    // Modifiers - one writer at a time, each publishing a new version
+    template<std::invocable<List &> Function>
+    void update( Function && change );                                                        // calls change with a copy of the current version, then publishes the copy.  Nothing
+                                                                                              // is published if change throws
+
+    void insert   ( GroceryItem const & groceryItem, Position    position = Position::TOP );  // as GroceryList's modifiers of the same names, each published as its own version
+    void insert   ( GroceryItem const & groceryItem, std::size_t offsetFromTop            );
+    void remove   ( GroceryItem const & groceryItem                                       );
+    void remove   ( std::size_t         offsetFromTop                                     );
+    void moveToTop( GroceryItem const & groceryItem                                       );
+
+
+  private:
+    // Class Attributes
+    static constexpr std::size_t READER_SHARDS = 16;                                          // cache lines read() is counted on
+
+    struct alignas( 64 ) ReaderShard                                                          // on a cache line of its own, so threads counted on different ones don't contend
+    {
+      std::atomic<std::size_t> reading[2] = {};                                               // read() calls under way, by the parity of the epoch they started in
+    };
+    static std::size_t readerShard() noexcept;                                                // this thread's shard
+
+
+    // Instance Attributes
+    alignas( 64 ) std::atomic<List const *>    _reading = nullptr;                            // the current version, as read() sees it.  Kept alive by _current until replaced, then
+                                                                                              // by _retired and _grace
+    alignas( 64 ) std::atomic<std::uint64_t>   _epoch   = 0;                                  // advanced by a writer to start a grace period
+    mutable ReaderShard                        _readers[READER_SHARDS];
+
+    alignas( 64 ) std::atomic<Snapshot>        _current;
+    std::mutex                                 _writer;                                       // serializes writers, never taken by readers
+    std::vector<Snapshot>                      _retired;                                      // replaced versions waiting for the next grace period.  Guarded by _writer
+    std::vector<Snapshot>                      _grace;                                        // replaced versions waiting for the current grace period to end.  Guarded by _writer
+
+
+    // Helper member functions
+    void                  publish( Snapshot next               );                             // makes next the current version and retires the one it replaced.  The caller holds _writer
+    std::vector<Snapshot> reclaim(                             );                             // ends and starts grace periods, returning the versions no read() can still reach.  The
+                                                                                              // caller holds _writer
+    std::size_t           reading( std::size_t parity ) const noexcept;                       // read() calls under way that started in an epoch of that parity
+};
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Member function templates
+*******************************************************************************/
+
+// read() const
+template<typename StoragePolicy>
+template<std::invocable<BasicGroceryList<StoragePolicy> const &> Function>
+decltype(auto) BasicConcurrentGroceryList<StoragePolicy>::read( Function && function ) const
+{
+  // Counted for the whole call, under the epoch it started in, so writers know whether a reader might still be using a version
+  // they've replaced.  The count must change before _reading is read - sequentially consistent, both here and in reclaim().  A
+  // count that raced a writer starting a new epoch is moved to the new one, so a grace period never misses a reader that started
+  // before it did.
+  struct Reading
+  {
+    std::atomic<std::size_t> * count = nullptr;
+
+    Reading( ReaderShard & shard, std::atomic<std::uint64_t> const & epoch ) noexcept
+    {
+      for( auto started = epoch.load();  ;  started = epoch.load() )
+      {
+        count = &shard.reading[started & 1];
+        count->fetch_add( 1 );
+        if( epoch.load() == started )   return;
+        count->fetch_sub( 1 );
+      }
+    }
+   ~Reading() { count->fetch_sub( 1 ); }
+    Reading( Reading const & ) = delete;
+    Reading & operator=( Reading const & ) = delete;
+  } const reading( _readers[readerShard()], _epoch );
+
+  return std::invoke( std::forward<Function>( function ), *_reading.load() );
+}
+
+
+
+// update()
+template<typename StoragePolicy>
+template<std::invocable<BasicGroceryList<StoragePolicy> &> Function>
+void BasicConcurrentGroceryList<StoragePolicy>::update( Function && change )
+{
+  std::vector<Snapshot> reclaimed;                                                            // outlives the lock, so versions no reader holds are destroyed after it's released
+
+  std::lock_guard lock( _writer );
+  auto next = std::make_shared<List>( *_current.load( std::memory_order_acquire ) );
+  std::invoke( std::forward<Function>( change ), *next );
+  publish( std::move( next ) );
+  reclaimed = reclaim();
+}
@@ -0,0 +1,20 @@
+#pragma once                                                                                  // include guard
+
+#include <string>                                                                             // string, to_string()
+
+
+// Appends where an exception was thrown - function, line, and file - to its message, for example
+//
+//    throw InvalidInternalState_Ex( "Container consistency error" exception_location );
+//
+// As a rule, I strongly recommend avoiding macros, unless there is a compelling reason - this is such a case. This really does need
+// to be a macro and not a function due to the way the preprocessor expands the source code location information.  It's important to
+// have these expanded where they are used, and not here. But I just can't bring myself to writing this, and getting it correct,
+// everywhere it is used.  Note:  C++20 will change this technique with the introduction of the std::source_location class. Also note the
+// usage of having the preprocessor concatenate two string literals separated only by whitespace.  :(  In the meantime ...
+//
+// Update:  As of August 2023 and clang 16, still no support for source_location. Rummer has it that they may never implement it.
+// Yay Microsoft and GCC!
+#define exception_location "\n detected in function \"" + std::string(__func__) +  "\""    \
+                           "\n at line " + std::to_string( __LINE__ ) +                    \
+                           "\n in file \"" __FILE__ "\""
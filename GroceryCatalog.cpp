@@ -0,0 +1,265 @@
+#include <algorithm>                                                                // ranges::find(), ranges::find_if()
+#include <cstddef>                                                                  // size_t
+#include <cstdint>                                                                  // uint32_t
+#include <limits>                                                                   // numeric_limits
+#include <optional>
+#include <ranges>                                                                   // views::iota()
+#include <span>
+#include <stdexcept>                                                                // length_error
+#include <string>
+#include <string_view>
+#include <utility>                                                                  // move()
+#include <vector>
+
+#include "ExceptionLocation.hpp"
+#include "GroceryCatalog.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryList.hpp"
+#include "GroceryListStorage.hpp"
+#include "Money.hpp"
+#include "UpcCode.hpp"
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Constructors
+*******************************************************************************/
+
+// Constructor - from a grocery list
+template<typename StoragePolicy>
+GroceryCatalog::GroceryCatalog( BasicGroceryList<StoragePolicy> const & groceryList )
+{
+  reserve( groceryList.size() );
+  for( auto const & groceryItem : groceryList._storage )   append( groceryItem );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+std::size_t GroceryCatalog::size      () const noexcept   { return _prices.size();     }
+bool        GroceryCatalog::empty     () const noexcept   { return _prices.empty();    }
+std::size_t GroceryCatalog::brandCount() const noexcept   { return _brandNames.size(); }
+
+
+
+// Columns
+std::span<UpcCode                 const> GroceryCatalog::upcCodes() const noexcept   { return _upcCodes; }
+std::span<GroceryCatalog::BrandId const> GroceryCatalog::brandIds() const noexcept   { return _brandIds; }
+std::span<Money                   const> GroceryCatalog::prices  () const noexcept   { return _prices;   }
+
+
+
+// productName() const
+std::string_view GroceryCatalog::productName( std::size_t position ) const noexcept
+{
+  std::size_t const first = _nameOffsets[position];
+  std::size_t const last  = position + 1 < _nameOffsets.size() ? _nameOffsets[position + 1] : _names.size();
+  return std::string_view( _names ).substr( first, last - first );
+}
+
+
+
+// brandName() const
+std::string const & GroceryCatalog::brandName( BrandId brandId ) const noexcept
+{
+  return GroceryItem::textOf( _brandNames[brandId] );
+}
+
+
+
+// groceryItem() const
+GroceryItem GroceryCatalog::groceryItem( std::size_t position ) const
+{
+  // The UPC code and brand name are copied as they're held, already packed and shared, so only the product name is rebuilt
+  GroceryItem groceryItem;
+  groceryItem.productName( productName( position ) );
+  groceryItem._upcCode   = _upcCodes[position];
+  groceryItem._brandName = _brandNames[_brandIds[position]];
+  groceryItem._price     = _prices[position];
+  return groceryItem;
+}
+
+
+
+// toGroceryList() const
+template<typename StoragePolicy>
+BasicGroceryList<StoragePolicy> GroceryCatalog::toGroceryList() const
+{
+  // A catalog made from a grocery list has no duplicates, but one appended to directly might, so they're weeded out like any other
+  // batch
+  std::vector<GroceryItem> batch;
+  batch.reserve( size() );
+  for( std::size_t position = 0; position < size(); ++position )   batch.push_back( groceryItem( position ) );
+
+  BasicGroceryList<StoragePolicy> groceryList;
+  groceryList.insertBatch( std::move( batch ), 0 );
+  return groceryList;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Scans
+*******************************************************************************/
+
+// total() const
+Money GroceryCatalog::total() const
+{
+  return Money::sum( _prices );
+}
+
+
+
+// total( brandId ) const
+Money GroceryCatalog::total( BrandId brandId ) const
+{
+  // Other brands' prices are added as zero rather than skipped, so the loop has no branch and still vectorizes
+  return Money::sum( std::views::iota( std::size_t{ 0 }, size() ), [&]( std::size_t position ) noexcept
+                     { return Money::fromMills( _brandIds[position] == brandId ? _prices[position].mills() : 0 ); } );
+}
+
+
+
+// countPriced() const
+std::size_t GroceryCatalog::countPriced( Money low, Money high ) const noexcept
+{
+  std::size_t count = 0;
+  for( auto const price : _prices )   count += ( low <= price  &&  price <= high ) ? 1 : 0;
+  return count;
+}
+
+
+
+// priceRange() const
+std::vector<std::size_t> GroceryCatalog::priceRange( Money low, Money high ) const
+{
+  // Counting first is another pass over the prices, but a cheap one, and then the result is allocated exactly once
+  std::vector<std::size_t> positions;
+  positions.reserve( countPriced( low, high ) );
+  for( std::size_t position = 0; position < _prices.size(); ++position )
+  {
+    if( low <= _prices[position]  &&  _prices[position] <= high )   positions.push_back( position );
+  }
+  return positions;
+}
+
+
+
+// find() const
+std::size_t GroceryCatalog::find( UpcCode const & upcCode ) const noexcept
+{
+  return static_cast<std::size_t>( std::ranges::find( _upcCodes, upcCode ) - _upcCodes.begin() );
+}
+
+
+
+// brandId() const
+std::optional<GroceryCatalog::BrandId> GroceryCatalog::brandId( std::string_view brandName ) const noexcept
+{
+  // Distinct brands are few, far fewer than grocery items, so a linear search of the table is plenty
+  auto const brand = std::ranges::find_if( _brandNames, [&]( GroceryItem::BrandName const & name ) noexcept { return GroceryItem::textOf( name ) == brandName; } );
+  if( brand == _brandNames.end() )   return std::nullopt;
+  return static_cast<BrandId>( brand - _brandNames.begin() );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// append()
+void GroceryCatalog::append( GroceryItem const & groceryItem )
+{
+  auto const & productName = groceryItem._productName;
+  auto const   namesSize   = _names.size();
+  if( productName.size() > std::numeric_limits<std::uint32_t>::max() - namesSize )
+  {
+    throw std::length_error( "Grocery catalog:  more than 4 GiB of product names" exception_location );
+  }
+
+  auto const count           = size();
+  auto const [brand, newBrand] = _brandIdsByName.try_emplace( groceryItem.brandName(), static_cast<BrandId>( _brandNames.size() ) );
+  try
+  {
+    if( newBrand )   _brandNames.push_back( groceryItem._brandName );
+    _names      .append   ( productName );
+    _nameOffsets.push_back( static_cast<std::uint32_t>( namesSize ) );
+    _upcCodes   .push_back( groceryItem._upcCode );
+    _brandIds   .push_back( brand->second );
+    _prices     .push_back( groceryItem._price );
+  }
+  catch( ... )
+  {
+    // Put every column back the way it was, so they never disagree about how many grocery items there are
+    _names      .resize( namesSize );
+    _nameOffsets.resize( count );
+    _upcCodes   .resize( count );
+    _brandIds   .resize( count );
+    if( newBrand )
+    {
+      _brandNames.resize( brand->second );
+      _brandIdsByName.erase( brand );
+    }
+    throw;
+  }
+}
+
+
+
+// reserve()
+void GroceryCatalog::reserve( std::size_t count )
+{
+  _upcCodes   .reserve( count );
+  _brandIds   .reserve( count );
+  _nameOffsets.reserve( count );
+  _prices     .reserve( count );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Explicit instantiations
+*******************************************************************************/
+
+template GroceryCatalog::GroceryCatalog( BasicGroceryList<SmallVectorStorage<>> const & );
+template GroceryCatalog::GroceryCatalog( BasicGroceryList<VectorStorage       > const & );
+template GroceryCatalog::GroceryCatalog( BasicGroceryList<ListStorage         > const & );
+template GroceryCatalog::GroceryCatalog( BasicGroceryList<TreeStorage         > const & );
+template GroceryCatalog::GroceryCatalog( BasicGroceryList<PersistentStorage   > const & );
+template GroceryCatalog::GroceryCatalog( BasicGroceryList<ShadowStorage<>     > const & );
+
+template BasicGroceryList<SmallVectorStorage<>> GroceryCatalog::toGroceryList() const;
+template BasicGroceryList<VectorStorage       > GroceryCatalog::toGroceryList() const;
+template BasicGroceryList<ListStorage         > GroceryCatalog::toGroceryList() const;
+template BasicGroceryList<TreeStorage         > GroceryCatalog::toGroceryList() const;
+template BasicGroceryList<PersistentStorage   > GroceryCatalog::toGroceryList() const;
+template BasicGroceryList<ShadowStorage<>     > GroceryCatalog::toGroceryList() const;
@@ -0,0 +1,93 @@
+#pragma once                                                                                  // include guard
+
+#include <cstddef>                                                                            // size_t
+#include <cstdint>                                                                            // uint32_t
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "GroceryList.hpp"
+#include "GroceryListStorage.hpp"
+#include "Money.hpp"
+#include "UpcCode.hpp"
+
+
+// Grocery items stored column by column rather than one grocery item at a time, for scans over a great many of them.  A grocery
+// item spreads its attributes over a record of several dozen bytes, a product name string included, so summing the prices of a
+// grocery list drags all of that through the cache just to read 8 bytes of each.  A catalog instead keeps each attribute in its
+// own contiguous column:
+//
+//    UPC codes        one packed UpcCode (a single 64-bit word) per grocery item
+//    brand ids        one 32-bit id per grocery item, indexing the catalog's table of distinct brand names
+//    product names    one 32-bit offset per grocery item into a single shared buffer holding every product name end to end
+//    prices           one Money (an integer number of mills) per grocery item
+//
+// so a scan reads only the columns it needs, front to back, and runs at memory bandwidth.  For example:
+//
+//    GroceryCatalog catalog( groceryList );
+//    auto total   = catalog.total();                                  // reads only the prices
+//    auto bargain = catalog.priceRange( low, high );                  // positions of the grocery items priced low through high
+//
+// Grocery items are identified by position, their order of arrival.  A catalog converts back into a grocery list, or into
+// individual grocery items, but it isn't a grocery list:  it only appends, and it keeps whatever it's given, duplicates included.
+class GroceryCatalog
+{
+  public:
+    // Types
+    using BrandId = std::uint32_t;                                                            // a brand name's position in the catalog's brand name table
+
+
+    // Constructors
+    GroceryCatalog() = default;                                                               // an empty catalog
+
+    template<typename StoragePolicy>
+    explicit GroceryCatalog( BasicGroceryList<StoragePolicy> const & groceryList );           // the grocery list's grocery items, top to bottom
+
+
+    // Queries
+    std::size_t size      () const noexcept;                                                  // returns the number of grocery items in the catalog
+    bool        empty     () const noexcept;
+    std::size_t brandCount() const noexcept;                                                  // returns the number of distinct brand names, the ids 0 through brandCount() - 1
+
+    std::span<UpcCode const> upcCodes() const noexcept;                                       // the columns, one element per grocery item, by position
+    std::span<BrandId const> brandIds() const noexcept;
+    std::span<Money   const> prices  () const noexcept;
+
+    std::string_view    productName( std::size_t position ) const noexcept;                  // valid until the catalog is next modified.  position must be less than size()
+    std::string const & brandName  ( BrandId     brandId  ) const noexcept;                  // brandId must be less than brandCount()
+    GroceryItem         groceryItem( std::size_t position ) const;                            // the grocery item at position, put back together
+
+    template<typename StoragePolicy = SmallVectorStorage<>>
+    BasicGroceryList<StoragePolicy> toGroceryList() const;                                    // a grocery list of the catalog's grocery items, in order, duplicates skipped
+
+
+    // Scans                                                                                  // each a single pass over only the columns it reads
+    Money                    total      (                       ) const;                      // returns the sum of the prices, exactly.  Throws Money::Overflow_Ex if the sum
+    Money                    total      ( BrandId brandId       ) const;                      // can't be represented.  The second sums only that brand's prices
+    std::size_t              countPriced( Money low, Money high ) const noexcept;             // returns how many grocery items are priced from low through high
+    std::vector<std::size_t> priceRange ( Money low, Money high ) const;                      // returns the positions of the grocery items priced from low through high, in order
+    std::size_t              find       ( UpcCode const & upcCode ) const noexcept;           // returns the position of the first grocery item with upcCode, size() if there isn't one
+    std::optional<BrandId>   brandId    ( std::string_view brandName ) const noexcept;        // returns the brand name's id, if any grocery item in the catalog has it
+
+
+    // Modifiers
+    void append ( GroceryItem const & groceryItem );                                          // adds the grocery item at the end.  Throws std::length_error past 4 GiB of product
+                                                                                              // names.  Leaves the catalog as it was if anything throws
+    void reserve( std::size_t count );                                                        // makes room for count grocery items in every column (but the product name buffer)
+
+
+  private:
+    // Instance Attributes
+    std::vector<UpcCode>                             _upcCodes;
+    std::vector<BrandId>                             _brandIds;
+    std::vector<std::uint32_t>                       _nameOffsets;                            // where each product name starts in _names, and so where the one before it ends
+    std::vector<Money>                               _prices;
+    std::string                                      _names;                                  // every product name, end to end
+
+    std::vector<GroceryItem::BrandName>              _brandNames;                             // BrandId -> brand name, shared with the grocery items it came from
+    std::unordered_map<std::string, BrandId>         _brandIdsByName;                         // the reverse, keyed by the brand name's text
+};
@@ -1,49 +1,21 @@
-#include <cmath>                                                      // abs(), pow()
+#include <bit>                                                        // endian
 #include <compare>                                                    // weak_ordering
+#include <cstddef>                                                    // size_t
+#include <cstdint>                                                    // uint64_t
+#include <cstring>                                                    // memcpy()
+#include <functional>                                                 // hash
 #include <iomanip>                                                    // quoted(), ios::failbit
 #include <iostream>                                                   // istream, ostream, ws()
+#include <memory>                                                     // make_shared()
+#include <memory_resource>                                            // polymorphic_allocator, pmr::string
 #include <string>
-#include <type_traits>                                                // is_floating_point_v, common_type_t
+#include <string_view>
 #include <utility>                                                    // move()
 
 #include "GroceryItem.hpp"
-
-
-
-/*******************************************************************************
-**  Implementation of non-member private types, objects, and functions
-*******************************************************************************/
-namespace    // unnamed, anonymous namespace
-{
-  // Avoid direct equality comparisons on floating point numbers. Two values are equal if they are "close enough", which is
-  // represented by Epsilon.  Usually, this is a pretty small number, but since we are dealing with money (only two, maybe three
-  // decimal places) we can be a bit more tolerant.  Two floating point values are considered equal if they are within EPSILON of
-  // each other.
-  template< typename T,  typename U >   requires std::is_floating_point_v<std::common_type_t<T, U> >
-  constexpr bool floating_point_is_equal( T const lhs,  U const rhs,  double const EPSILON = 1e-4 ) noexcept
-  {
-    ///////////////////////// TO-DO (1) //////////////////////////////
-      ///  Write the lines of code that compare two floating point numbers.  Return true when the left hand side (lhs) and the right
-      ///  hand side (rhs) are within Epsilon, and false otherwise.
-      ///
-      ///  See: "Floating point equality" in https://www.learncpp.com/cpp-tutorial/relational-operators-and-floating-point-comparisons/
-      ///
-      ///  Hint:  Avoid writing code that looks like this:
-      ///           if( some expression that is true ) return the constant "true"
-      ///           else                               return the constant "false"
-      ///         for example, avoid:
-      ///           if (a < b) return true;
-      ///           else       return false;
-      ///         do this instead:
-      ///           return a < b;
-    return std::abs(lhs - rhs) <= EPSILON;
-    /////////////////////// END-TO-DO (1) ////////////////////////////
-  }
-}    // unnamed, anonymous namespace
-
-
-
-
+#include "Money.hpp"
+#include "StringPool.hpp"
+#include "UpcCode.hpp"
 
 
 
@@ -52,10 +24,10 @@ namespace    // unnamed, anonymous namespace
 *******************************************************************************/
 
 // Default and Conversion Constructor
-GroceryItem::GroceryItem( std::string productName, std::string brandName, std::string upcCode, double price )
+GroceryItem::GroceryItem( std::string_view productName, std::string brandName, std::string upcCode, double price )
 ///////////////////////// TO-DO (2) //////////////////////////////
   /// Copying the parameters into the object's attributes (member variables) "works" but is not correct.  Be sure to move the parameters into the object's attributes
-:  _upcCode{std::move(upcCode)}, _brandName{std::move(brandName)}, _productName{std::move(productName)}, _price{price} {}
+:  _upcCode{upcCode}, _brandName{brandNameOf(std::move(brandName))}, _productName{productName}, _price{Money::fromDollars(price)}, _namePrefix{namePrefixOf(_productName)} {}
 
 /////////////////////// END-TO-DO (2) ////////////////////////////
 
@@ -65,7 +37,7 @@ GroceryItem::GroceryItem( std::string productName, std::string brandName, std::s
 // Copy constructor
 GroceryItem::GroceryItem( GroceryItem const & other )
 ///////////////////////// TO-DO (3) //////////////////////////////
-: _upcCode{other._upcCode}, _brandName{other._brandName}, _productName{other._productName}, _price{other._price} 
+: _upcCode{other._upcCode}, _brandName{other._brandName}, _productName{other._productName}, _price{other._price}, _namePrefix{other._namePrefix}
 
 /////////////////////// END-TO-DO (3) ////////////////////////////
 {}                                                                    // Avoid setting values in constructor's body (when possible)
@@ -76,14 +48,34 @@ GroceryItem::GroceryItem( GroceryItem const & other )
 // Move constructor
 GroceryItem::GroceryItem( GroceryItem && other ) noexcept
 ///////////////////////// TO-DO (4) //////////////////////////////
-: _upcCode{std::move(other._upcCode)}, _brandName{std::move(other._brandName)}, _productName{std::move(other._productName)}, _price{other._price}
+: _upcCode{std::move(other._upcCode)}, _brandName{std::move(other._brandName)}, _productName{std::move(other._productName)}, _price{other._price}, _namePrefix{other._namePrefix}
 
 /////////////////////// END-TO-DO (4) ////////////////////////////
+{
+  other._namePrefix = namePrefixOf( other._productName );             // whatever the moved from name was left holding (empty, in practice)
+}
+
+
+
+
+// Allocator extended copy constructor
+GroceryItem::GroceryItem( GroceryItem const & other, allocator_type const & allocator )
+: _upcCode{other._upcCode}, _brandName{other._brandName}, _productName{other._productName, allocator}, _price{other._price}, _namePrefix{other._namePrefix}
 {}
 
 
 
 
+// Allocator extended move constructor
+GroceryItem::GroceryItem( GroceryItem && other, allocator_type const & allocator )
+: _upcCode{std::move(other._upcCode)}, _brandName{std::move(other._brandName)}, _productName{std::move(other._productName), allocator}, _price{other._price}, _namePrefix{other._namePrefix}
+{
+  other._namePrefix = namePrefixOf( other._productName );             // moved from only if the allocators agreed, otherwise copied and left as it was
+}
+
+
+
+
 // Copy Assignment Operator
 GroceryItem & GroceryItem::operator=( GroceryItem const & rhs ) &
 {
@@ -92,6 +84,7 @@ _upcCode = rhs._upcCode;
 _brandName = rhs._brandName;
 _productName = rhs._productName;
 _price = rhs._price;
+_namePrefix = rhs._namePrefix;
 return *this;
   /////////////////////// END-TO-DO (5) ////////////////////////////
 }
@@ -100,13 +93,15 @@ return *this;
 
 
 // Move Assignment Operator
-GroceryItem & GroceryItem::operator=( GroceryItem && rhs ) & noexcept
+GroceryItem & GroceryItem::operator=( GroceryItem && rhs ) &
 ///////////////////////// TO-DO (6) //////////////////////////////
 { 
 _productName = std::move(rhs._productName);
 _brandName = std::move(rhs._brandName);
 _upcCode = std::move(rhs._upcCode);
 _price = rhs._price;
+_namePrefix = rhs._namePrefix;
+rhs._namePrefix = namePrefixOf( rhs._productName );
 return *this;
 }
 /////////////////////// END-TO-DO (6) ////////////////////////////
@@ -131,10 +126,10 @@ GroceryItem::~GroceryItem() noexcept = default;
 *******************************************************************************/
 
 // upcCode() const    (L-value objects)
-std::string const & GroceryItem::upcCode() const &
+std::string GroceryItem::upcCode() const &
 {
   ///////////////////////// TO-DO (8) //////////////////////////////
-return _upcCode;
+return _upcCode.toString();
 
   /////////////////////// END-TO-DO (8) ////////////////////////////
 }
@@ -146,7 +141,7 @@ return _upcCode;
 ///////////////////////// TO-DO (9) //////////////////////////////
 std::string const & GroceryItem::brandName() const &
 {
-  return _brandName;
+  return textOf( _brandName );
 }
 /////////////////////// END-TO-DO (9) ////////////////////////////
 
@@ -155,7 +150,7 @@ std::string const & GroceryItem::brandName() const &
 
 // productName() const    (L-value objects)
 ///////////////////////// TO-DO (10) //////////////////////////////
-std::string const & GroceryItem::productName() const &
+std::pmr::string const & GroceryItem::productName() const &
 {
   return _productName;
 }
@@ -167,18 +162,38 @@ std::string const & GroceryItem::productName() const &
 ///////////////////////// TO-DO (11) //////////////////////////////
 double GroceryItem::price() const &
 {
-  return _price;
+  return _price.toDollars();
 }
 /////////////////////// END-TO-DO (11) ////////////////////////////
 
 
 
 
+// exactPrice() const
+Money GroceryItem::exactPrice() const noexcept
+{
+  return _price;
+}
+
+
+
+
+// get_allocator() const
+GroceryItem::allocator_type GroceryItem::get_allocator() const noexcept
+{
+  return _productName.get_allocator();
+}
+
+
+
+
 // upcCode()    (R-value objects)
 std::string GroceryItem::upcCode() &&
 {
   ///////////////////////// TO-DO (12) //////////////////////////////
- return std::move(_upcCode);
+ auto upcCode = _upcCode.toString();
+ _upcCode = {};                                                      // hand over the state, just as moving a string out would
+ return upcCode;
 
   /////////////////////// END-TO-DO (12) ////////////////////////////
 }
@@ -190,7 +205,9 @@ std::string GroceryItem::upcCode() &&
 ///////////////////////// TO-DO (13) //////////////////////////////
 std::string GroceryItem::brandName() &&
 {
-  return std::move(_brandName);
+  std::string brandName = textOf( _brandName );
+  _brandName.reset();                                                 // hand over the state, just as moving a string out would
+  return brandName;
 }
 /////////////////////// END-TO-DO (13) ////////////////////////////
 
@@ -199,9 +216,11 @@ std::string GroceryItem::brandName() &&
 
 // productName()    (R-value objects)
 ///////////////////////// TO-DO (14) //////////////////////////////
-std::string GroceryItem::productName() &&
+std::pmr::string GroceryItem::productName() &&
 {
-  return std::move(_productName);
+  auto productName = std::move(_productName);
+  _namePrefix      = namePrefixOf( _productName );
+  return productName;
 }
 /////////////////////// END-TO-DO (14) ////////////////////////////
 
@@ -221,7 +240,7 @@ GroceryItem & GroceryItem::upcCode( std::string newUpcCode ) &
 {
   ///////////////////////// TO-DO (15) //////////////////////////////
     /// Copy assignment "works" but is not correct.  Be sure to move newUpcCode into _upcCode
-_upcCode = std::move(newUpcCode);
+_upcCode = UpcCode( newUpcCode );
 return *this;
   /////////////////////// END-TO-DO (15) ////////////////////////////
 }
@@ -233,7 +252,7 @@ return *this;
 ///////////////////////// TO-DO (16) //////////////////////////////
 GroceryItem & GroceryItem::brandName(std::string newBrandName) &
 {
-  _brandName = std::move(newBrandName);
+  _brandName = brandNameOf( std::move( newBrandName ) );
   return *this;
 }
 /////////////////////// END-TO-DO (16) ////////////////////////////
@@ -243,9 +262,10 @@ GroceryItem & GroceryItem::brandName(std::string newBrandName) &
 
 // productName(...)
 ///////////////////////// TO-DO (17) //////////////////////////////
-GroceryItem & GroceryItem::productName(std::string newProductName) & 
+GroceryItem & GroceryItem::productName(std::string_view newProductName) & 
 {
-  _productName = std::move(newProductName);
+  _productName = newProductName;
+  _namePrefix  = namePrefixOf( _productName );
   return *this;
 }
 /////////////////////// END-TO-DO (17) ////////////////////////////
@@ -257,7 +277,7 @@ GroceryItem & GroceryItem::productName(std::string newProductName) &
 ///////////////////////// TO-DO (18) //////////////////////////////
 GroceryItem & GroceryItem::price( double newPrice) &
 {
-  _price = newPrice;
+  _price = Money::fromDollars( newPrice );
   return *this;
 }
 /////////////////////// END-TO-DO (18) ////////////////////////////
@@ -265,6 +285,16 @@ GroceryItem & GroceryItem::price( double newPrice) &
 
 
 
+// price( Money )
+GroceryItem & GroceryItem::price( Money newPrice ) &
+{
+  _price = newPrice;
+  return *this;
+}
+
+
+
+
 
 
 
@@ -280,18 +310,15 @@ std::weak_ordering GroceryItem::operator<=>( const GroceryItem & rhs ) const noe
   //                         auto operator<=>( const GroceryItem & ) const = default;
   //                   in the class definition (header file) would get very close to what is needed and would allow both the <=> and
   //                   the == operators defined here to be skipped.  The physical ordering of the attributes in the class definition
-  //                   would have to be changed (easy enough in this case) but the default directly compares floating point types
-  //                   (price) for equality, and that should be avoided, in general. For example, if x and y are of type double,
-  //                   then  x < y  is okay but  x == y  is not.  So these (operator<=> and operator==) explicit definitions are
-  //                   provided.
+  //                   would have to be changed (easy enough in this case), and the brand name is held by address, so comparing it
+  //                   by default would order brands by where they happen to be held rather than by name.  So these (operator<=>
+  //                   and operator==) explicit definitions are provided.
   //
-  //                   Also, many ordering (sorting) algorithms, like those used in std::map and std::set, require at least a weak
-  //                   ordering of elements. operator<=> provides only a partial ordering when comparing floating point numbers.
+  //                   Price used to be a double, compared within an EPSILON, which made equality disagree with ordering and hashing.
+  //                   It's now Money, a whole number of mills, so prices compare exactly and all three agree.
   //
-  // Weak order:       Objects that compare equal but are not substitutable (identical).  For example, since _price can be within
-  //                   EPSILON, GroceryItem("ProductName", "BrandName", "UPC", 9.99999) and GroceryItem("ProductName", "BrandName",
-  //                   "UPC", 10.00001) are equal but they are not identical.  If you ignore case when comparing strings, as another
-  //                   example, GroceryItem("ProductName") and GroceryItem("productName") are equal but they are not identical.
+  // Weak order:       Objects that compare equal but are not substitutable (identical).  Every attribute is now compared exactly,
+  //                   but the weak ordering is kept so, for example, comparing names while ignoring case remains an option.
   //
   // See std::weak_ordering    at https://en.cppreference.com/w/cpp/utility/compare/weak_ordering and
   //     std::partial_ordering at https://en.cppreference.com/w/cpp/utility/compare/partial_ordering
@@ -299,7 +326,7 @@ std::weak_ordering GroceryItem::operator<=>( const GroceryItem & rhs ) const noe
   //     Spaceship (Three way comparison) Operator Demystified https://youtu.be/S9ShnAFmiWM
   //
   //
-  // Grocery items are equal if all attributes are equal (or within Epsilon for floating point numbers, like price). Grocery items are ordered
+  // Grocery items are equal if all attributes are equal. Grocery items are ordered
   // (sorted) by UPC code, product name, brand name, then price.
 
   ///////////////////////// TO-DO (19) //////////////////////////////
@@ -307,21 +334,16 @@ std::weak_ordering GroceryItem::operator<=>( const GroceryItem & rhs ) const noe
   if (cheker != 0){
     return cheker;
   }
-   cheker = _productName <=> rhs._productName;
+   cheker = _namePrefix != rhs._namePrefix ? _namePrefix <=> rhs._namePrefix     // decides by the first 8 characters, without touching the name's text,
+                                           : _productName <=> rhs._productName;  // unless they're the same
   if (cheker != 0) {
     return cheker;
   }
-  cheker = _brandName <=> rhs._brandName; 
+  cheker = _brandName == rhs._brandName ? std::strong_ordering::equal : brandName() <=> rhs.brandName();     // shared, so same address means same brand
   if (cheker != 0){
     return cheker;
   } 
-  if ( _price > rhs._price ) {
-    return std::weak_ordering::greater;
-  } 
-  if (_price < rhs._price) {
-    return std::weak_ordering::less;
-  }
-  return std::weak_ordering::equivalent;
+  return _price <=> rhs._price;                                                                          // exact, an integer compare
   /////////////////////// END-TO-DO (19) ////////////////////////////
 }
 
@@ -335,7 +357,9 @@ bool GroceryItem::operator==( const GroceryItem & rhs ) const noexcept
   // quickest and then the most likely to be different first.
 
   ///////////////////////// TO-DO (20) //////////////////////////////
-return floating_point_is_equal(_price, rhs._price) && _upcCode == rhs._upcCode && _brandName == rhs._brandName && _productName == rhs._productName;
+return _upcCode == rhs._upcCode && _price == rhs._price && _namePrefix == rhs._namePrefix     // integer compares, for packed UPC codes
+    && ( _brandName == rhs._brandName || brandName() == rhs.brandName() )                 // shared brands are equal by address
+    && _productName == rhs._productName;
 
   /////////////////////// END-TO-DO (20) ////////////////////////////
 }
@@ -347,6 +371,82 @@ return floating_point_is_equal(_price, rhs._price) && _upcCode == rhs._upcCode &
 
 
 
+/*******************************************************************************
+**  Private member functions
+*******************************************************************************/
+
+// namePrefixOf()
+std::uint64_t GroceryItem::namePrefixOf( std::string_view productName ) noexcept
+{
+  // Big endian, so the first character is the most significant byte and comparing prefixes as integers compares them character by
+  // character, unsigned, just as std::string does.  Short names are padded with zeros, which sort first, as the end of a string does.
+  // Names differing only in a trailing '\0' get the same prefix, but equal prefixes always fall back to comparing whole names.
+  std::uint64_t prefix = 0;
+  if( productName.size() >= sizeof( prefix ) )
+  {
+    std::memcpy( &prefix, productName.data(), sizeof( prefix ) );                 // a fixed size copy is a single load
+    if constexpr( std::endian::native == std::endian::little )   prefix = __builtin_bswap64( prefix );
+    return prefix;
+  }
+
+  for( std::size_t i = 0;  i < productName.size();  ++i )   prefix |= std::uint64_t{ static_cast<unsigned char>( productName[i] ) } << ( 56 - 8 * i );
+  return prefix;
+}
+
+
+
+// brandNameOf()
+GroceryItem::BrandName GroceryItem::brandNameOf( std::string brandName )
+{
+  if( brandName.empty() ) return nullptr;
+  return std::make_shared<HashedString const>( std::move( brandName ) );
+}
+
+
+
+// textOf()
+std::string const & GroceryItem::textOf( BrandName const & brandName ) noexcept
+{
+  static std::string const noBrandName;
+  return brandName ? brandName->text : noBrandName;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Hashing
+*******************************************************************************/
+
+// std::hash<GroceryItem>::operator()
+std::size_t std::hash<GroceryItem>::operator()( GroceryItem const & groceryItem ) const noexcept
+{
+  // Hashing must agree with operator==, so every attribute compared exactly is hashed.  The UPC code and price are hashed as the
+  // numbers they're held as (see UpcCode::hash()), and the brand name by the hash of its text worked out when it was made, so only
+  // the product name's text is looked at.
+  //
+  // Combine the individual hashes using the familiar boost::hash_combine recipe (golden ratio constant, shifts mix the high and
+  // low bits).
+  auto const brandHash = groceryItem._brandName ? groceryItem._brandName->hash : std::hash<std::string_view>{}( {} );
+
+  std::size_t seed = groceryItem._upcCode.hash();
+  seed ^= brandHash                                                   + 0x9e37'79b9'7f4a'7c15ULL + ( seed << 6 ) + ( seed >> 2 );
+  seed ^= std::hash<std::pmr::string   >{}( groceryItem._productName ) + 0x9e37'79b9'7f4a'7c15ULL + ( seed << 6 ) + ( seed >> 2 );
+  seed ^= std::hash<Money              >{}( groceryItem._price       ) + 0x9e37'79b9'7f4a'7c15ULL + ( seed << 6 ) + ( seed >> 2 );
+  return seed;
+}
+
+
+
+
+
+
+
+
 /*******************************************************************************
 **  Insertion and Extraction Operators
 *******************************************************************************/
@@ -372,10 +472,14 @@ std::istream & operator>>( std::istream & stream, GroceryItem & groceryItem )
     ///        1) https://en.cppreference.com/w/cpp/io/manip/quoted
     ///        2) https://www.youtube.com/watch?v=Mu-GUZuU31A
  GroceryItem holder;
+    std::string upcCode, brandName;                                 // read as text, then packed and shared
     char trash{'a'};
-    stream >> std::quoted(holder._upcCode) >> trash >> std::quoted(holder._brandName) >> trash >> std::quoted(holder._productName) >> trash >> holder._price;
+    stream >> std::quoted(upcCode) >> trash >> std::quoted(brandName) >> trash >> std::quoted(holder._productName) >> trash >> holder._price;
     if (stream)
     {
+     holder._namePrefix = GroceryItem::namePrefixOf( holder._productName );
+     holder._upcCode   = UpcCode( upcCode );
+     holder._brandName = GroceryItem::brandNameOf( std::move( brandName ) );
      groceryItem = std::move(holder);
     }
     return stream;
@@ -394,7 +498,7 @@ std::ostream & operator<<( std::ostream & stream, const GroceryItem & groceryIte
     /// Hint:  Brand and product names may have quotes, which need to escaped when printing.  Use std::quoted to read and write quoted strings.  See
     ///        1) https://en.cppreference.com/w/cpp/io/manip/quoted
     ///        2) https://www.youtube.com/watch?v=Mu-GUZuU31A
-  stream << std::quoted(groceryItem.upcCode()) << ", " << std::quoted(groceryItem.brandName()) << ", " << std::quoted(groceryItem.productName()) << ", " << groceryItem.price();
+  stream << std::quoted(groceryItem.upcCode()) << ", " << std::quoted(groceryItem.brandName()) << ", " << std::quoted(groceryItem.productName()) << ", " << groceryItem.exactPrice();          // as the price's double would print under the stream's flags and precision
    return stream;
   /////////////////////// END-TO-DO (22) ////////////////////////////
 }
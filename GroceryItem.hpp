@@ -1,48 +1,82 @@
 #pragma once                                                                  // include guard
 
 #include <compare>                                                            // std::weak_ordering
+#include <cstddef>                                                            // size_t
+#include <cstdint>                                                            // uint64_t
+#include <functional>                                                         // hash
 #include <iostream>
+#include <memory>                                                             // shared_ptr
+#include <memory_resource>                                                    // polymorphic_allocator, pmr::string
 #include <string>
+#include <string_view>
 
+#include "Money.hpp"
+#include "StringPool.hpp"
+#include "UpcCode.hpp"
 
 
 
+
+
+// Memory:  a brand name is held by shared pointer, so copies of a grocery item share one copy of it, and so do all the grocery items
+// a GroceryItemParser reads with the same brand (see StringPool).  UPC codes too long to pack are shared between copies the same
+// way (see UpcCode).  Either is freed along with the last grocery item holding it.  Nothing is interned process wide, so
+// constructing a grocery item or setting its brand name never takes a lock.
+//
+// The product name is a grocery item's own, and one too long to be stored inline is allocated from a memory resource.  Like the
+// std::pmr containers, a grocery item is allocator aware:  constructed with an allocator (as a std::pmr container or grocery list
+// storage constructs the grocery items it holds) its product name comes from that allocator's resource, otherwise from the default
+// resource (std::pmr::get_default_resource()).  The resource is fixed for the grocery item's lifetime - copies go to the default
+// resource unless given one, and assigning copies the product name into this grocery item's resource if it came from another.
 class GroceryItem
 {
   // Insertion and Extraction Operators
   friend std::ostream & operator<<( std::ostream & stream, GroceryItem const & groceryItem );
   friend std::istream & operator>>( std::istream & stream, GroceryItem       & groceryItem );
+  friend class GroceryItemParser;                                             // bulk extraction, parses straight into an existing grocery item's attributes
+  friend struct std::hash<GroceryItem>;                                       // hashes the compact attributes directly
+  friend class GroceryCatalog;                                                // copies the compact attributes into and out of its columns directly
 
   public:
     // Constructors, assignments, and destructor
-    GroceryItem( std::string productName = {},                                // Default and Conversion (from string to GroceryItem) constructor
-                 std::string brandName   = {},                                // String parameters intentionally passed by value.  Not perfect, but very very
-                 std::string upcCode     = {},                                // good when combined with move semantics.  See https://youtu.be/PNRju6_yn3o
-                 double      price       = 0.0 );
+    using allocator_type = std::pmr::polymorphic_allocator<>;                 // allocates the product name, see Memory above
+
+    GroceryItem( std::string_view productName = {},                           // Default and Conversion (from string to GroceryItem) constructor
+                 std::string      brandName   = {},                           // String parameters intentionally passed by value.  Not perfect, but very very
+                 std::string      upcCode     = {},                           // good when combined with move semantics.  See https://youtu.be/PNRju6_yn3o
+                 double           price       = 0.0 );                        // The product name is viewed instead, it's copied into its resource either way
 
     GroceryItem & operator=( GroceryItem const  & rhs   ) &;                  // Assignment operators available only for l-values (that's what the trailing "&" means), and then
-    GroceryItem & operator=( GroceryItem       && rhs   ) & noexcept;         // the 'Rule of 5' says if you define one, then you should define them all
+    GroceryItem & operator=( GroceryItem       && rhs   ) &;                  // the 'Rule of 5' says if you define one, then you should define them all
     GroceryItem            ( GroceryItem const  & other );                    // OK:  GroceryItem a{"title"},b;  b = a;  (a and b are both l-values, i.e. named objects)
     GroceryItem            ( GroceryItem       && other )   noexcept;         // Error:  GroceryItem{} = a;              (GroceryItem{} is an r-value, i.e., an unnamed temporary object)
    ~GroceryItem            (                            )   noexcept;
 
+    GroceryItem( GroceryItem const  & other, allocator_type const & allocator );      // Allocator extended copy and move constructors.  The move copies the product name if other's
+    GroceryItem( GroceryItem       && other, allocator_type const & allocator );      // came from another resource
+
 
     // Accessors
-    std::string const & upcCode    () const &;                                // Returns object's state by constant reference for l-value objects and by value for r-value objects
+    std::string         upcCode    () const &;                                // Returns object's state by constant reference for l-value objects and by value for r-value objects
+                                                                              // (except the UPC code, packed into a number and so always returned by value - at most 15
+                                                                              // characters, so without allocating)
     std::string const & brandName  () const &;                                // The "const &" at the end says these functions will be called for l-value objects and r-value objects
-    std::string const & productName() const &;                                // that (listen carefully) haven't been overloaded.
-    double              price      () const &;                                //
+    std::pmr::string const & productName() const &;                           // that (listen carefully) haven't been overloaded.
+    double              price      () const &;                                // Price in dollars, converted from the exact amount held
+    Money               exactPrice () const noexcept;                         // Price exactly, in mills.  Sum these, not price()s, for exact totals
+    allocator_type      get_allocator() const noexcept;                       // what the product name is allocated with
                                                                               //
     std::string         upcCode    ()       &&;                               // Overloads that return an r-value object's state by value (unsafe to return an r-value's state by reference)
     std::string         brandName  ()       &&;                               // The "&&" at the end says these functions will be called only for r-value objects
-    std::string         productName()       &&;                               // Search "lvalue vs rvalue", or see https://www.learncpp.com/cpp-tutorial/value-categories-lvalues-and-rvalues/,
+    std::pmr::string    productName()       &&;                               // Search "lvalue vs rvalue", or see https://www.learncpp.com/cpp-tutorial/value-categories-lvalues-and-rvalues/,
                                                                               // https://www.bing.com/videos/search?q=chono+c%2b%2b+lvalue+vs+rvalue&docid=608038928535204227&mid=6E0B93922619A11969BB6E0B93922619A11969BB&view=detail&FORM=VIRE
 
     // Modifiers                                                              // Updates object's state and returns a reference to self (enables chaining)
     GroceryItem & upcCode    ( std::string newUpcCode     ) &;                // String parameters intentionally passed by value
     GroceryItem & brandName  ( std::string newBrandName   ) &;                // Modifiers available for l-values only         (The & at the end says these functions will be called only for l-values)
-    GroceryItem & productName( std::string newProductName ) &;                // OK:     GroceryItem b; b.price(13.99);        (b is an l-value, i.e. a named object)
+    GroceryItem & productName( std::string_view newProductName ) &;           // OK:     GroceryItem b; b.price(13.99);        (b is an l-value, i.e. a named object)
     GroceryItem & price      ( double      newPrice       ) &;                // Error:  GroceryItem{}.price(13.99);           (The default constructed GrocerItem is an r-value, i.e., an unnamed temporary object)
+    GroceryItem & price      ( Money       newPrice       ) &;                // Prices in dollars are rounded to the nearest mill, Money is exact
 
 
     // Relational Operators
@@ -50,8 +84,27 @@ class GroceryItem
     bool               operator== ( GroceryItem const & rhs ) const noexcept;
 
   private:
-    std::string _upcCode;                                                     // a 12 or 14-digit international Universal Product Code uniquely identifying this item (Ex: 051600080015, 05017402006207)
-    std::string _brandName;                                                   // the product manufacturer's brand name (Ex: Heinz, Boston Market)
-    std::string _productName;                                                 // the name of the product (Ex: Heinz Tomato Ketchup - 2 Ct, Boston Market Spaghetti With Meatballs)
-    double      _price{ 0.0 };                                                // the cost of the item in US Dollars (Ex:  2.29, 1.19)
+    using BrandName = std::shared_ptr<HashedString const>;
+
+    UpcCode             _upcCode;                                             // a 12 or 14-digit international Universal Product Code uniquely identifying this item (Ex: 051600080015, 05017402006207)
+    BrandName           _brandName;                                           // the product manufacturer's brand name (Ex: Heinz, Boston Market), null if there isn't one.  Brands
+                                                                              // held at the same address are equal, and every brand is hashed, without looking at their text
+    std::pmr::string    _productName;                                         // the name of the product (Ex: Heinz Tomato Ketchup - 2 Ct, Boston Market Spaghetti With Meatballs)
+    Money               _price;                                               // the cost of the item in US Dollars (Ex:  2.29, 1.19), held exactly in mills
+    std::uint64_t       _namePrefix;                                          // the product name's first 8 characters, big endian and zero padded, so comparing these compares
+                                                                              // the names - unless they're equal, then the whole names must be compared.  See namePrefixOf()
+
+    static BrandName           brandNameOf ( std::string brandName            );            // null if brandName is empty
+    static std::string const & textOf      ( BrandName const & brandName      ) noexcept;   // the empty string if brandName is null
+    static std::uint64_t       namePrefixOf( std::string_view productName     ) noexcept;   // every assignment to _productName must update _namePrefix with this
+};
+
+
+
+// Hash support so grocery items can be used as keys in unordered containers and hash indexes (see GroceryListIndex).  Hashing must
+// agree with operator==, so grocery items that compare equal must produce the same hash value.
+template<>
+struct std::hash<GroceryItem>
+{
+  std::size_t operator()( GroceryItem const & groceryItem ) const noexcept;
 };
@@ -0,0 +1,264 @@
+#include <algorithm>                                                                  // count(), copy()
+#include <charconv>                                                                   // from_chars()
+#include <cstddef>                                                                    // size_t
+#include <cstdint>                                                                     // uint64_t
+#include <cstdlib>                                                                    // strtod()
+#include <cstring>                                                                     // memchr()
+#include <memory_resource>                                                            // pmr::string
+#include <string>
+#include <string_view>
+#include <system_error>                                                               // errc
+
+#include "GroceryItem.hpp"
+#include "GroceryItemParser.hpp"
+#include "Money.hpp"
+#include "StringPool.hpp"
+#include "UpcCode.hpp"
+
+
+
+
+/*******************************************************************************
+**  Implementation of non-member private types, objects, and functions
+*******************************************************************************/
+namespace    // unnamed, anonymous namespace
+{
+  // Same characters std::isspace() recognizes in the "C" locale, without the locale
+  constexpr bool isSpace( char c ) noexcept
+  {
+    return c == ' '  ||  ( c >= '\t'  &&  c <= '\r' );
+  }
+}    // unnamed, anonymous namespace
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Exceptions
+*******************************************************************************/
+
+// MalformedRecord_Ex
+GroceryItemParser::MalformedRecord_Ex::MalformedRecord_Ex( std::string const & reason, std::size_t lineNumber, std::size_t columnNumber )
+  : std::runtime_error( "Malformed grocery item at line " + std::to_string( lineNumber ) + ", column " + std::to_string( columnNumber ) + ":  " + reason ),
+    line  ( lineNumber   ),
+    column( columnNumber )
+{}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Constructors
+*******************************************************************************/
+
+GroceryItemParser::GroceryItemParser( std::string_view buffer ) noexcept
+  : _buffer( buffer )
+{}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// position() const
+std::size_t GroceryItemParser::position() const noexcept
+{
+  return _position;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// next()
+bool GroceryItemParser::next( GroceryItem & groceryItem )
+{
+  skipWhitespace();
+  if( _position == _buffer.size() ) return false;                                     // only whitespace left, no more records
+
+  // Same order and separators as GroceryItem's insertion operator writes
+  parseQuoted( _scratch                 );   groceryItem._upcCode    = UpcCode( _scratch );                                     expect( ',' );
+  parseQuoted( _scratch                 );   groceryItem._brandName  = internBrandName();                                      expect( ',' );
+  parseQuoted( groceryItem._productName );   groceryItem._namePrefix = GroceryItem::namePrefixOf( groceryItem._productName );  expect( ',' );
+  groceryItem._price = parsePrice();
+
+  return true;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Private member functions
+*******************************************************************************/
+
+// skipWhitespace()
+void GroceryItemParser::skipWhitespace() noexcept
+{
+  while( _position < _buffer.size()  &&  isSpace( _buffer[_position] ) )   ++_position;
+}
+
+
+
+// internBrandName()
+GroceryItem::BrandName GroceryItemParser::internBrandName()
+{
+  if( _scratch.empty() ) return nullptr;                                              // as GroceryItem holds no brand name
+  return _brandNames.intern( _scratch );
+}
+
+
+
+// expect()
+void GroceryItemParser::expect( char delimiter )
+{
+  skipWhitespace();
+  if( _position == _buffer.size()  ||  _buffer[_position] != delimiter )   fail( std::string( "expected '" ) + delimiter + '\'', _position );
+  ++_position;
+}
+
+
+
+// parseQuoted()
+void GroceryItemParser::parseQuoted( std::pmr::string & field )
+{
+  skipWhitespace();
+  if( _position == _buffer.size()  ||  _buffer[_position] != '"' )   fail( "expected an opening '\"'", _position );
+
+  auto const opening = _position++;
+  field.clear();                                                                      // keeps capacity
+
+  // Copy runs of ordinary characters a whole run at a time, stopping only at escapes and the closing quote.  This is the escape
+  // scheme std::quoted uses:  a backslash makes the next character, whatever it is, part of the string.
+  while( true )
+  {
+    // memchr() is about as fast as scanning gets (it's vectorized), so look for the closing quote first and then for an escape
+    // before it, rather than for either one character at a time
+    auto const run    = _buffer.data() + _position;
+    auto const quote  = static_cast<char const *>( std::memchr( run, '"', _buffer.size() - _position ) );
+    if( quote == nullptr )   fail( "missing closing '\"'", opening );
+
+    auto const escape = static_cast<char const *>( std::memchr( run, '\\', static_cast<std::size_t>( quote - run ) ) );
+    auto const stop   = static_cast<std::size_t>( ( escape != nullptr ? escape : quote ) - _buffer.data() );
+
+    field.append( _buffer, _position, stop - _position );
+    _position = stop + 1;
+
+    if( _buffer[stop] == '"' ) return;
+
+    if( _position == _buffer.size() )   fail( "missing closing '\"'", opening );
+    field += _buffer[_position++];
+  }
+}
+
+
+
+// parsePrice()
+Money GroceryItemParser::parsePrice()
+{
+  skipWhitespace();
+
+  auto const   start = _position;
+  char const * first = _buffer.data() + start;
+  char const * last  = _buffer.data() + _buffer.size();
+
+  // Fast path for what prices almost always look like:  a few digits, maybe a decimal point and at most three more digits.  The
+  // digits taken as an integer are then the price in mills once scaled by the missing decimals - exact, with no floating point at
+  // all.  Anything else (signs, exponents, long mantissas or fractions, inf, nan, garbage) takes the general path.
+  char const *  end         = first;
+  std::uint64_t mantissa    = 0;
+  std::size_t   digits      = 0;
+  std::size_t   fraction    = 0;                                                      // digits after the decimal point
+  bool          pastDecimal = false;
+  for( ; end < last; ++end )
+  {
+    if( *end >= '0'  &&  *end <= '9' )
+    {
+      mantissa = mantissa * 10 + static_cast<std::uint64_t>( *end - '0' );
+      ++digits;
+      if( pastDecimal ) ++fraction;
+    }
+    else if( *end == '.'  &&  !pastDecimal )   pastDecimal = true;
+    else                                       break;
+  }
+
+  if( digits > 0  &&  digits <= 15  &&  fraction <= 3  &&  ( end == last  ||  isSpace( *end ) ) )   // under 10^15, so even scaled by 1000 it fits
+  {
+    static constexpr std::uint64_t scale[] = { 1'000, 100, 10, 1 };
+    _position = static_cast<std::size_t>( end - _buffer.data() );
+    return Money::fromMills( static_cast<Money::Mills>( mantissa * scale[fraction] ) );
+  }
+
+
+  double price = 0.0;
+  #if defined( __cpp_lib_to_chars )
+    auto [generalEnd, error] = std::from_chars( first, last, price );
+    if( error != std::errc{} )   fail( "expected a price", start );
+  #else
+    // No floating point from_chars() in this library yet.  strtod() needs a null terminated string, which the buffer isn't, so
+    // copy out the price first.  No price needs anywhere near this many characters.
+    char        number[64] = {};
+    std::size_t length     = 0;
+    while( first + length < last  &&  length < sizeof( number ) - 1  &&  !isSpace( first[length] ) )   ++length;
+    std::copy( first, first + length, number );
+
+    char * numberEnd = nullptr;
+    price = std::strtod( number, &numberEnd );
+    if( numberEnd == number )   fail( "expected a price", start );
+    char const * generalEnd = first + ( numberEnd - number );
+  #endif
+
+  _position = static_cast<std::size_t>( generalEnd - _buffer.data() );
+
+  // The price ends the record, so anything other than whitespace (or the end of the buffer) means the price was mangled
+  if( _position < _buffer.size()  &&  !isSpace( _buffer[_position] ) )   fail( "unexpected character after price", _position );
+
+  try
+  {
+    return Money::fromDollars( price );                                               // rounded to the nearest mill
+  }
+  catch( Money::Overflow_Ex const & )
+  {
+    fail( "price out of range", start );
+  }
+}
+
+
+
+// fail() const
+void GroceryItemParser::fail( std::string const & reason, std::size_t at ) const
+{
+  // Only now work out the line and column.  Lines are counted by newlines, and columns are 1-based character offsets from the
+  // start of the line.
+  auto const text      = _buffer.substr( 0, at );
+  auto const line      = static_cast<std::size_t>( std::count( text.begin(), text.end(), '\n' ) ) + 1;
+  auto const lineStart = text.find_last_of( '\n' );
+  auto const column    = lineStart == std::string_view::npos ? at + 1 : at - lineStart;
+
+  throw MalformedRecord_Ex( reason, line, column );
+}
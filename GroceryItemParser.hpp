@@ -0,0 +1,73 @@
+#pragma once                                                                                  // include guard
+
+#include <cstddef>                                                                            // size_t
+#include <memory_resource>                                                                    // pmr::string
+#include <stdexcept>                                                                          // runtime_error
+#include <string>
+#include <string_view>
+
+#include "GroceryItem.hpp"
+#include "Money.hpp"
+#include "StringPool.hpp"
+
+
+// Reads grocery items, one after another, straight out of an in-memory buffer of text in the same format GroceryItem's insertion
+// operator writes:
+//
+//    "00034000020706", "York", "York \"Dark\" Peppermint Patties", 12.64
+//
+// that is, three double quoted strings (with \" and \\ escapes) and a price, separated by commas and optional whitespace.  Records
+// are separated by whitespace, usually a newline.
+//
+// This does the same job as GroceryItem's extraction operator but without the stream machinery - no sentries, no locales, no
+// temporary grocery item, no character-at-a-time virtual calls - and parses each record directly into the caller's grocery item
+// (the UPC code and brand name by way of a scratch string) so string capacity gets reused from one record to the next.  It's meant for bulk ingestion, for example:
+//
+//    GroceryItemParser parser( buffer );
+//    for( GroceryItem groceryItem;  parser.next( groceryItem ); )   groceryList.insert( groceryItem, GroceryList::Position::BOTTOM );
+//
+// The parser doesn't own the buffer, so the buffer must outlive the parser.  Grocery items read by one parser share each brand name
+// (see StringPool), held for as long as any of them is.
+class GroceryItemParser
+{
+  public:
+    // Exceptions
+    struct MalformedRecord_Ex : std::runtime_error                                            // Thrown when the text isn't a grocery item.  The message,
+    {                                                                                         // line, and column (both 1-based) say where and why.
+      MalformedRecord_Ex( std::string const & reason, std::size_t line, std::size_t column );
+
+      std::size_t line;
+      std::size_t column;
+    };
+
+
+    // Constructors
+    explicit GroceryItemParser( std::string_view buffer ) noexcept;
+
+
+    // Queries
+    std::size_t position() const noexcept;                                                    // offset into the buffer of the next character to be parsed
+
+
+    // Modifiers
+    bool next( GroceryItem & groceryItem );                                                   // parses the next record into groceryItem, returns false at end of input.  After a
+                                                                                              // MalformedRecord_Ex groceryItem holds a valid but unspecified value
+
+  private:
+    // Instance Attributes
+    std::string_view _buffer;                                                                 // the text being parsed
+    std::size_t      _position = 0;                                                           // offset into _buffer of the next character to be parsed
+    std::pmr::string _scratch;                                                                // the UPC code and brand name are parsed here, then packed and interned.  The
+                                                                                              // same type as a product name, which is parsed straight into its grocery item
+    StringPool       _brandNames;                                                             // so grocery items read by this parser share one copy of each brand name
+
+
+    // Helper member functions
+    void                   skipWhitespace (                                           ) noexcept;
+    GroceryItem::BrandName internBrandName(                                           );            // the brand name in _scratch, interned, or null if it's empty
+    void                   expect         ( char delimiter                            );
+    void                   parseQuoted    ( std::pmr::string & field                  );
+    Money                  parsePrice     (                                           );
+    [[noreturn]] void      fail           ( std::string const & reason, std::size_t at ) const;  // at is the offset into _buffer the problem was detected.  Line and column are
+                                                                                                 // worked out only then, so the happy path never counts newlines
+};
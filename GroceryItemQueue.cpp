@@ -0,0 +1,221 @@
+#include <algorithm>                                                                // for_each(), min()
+#include <atomic>
+#include <cstddef>                                                                  // ptrdiff_t, size_t
+#include <utility>                                                                  // move()
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "GroceryItemQueue.hpp"
+#include "GroceryList.hpp"
+#include "GroceryListStorage.hpp"
+
+
+
+
+/*******************************************************************************
+**  Constructors, assignments, and destructor
+*******************************************************************************/
+
+// Default constructor
+GroceryItemQueue::GroceryItemQueue()
+  : _tail( new Segment ), _head( _tail.load( std::memory_order_relaxed ) )
+{}
+
+
+
+// Destructor
+GroceryItemQueue::~GroceryItemQueue() noexcept
+{
+  for( auto segment : _retired )   delete segment;
+  for( auto segment : _grace   )   delete segment;
+
+  for( auto segment = _head; segment != nullptr; )
+  {
+    auto next = segment->next.load( std::memory_order_relaxed );
+    delete segment;
+    segment = next;
+  }
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// retired() const
+std::size_t GroceryItemQueue::retired() const noexcept
+{
+  return _retired.size() + _grace.size();
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// push()
+void GroceryItemQueue::push( GroceryItem groceryItem )
+{
+  // Counted for the whole push, under the epoch it entered in, so the consumer knows whether a producer might still be looking at a
+  // segment it has retired.  The count must change before _tail is read - sequentially consistent, both here and in reclaim().  A
+  // count that raced the consumer starting a new epoch is moved to the new one:  counted under an epoch whose grace period already
+  // ended, it would be missed by the next one.
+  struct Pushing
+  {
+    std::atomic<std::size_t> * count = nullptr;
+
+    Pushing( std::atomic<std::size_t> ( & pushing )[2], std::atomic<std::size_t> const & epoch ) noexcept
+    {
+      for( auto entered = epoch.load();  ;  entered = epoch.load() )
+      {
+        count = &pushing[entered & 1];
+        count->fetch_add( 1 );
+        if( epoch.load() == entered )   return;
+        count->fetch_sub( 1 );
+      }
+    }
+   ~Pushing() { count->fetch_sub( 1 ); }
+    Pushing( Pushing const & ) = delete;
+    Pushing & operator=( Pushing const & ) = delete;
+  } const pushing( _pushing, _epoch );
+
+  for( auto segment = _tail.load();  ;  )
+  {
+    // The common case:  claim a slot in the last segment and fill it in
+    if( auto const slot = segment->claimed.fetch_add( 1, std::memory_order_relaxed );  slot < SEGMENT_SIZE )
+    {
+      segment->slots[slot].groceryItem.emplace( std::move( groceryItem ) );
+      segment->slots[slot].ready.store( true, std::memory_order_release );
+      return;
+    }
+
+    // The segment is full.  Add the next one unless another producer already has, then help move _tail along to it.  Whoever
+    // loses the race to link theirs frees it again.
+    auto next = segment->next.load( std::memory_order_acquire );
+    if( next == nullptr )
+    {
+      auto fresh = new Segment;
+      if( segment->next.compare_exchange_strong( next, fresh, std::memory_order_acq_rel ) )   next = fresh;
+      else                                                                                  delete fresh;
+    }
+
+    _tail.compare_exchange_strong( segment, next );                                        // on failure, segment is the tail another producer moved to
+    segment = _tail.load();
+  }
+}
+
+
+
+// drainInto()
+template<typename StoragePolicy>
+std::size_t GroceryItemQueue::drainInto( BasicGroceryList<StoragePolicy> & groceryList, std::size_t limit )
+{
+  // The batch stays in _pending until the grocery list has it, so it's copied in rather than moved.  If insert() throws, the batch
+  // is still there, first in line for the next drainInto().
+  if( _pending.size() < limit )   take( limit - _pending.size() );
+
+  auto const batchSize = std::min( limit, _pending.size() );
+  auto const batchEnd  = _pending.cbegin() + static_cast<std::ptrdiff_t>( batchSize );
+
+  groceryList.insert( _pending.cbegin(), batchEnd, groceryList.size() );
+  _pending.erase( _pending.cbegin(), batchEnd );
+  return batchSize;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Private member functions
+*******************************************************************************/
+
+// take()
+void GroceryItemQueue::take( std::size_t limit )
+{
+  for( std::size_t taken = 0; taken < limit; )
+  {
+    if( _headSlot == SEGMENT_SIZE )
+    {
+      auto const next = _head->next.load( std::memory_order_acquire );
+      if( next == nullptr ) break;                                                  // drained everything pushed so far
+
+      _retired.push_back( _head );
+      _head     = next;
+      _headSlot = 0;
+      continue;
+    }
+
+    auto & slot = _head->slots[_headSlot];
+    if( !slot.ready.load( std::memory_order_acquire ) ) break;                     // not pushed yet, or still being filled in
+
+    _pending.push_back( std::move( *slot.groceryItem ) );
+    slot.groceryItem.reset();
+    ++_headSlot;
+    ++taken;
+  }
+
+  if( !_retired.empty()  ||  !_grace.empty() )   reclaim();
+}
+
+
+
+// reclaim()
+void GroceryItemQueue::reclaim()
+{
+  // A producer reaches segments only through _tail, and _tail only moves forward.  So once _tail has moved past a retired segment,
+  // only a producer already part way through a push() can reach it.  Only the last segment retired can still be the tail.
+  //
+  // A grace period starts by reading _tail, then advancing the epoch.  Producers counted in the old epoch's parity when its count is
+  // then seen to be zero have all left push().  Any producer counted there later changed the count after that, so its read of _tail
+  // came after the one here, sees the new epoch, and moves its count there before reading _tail.  Producers entering in the new
+  // epoch read _tail later still.
+  if( _grace.empty()  &&  !_retired.empty() )
+  {
+    auto const tail     = _tail.load();
+    auto const keepLast = _retired.back() == tail;
+    _grace.assign( _retired.begin(), _retired.end() - ( keepLast ? 1 : 0 ) );
+    _retired.erase( _retired.begin(), _retired.end() - ( keepLast ? 1 : 0 ) );
+    if( !_grace.empty() )   _epoch.fetch_add( 1 );
+  }
+
+  // Often no producer was counted in the old epoch at all, and the grace period is over as soon as it starts
+  if( !_grace.empty()  &&  _pushing[( _epoch.load() - 1 ) & 1].load() == 0 )
+  {
+    std::for_each( _grace.begin(), _grace.end(), []( Segment * segment ) { delete segment; } );
+    _grace.clear();
+  }
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Explicit instantiations
+*******************************************************************************/
+
+template std::size_t GroceryItemQueue::drainInto( BasicGroceryList<SmallVectorStorage<>> &, std::size_t );
+template std::size_t GroceryItemQueue::drainInto( BasicGroceryList<VectorStorage       > &, std::size_t );
+template std::size_t GroceryItemQueue::drainInto( BasicGroceryList<ListStorage         > &, std::size_t );
+template std::size_t GroceryItemQueue::drainInto( BasicGroceryList<TreeStorage         > &, std::size_t );
+template std::size_t GroceryItemQueue::drainInto( BasicGroceryList<PersistentStorage   > &, std::size_t );
+template std::size_t GroceryItemQueue::drainInto( BasicGroceryList<ShadowStorage<>     > &, std::size_t );
@@ -0,0 +1,89 @@
+#pragma once                                                                                  // include guard
+
+#include <atomic>
+#include <cstddef>                                                                            // size_t
+#include <limits>                                                                             // numeric_limits
+#include <optional>
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "GroceryList.hpp"
+
+
+// An unbounded queue of grocery items on their way into a grocery list, for many producer threads and one consumer thread.
+// Producers push() without taking a lock:  each claims the next slot with one atomic increment and fills it in, so producers only
+// ever contend on that counter.  The consumer drains the queue in batches into a grocery list, in arrival order (the order slots
+// were claimed), with duplicates skipped just as inserting them one at a time at the bottom would.  For example:
+//
+//    GroceryItemQueue queue;
+//    // producers, on any thread               // the consumer, on one thread
+//    queue.push( groceryItem );                queue.drainInto( groceryList );
+//
+// Slots come in fixed size segments linked into a list.  The producer that finds the last segment full adds the next one, and the
+// consumer retires a segment once it has drained it.  A producer part way through a push() may still be looking at a retired
+// segment, so retired segments are freed a grace period later:  the consumer starts a new epoch, and once every producer that
+// entered push() in the old epoch has left it, nothing can reach them.  Producers entering in the new epoch are counted apart, so
+// a steady stream of pushes never holds a grace period open, and at most the segments retired during one grace period wait.  A
+// grace period still lasts as long as the slowest push() it waits for, so a producer descheduled part way through one delays
+// freeing until it runs again.
+//
+// A batch the grocery list refuses (its insert() throws) isn't lost.  The consumer holds on to it and drains it first next time,
+// and any of its grocery items that did make it into the grocery list are then skipped as duplicates.
+class GroceryItemQueue
+{
+  public:
+    static constexpr std::size_t SEGMENT_SIZE = 512;                                          // slots per segment
+
+
+    // Constructors, assignments, and destructor
+    GroceryItemQueue();
+
+    GroceryItemQueue            ( GroceryItemQueue const & ) = delete;                        // shared by address, so neither copied nor moved
+    GroceryItemQueue & operator=( GroceryItemQueue const & ) = delete;
+   ~GroceryItemQueue            (                          ) noexcept;                        // no thread may be using the queue
+
+
+    // Queries
+    std::size_t retired() const noexcept;                                                     // the consumer thread only.  Drained segments not yet freed
+
+
+    // Modifiers
+    void push( GroceryItem groceryItem );                                                     // any thread.  Never waits for another thread
+
+    template<typename StoragePolicy>                                                          // the consumer thread only.  Appends up to limit of the grocery items pushed so far to
+    std::size_t drainInto( BasicGroceryList<StoragePolicy> & groceryList,                     // the bottom of groceryList, in arrival order, and returns how many were taken from the
+                           std::size_t limit = std::numeric_limits<std::size_t>::max() );     // queue.  Stops early at a slot still being filled, so nothing arrives out of order.  If
+                                                                                              // groceryList throws, the batch is kept for the next drainInto()
+
+
+  private:
+    struct Slot
+    {
+      std::optional<GroceryItem> groceryItem;
+      std::atomic<bool>          ready = false;                                               // set once groceryItem is filled in
+    };
+
+    struct Segment
+    {
+      std::atomic<std::size_t> claimed = 0;                                                   // slots handed out so far.  Runs past SEGMENT_SIZE once the segment is full
+      std::atomic<Segment *>   next    = nullptr;
+      Slot                     slots[SEGMENT_SIZE];
+    };
+
+
+    // Instance Attributes
+    alignas( 64 ) std::atomic<Segment *>   _tail;                                             // where producers claim slots
+    alignas( 64 ) std::atomic<std::size_t> _epoch = 0;                                        // advanced by the consumer to start a grace period
+    std::atomic<std::size_t>               _pushing[2] = {};                                  // producers part way through a push(), by the parity of the epoch they entered in
+
+    alignas( 64 ) Segment *                _head;                                             // the consumer's side:  the segment and slot drained next
+    std::size_t                            _headSlot = 0;
+    std::vector<Segment *>                 _retired;                                          // drained segments waiting for the next grace period
+    std::vector<Segment *>                 _grace;                                            // drained segments waiting for the current grace period to end
+    std::vector<GroceryItem>               _pending;                                          // taken from the slots, but not yet in a grocery list, in arrival order
+
+
+    // Helper member functions
+    void                     take   ( std::size_t limit );                                    // moves up to limit more ready grocery items to _pending, in arrival order
+    void                     reclaim();                                                       // ends and starts grace periods, freeing segments no producer can still reach
+};
@@ -1,29 +1,84 @@
-#include <algorithm>                                                                // find(), shift_left(), shift_right(), equal(), swap(), lexicographical_compare()
-#include <cmath>                                                                    // min()
-#include <cstddef>                                                                  // size_t
+#include <algorithm>                                                                // find(), equal(), lexicographical_compare_three_way(), clamp(), sort(), binary_search(), lower_bound(), partition_point()
+#include <cerrno>                                                                   // errno
+#include <cstddef>                                                                  // size_t, ptrdiff_t
+#include <exception>                                                                // exception_ptr, current_exception(), rethrow_exception()
+#include <filesystem>                                                               // path
+#include <fstream>                                                                  // ofstream
+#include <functional>                                                               // hash, greater
 #include <initializer_list>
 #include <iomanip>                                                                  // setw()
-#include <iterator>                                                                 // distance(), next()
+#include <iterator>                                                                 // distance(), prev(), random_access_iterator
+#include <limits>                                                                   // numeric_limits
+#include <memory_resource>                                                          // memory_resource, polymorphic_allocator
+#include <mutex>                                                                    // mutex, lock_guard
+#include <optional>
+#include <span>
 #include <stdexcept>                                                                // logic_error
 #include <string>
-#include <utility>                                                                  // move()
-
+#include <string_view>
+#include <system_error>                                                             // system_error, generic_category()
+#include <thread>                                                                   // jthread, hardware_concurrency()
+#include <type_traits>                                                              // is_integral_v, remove_cvref_t
+#include <utility>                                                                  // move(), pair
+#include <vector>
+
+#include "ExceptionLocation.hpp"
 #include "GroceryItem.hpp"
+#include "GroceryItemParser.hpp"
 #include "GroceryList.hpp"
+#include "GroceryListImage.hpp"
+#include "GroceryListIndex.hpp"
+#include "GroceryListOrderedIndex.hpp"
+#include "GroceryListPatch.hpp"
+#include "GroceryListSearchIndex.hpp"
+#include "GroceryListStorage.hpp"
+#include "MappedFile.hpp"
+#include "Money.hpp"
 
 
 
-// As a rule, I strongly recommend avoiding macros, unless there is a compelling reason - this is such a case. This really does need
-// to be a macro and not a function due to the way the preprocessor expands the source code location information.  It's important to
-// have these expanded where they are used, and not here. But I just can't bring myself to writing this, and getting it correct,
-// everywhere it is used.  Note:  C++20 will change this technique with the introduction of the std::source_location class. Also note the
-// usage of having the preprocessor concatenate two string literals separated only by whitespace.  :(  In the meantime ...
-//
-// Update:  As of August 2023 and clang 16, still no support for source_location. Rummer has it that they may never implement it.
-// Yay Microsoft and GCC!
-#define exception_location "\n detected in function \"" + std::string(__func__) +  "\""    \
-                           "\n at line " + std::to_string( __LINE__ ) +                    \
-                           "\n in file \"" __FILE__ "\""
+namespace    // unnamed, anonymous namespace
+{
+  // Calls task( 0 ) through task( tasks - 1 ), each on its own thread (task 0 on the calling thread), and waits for them all.  The
+  // first exception thrown by a task, if any, is rethrown here once every task is done.
+  template<typename Task>
+  void runInParallel( std::size_t tasks, Task const & task )
+  {
+    std::exception_ptr failure;
+    std::mutex         failureLock;
+    auto guarded = [&]( std::size_t id ) noexcept
+    {
+      try
+      {
+        task( id );
+      }
+      catch( ... )
+      {
+        std::lock_guard lock( failureLock );
+        if( !failure )   failure = std::current_exception();
+      }
+    };
+
+    {
+      std::vector<std::jthread> workers;
+      workers.reserve( tasks );
+      try
+      {
+        for( std::size_t id = 1; id < tasks; ++id )   workers.emplace_back( guarded, id );
+      }
+      catch( ... )
+      {
+        // Couldn't start them all.  The ones that did start still have to be waited for (the jthreads do that), and their
+        // unfinished work is why this has to throw too.
+        std::lock_guard lock( failureLock );
+        if( !failure )   failure = std::current_exception();
+      }
+      guarded( 0 );
+    }                                                                               // jthreads join here
+
+    if( failure )   std::rethrow_exception( failure );
+  }
+}    // unnamed, anonymous namespace
 
 
 
@@ -42,12 +97,169 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // Initializer List Constructor
-GroceryList::GroceryList( const std::initializer_list<GroceryItem> & initList )
+template<typename StoragePolicy>
+BasicGroceryList<StoragePolicy>::BasicGroceryList( const std::initializer_list<GroceryItem> & initList )
 {
-  for( auto && groceryItem : initList )   insert( groceryItem, Position::BOTTOM );
+  insert( initList.begin(), initList.end(), 0 );
+
+  // Verify the internal grocery list state is still consistent amongst the containers
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
+}
+
+
+
+// Memory Resource Constructor
+template<typename StoragePolicy>
+BasicGroceryList<StoragePolicy>::BasicGroceryList( std::pmr::memory_resource * resource ) requires AllocatorAwareStorage<StoragePolicy>
+  : _storage( resource )
+{}
+
+
+
+// loadFile()
+template<typename StoragePolicy>
+BasicGroceryList<StoragePolicy> BasicGroceryList<StoragePolicy>::loadFile( std::filesystem::path const & path )
+{
+  MappedFile        file  ( path            );
+  GroceryItemParser parser( file.contents() );
+
+  // Parse each record directly into its place at the end of the batch, so the only copy of a grocery item's text is the one from
+  // the file into the grocery item itself.  There's always one spare grocery item at the end of the batch to parse into.
+  //
+  // Duplicates are weeded out as we go, by hash index over the batch so far, and simply parsed over by the next record.  That way
+  // nothing has to be squeezed out of the batch afterwards, and the batch can go straight into the containers.  The index refers to
+  // grocery items by offset, which unlike a pointer survives the batch growing.
+  std::vector<GroceryItem> batch( 1 );
+  GroceryListIndex         seen;
+  auto batchAt = [&batch]( std::size_t candidate ) -> GroceryItem const & { return batch[candidate]; };
+
+  batch.reserve( file.contents().size() / 64 + 1 );                                 // a guess, records are typically somewhat longer than this
+  seen .reserve( batch.capacity()                );
+
+  while( parser.next( batch.back() ) )
+  {
+    auto const hash = std::hash<GroceryItem>{}( batch.back() );
+    if( seen.find( batch.back(), hash, batchAt ) != GroceryListIndex::npos ) continue;
+
+    seen.insertAt( hash, batch.size() - 1 );
+    batch.emplace_back();
+  }
+  batch.pop_back();
+  seen .clear();
+
+  // Then build the containers, all in one go
+  BasicGroceryList groceryList;
+  groceryList.insertUnique( std::move( batch ), 0 );
+  return groceryList;
+}
+
+
+
+// loadImage()
+template<typename StoragePolicy>
+BasicGroceryList<StoragePolicy> BasicGroceryList<StoragePolicy>::loadImage( std::filesystem::path const & path )
+{
+  MappedFile       file ( path            );
+  GroceryListImage image( file.contents() );
+
+  // The image is viewed in place, so the only copy of a grocery item's text is the one from the file into the grocery item itself.
+  // An image written by saveImage() has no duplicates, but one from elsewhere might, so they're weeded out like any other batch.
+  std::vector<GroceryItem> batch;
+  batch.reserve( image.size() );
+  for( std::size_t i = 0; i < image.size(); ++i )
+  {
+    auto const item = image[i];
+    batch.emplace_back( item.productName, std::string( item.brandName ), std::string( item.upcCode ) ).price( item.price );
+  }
+
+  BasicGroceryList groceryList;
+  groceryList.insertBatch( std::move( batch ), 0 );
+  return groceryList;
+}
+
+
+
+// unionOf()
+template<typename StoragePolicy>
+BasicGroceryList<StoragePolicy> BasicGroceryList<StoragePolicy>::unionOf( std::span<BasicGroceryList const> lists, unsigned threads )
+{
+  // Lay every list's grocery items end to end, by address, in the order they're to be considered
+  std::vector<GroceryItem const *> items;
+  {
+    std::size_t count = 0;
+    for( auto const & groceryList : lists )   count += groceryList.size();
+    items.reserve( count );
+    for( auto const & groceryList : lists )   for( auto const & groceryItem : groceryList._storage )   items.push_back( &groceryItem );
+  }
+
+  // Split the work only as far as it's worth a thread.  Each worker takes one chunk of the items (a contiguous run, for hashing
+  // and for copying out) and one shard of the hash values (for weeding out duplicates).
+  constexpr std::size_t minimumPerWorker = 16'384;
+  if( threads == 0 )   threads = std::thread::hardware_concurrency();
+  std::size_t const workers = std::clamp<std::size_t>( items.size() / minimumPerWorker, 1, std::max( threads, 1U ) );
+
+  auto chunkStart = [&]( std::size_t chunk ) { return items.size() * chunk / workers; };
+  auto shardOf    = [&]( std::size_t hash  )                                           // the index probes with the low bits, so shard by the high half
+  {
+    return ( hash >> std::numeric_limits<std::size_t>::digits / 2 ) % workers;
+  };
+
+  std::vector<std::size_t>                            hashes( items.size() );
+  std::vector<unsigned char>                          keep  ( items.size() );            // not vector<bool>, whose elements can't be written from different threads
+  std::vector<std::vector<std::vector<std::size_t>>>  byShard( workers, std::vector<std::vector<std::size_t>>( workers ) );   // [chunk][shard] -> item numbers, in order
+  std::vector<std::size_t>                            kept  ( workers + 1 );              // [chunk] -> grocery items kept, then where the chunk's go in the batch
+
+
+  // Hash each chunk, sorting its item numbers by shard
+  runInParallel( workers, [&]( std::size_t chunk )
+  {
+    for( auto i = chunkStart( chunk );  i < chunkStart( chunk + 1 );  ++i )
+    {
+      hashes[i] = std::hash<GroceryItem>{}( *items[i] );
+      byShard[chunk][shardOf( hashes[i] )].push_back( i );
+    }
+  } );
+
+  // Equal grocery items hash alike so land in the same shard, and each shard is walked in item order, chunk by chunk, so the first
+  // occurrence of each grocery item is the one seen first.  Shards are independent, so they're weeded in parallel.
+  runInParallel( workers, [&]( std::size_t shard )
+  {
+    std::vector<std::size_t> members;                                               // item numbers kept in this shard, in order
+    GroceryListIndex         seen;
+    auto memberAt = [&]( std::size_t candidate ) -> GroceryItem const & { return *items[members[candidate]]; };
+
+    for( auto const & chunk : byShard )
+    {
+      for( auto const i : chunk[shard] )
+      {
+        if( seen.find( *items[i], hashes[i], memberAt ) != GroceryListIndex::npos ) continue;
+
+        seen.insertAt( hashes[i], members.size() );
+        members.push_back( i );
+        keep[i] = 1;
+      }
+    }
+  } );
+
+  // Each chunk's kept grocery items go into the batch right after the previous chunk's
+  runInParallel( workers, [&]( std::size_t chunk )
+  {
+    for( auto i = chunkStart( chunk );  i < chunkStart( chunk + 1 );  ++i )   kept[chunk + 1] += keep[i];
+  } );
+  for( std::size_t chunk = 1; chunk <= workers; ++chunk )   kept[chunk] += kept[chunk - 1];
+
+  std::vector<GroceryItem> batch( kept[workers] );
+  runInParallel( workers, [&]( std::size_t chunk )
+  {
+    auto next = kept[chunk];
+    for( auto i = chunkStart( chunk );  i < chunkStart( chunk + 1 );  ++i )   if( keep[i] )   batch[next++] = *items[i];
+  } );
 
-  // Verify the internal grocery list state is still consistent amongst the four containers
-  if( !containersAreConsistant() )   throw GroceryList::InvalidInternalState_Ex( "Container consistency error" exception_location );
+
+  // Then build the containers, all in one go
+  BasicGroceryList groceryList;
+  groceryList.insertUnique( std::move( batch ), 0 );
+  return groceryList;
 }
 
 
@@ -67,20 +279,189 @@ GroceryList::GroceryList( const std::initializer_list<GroceryItem> & initList )
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // size() const
-std::size_t GroceryList::size() const
+template<typename StoragePolicy>
+std::size_t BasicGroceryList<StoragePolicy>::size() const
 {
-  // Verify the internal grocery list state is still consistent amongst the four containers
-  if( !containersAreConsistant() )   throw GroceryList::InvalidInternalState_Ex( "Container consistency error" exception_location );
+  // Verify the internal grocery list state is still consistent amongst the containers
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
 
   ///////////////////////// TO-DO (1) //////////////////////////////
     /// All the containers are the same size, so pick one and return the size of that.  Since the forward_list has to calculate the
     /// size on demand, stay away from using that one.
-  return _gList_vector.size();
+  return _storage.size();
   /////////////////////// END-TO-DO (1) ////////////////////////////
 }
 
 
 
+// indexed() const
+template<typename StoragePolicy>
+bool BasicGroceryList<StoragePolicy>::indexed() const noexcept
+{
+  return LocatingStorage<StoragePolicy>  ||  _index.has_value();
+}
+
+
+
+
+// ordered() const
+template<typename StoragePolicy>
+bool BasicGroceryList<StoragePolicy>::ordered() const noexcept
+{
+  return _ordered.has_value();
+}
+
+
+
+// searchable() const
+template<typename StoragePolicy>
+bool BasicGroceryList<StoragePolicy>::searchable() const noexcept
+{
+  return _search.has_value();
+}
+
+
+
+// hash() const
+template<typename StoragePolicy>
+std::size_t BasicGroceryList<StoragePolicy>::hash() const noexcept
+{
+  return _contentHash.value ^ itemHash( _storage.size() );                           // the count too, so lists of nothing but zero sums still differ
+}
+
+
+
+// saveImage() const
+template<typename StoragePolicy>
+void BasicGroceryList<StoragePolicy>::saveImage( std::filesystem::path const & path ) const
+{
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
+
+  GroceryListImage::Builder builder( _storage.size() );
+  for( auto const & groceryItem : _storage )   builder.add( groceryItem );
+  auto const image = std::move( builder ).finish();
+
+  std::ofstream file( path, std::ios::binary | std::ios::trunc );
+  if( !file )   throw std::system_error( errno, std::generic_category(), "Unable to create \"" + path.string() + "\"" exception_location );
+
+  file.write( image.data(), static_cast<std::streamsize>( image.size() ) );
+  file.close();
+  if( !file )   throw std::system_error( errno, std::generic_category(), "Unable to write \"" + path.string() + "\"" exception_location );
+}
+
+
+
+// total() const
+template<typename StoragePolicy>
+Money BasicGroceryList<StoragePolicy>::total() const
+{
+  return Money::sum( _storage, []( GroceryItem const & groceryItem ) noexcept { return groceryItem.exactPrice(); } );
+}
+
+
+
+// diff()
+template<typename StoragePolicy>
+GroceryListPatch BasicGroceryList<StoragePolicy>::diff( BasicGroceryList const & from, BasicGroceryList const & to )
+{
+  using Edit      = GroceryListPatch::Edit;
+  using Operation = GroceryListPatch::Operation;
+  constexpr auto npos = GroceryListIndex::npos;
+
+  // Index from's grocery items by address, appending so the index never renumbers, then look up each of to's grocery items in it.
+  // Neither list has duplicates, so each grocery item is in each list at most once.
+  std::vector<GroceryItem const *> fromItems;
+  GroceryListIndex                 fromIndex;
+  fromItems.reserve( from.size() );
+  fromIndex.reserve( from.size() );
+  for( auto const & groceryItem : from._storage )
+  {
+    fromIndex.insertAt( std::hash<GroceryItem>{}( groceryItem ), fromItems.size() );
+    fromItems.push_back( &groceryItem );
+  }
+  auto fromAt = [&]( std::size_t offset ) -> GroceryItem const & { return *fromItems[offset]; };
+
+  std::vector<GroceryItem const *> toItems;                                       // to's grocery items, in order
+  std::vector<std::size_t>         common;                                        // offsets into toItems of those also in from, in order
+  std::vector<std::size_t>         position;                                      // [common] -> that grocery item's offset in from
+  std::vector<unsigned char>       removed( from.size(), 1 );                     // [offset in from] -> 1 if the grocery item there is to be removed
+  toItems.reserve( to.size() );
+  for( auto const & groceryItem : to._storage )
+  {
+    if( auto const offset = fromIndex.find( groceryItem, std::hash<GroceryItem>{}( groceryItem ), fromAt );  offset != npos )
+    {
+      common  .push_back( toItems.size() );
+      position.push_back( offset );
+      removed[offset] = 0;
+    }
+    toItems.push_back( &groceryItem );
+  }
+
+  // The grocery items in both lists are put in to's order two ways.  The first top of them (in to's order) are moved to the top
+  // one at a time, bottom most first, leaving the rest after them in their original order.  Of the rest, those in a longest
+  // increasing run of from offsets (their longest common subsequence, which is just that when neither list has duplicates) stay
+  // put, and the others are removed and inserted again where they belong.  A move is one edit, a removal and
+  // insertion two, so pick the split costing the fewest edits.  Reading the offsets backwards, the longest increasing runs of every
+  // suffix come from one patience sort.
+  auto const               count = common.size();
+  std::vector<std::size_t> runOf( count + 1, 0 );                                 // [start] -> longest increasing run in position[start, count)
+  {
+    std::vector<std::size_t> heads;                                               // [length - 1] -> greatest head of a run that long so far, decreasing
+    for( auto i = count;  i-- > 0;  )
+    {
+      auto const slot = std::lower_bound( heads.begin(), heads.end(), position[i], std::greater<>{} );
+      if( slot == heads.end() )   heads.push_back( position[i] );
+      else                        *slot = position[i];
+      runOf[i] = heads.size();
+    }
+  }
+
+  std::size_t top = 0;
+  auto edits = [&]( std::size_t moved ) { return moved + 2 * ( count - moved - runOf[moved] ); };
+  for( std::size_t moved = 1;  moved <= count;  ++moved )   if( edits( moved ) < edits( top ) ) top = moved;
+
+  // Find one longest increasing run of what isn't moved, patience sorting forwards this time to trace it back.  Whatever isn't on it
+  // is removed.
+  std::vector<unsigned char> present( toItems.size(), 0 );                       // [offset in to] -> 1 if it's there once the removals and moves are done
+  for( std::size_t i = 0;  i < top;  ++i )   present[common[i]] = 1;
+  {
+    std::vector<std::size_t> tails;                                               // [length - 1] -> index into common ending the best run that long so far
+    std::vector<std::size_t> previous( count, npos );
+    for( auto i = top;  i < count;  ++i )
+    {
+      auto const slot = std::partition_point( tails.begin(), tails.end(), [&]( std::size_t tail ) { return position[tail] < position[i]; } );
+      if( slot != tails.begin() )   previous[i] = *std::prev( slot );
+      if( slot == tails.end() )     tails.push_back( i );
+      else                          *slot = i;
+    }
+
+    for( std::size_t i = count;  i-- > top;  )   removed[position[i]] = 1;
+    for( auto i = tails.empty() ? npos : tails.back();  i != npos;  i = previous[i] )
+    {
+      removed[position[i]] = 0;
+      present[common[i]]   = 1;
+    }
+  }
+
+  // Removals bottom up so the offsets still to come don't shift, then the moves, then insertions top down into what's left, which
+  // is by then a subsequence of to
+  std::vector<Edit> script;
+  for( auto offset = from.size();  offset-- > 0;  )   if( removed[offset] ) script.push_back( Edit{ Operation::REMOVE, offset, fromAt( offset ) } );
+  for( auto i = top;  i-- > 0;  )                     script.push_back( Edit{ Operation::MOVE_TO_TOP, 0, *toItems[common[i]] } );
+  for( std::size_t offset = 0;  offset < toItems.size();  ++offset )
+  {
+    if( !present[offset] )   script.push_back( Edit{ Operation::INSERT, offset, *toItems[offset] } );
+  }
+
+  auto hashOf = []( BasicGroceryList const & groceryList )
+  {
+    return groceryList._orderedHash.value ? *groceryList._orderedHash.value : groceryList.orderedHash();
+  };
+  return GroceryListPatch( from.size(), hashOf( from ), hashOf( to ), std::move( script ) );
+}
+
+
+
 
 
 
@@ -96,24 +477,123 @@ std::size_t GroceryList::size() const
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // find() const
-std::size_t GroceryList::find( const GroceryItem & groceryItem ) const
+template<typename StoragePolicy>
+std::size_t BasicGroceryList<StoragePolicy>::find( const GroceryItem & groceryItem ) const
 {
-  // Verify the internal grocery list state is still consistent amongst the four containers
-  if( !containersAreConsistant() )   throw GroceryList::InvalidInternalState_Ex( "Container consistency error" exception_location );
+  // Verify the internal grocery list state is still consistent amongst the containers
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
 
   ///////////////////////// TO-DO (2) //////////////////////////////
     /// Locate the grocery item in this grocery list and return the zero-based position of that grocery item.  If the grocery item
     /// does not exist, return the size of this grocery list as an indicator the grocery item does not exist.  The grocery item will
     /// be in the same position in all the containers (array, vector, list, and forward_list) so pick just one of those to search.
     /// The STL provides the find() function that is a perfect fit here, but you may also write your own loop.
-  auto what_we_need_to_find = std::find(_gList_vector.begin(), _gList_vector.end(), groceryItem);
-  const std::size_t index_of_found = std::distance(_gList_vector.begin(), what_we_need_to_find);
+  if constexpr( LocatingStorage<StoragePolicy> )   return _storage.offsetOf( groceryItem );      // the storage policy knows where its grocery items are
+
+  if( _index )
+  {
+    // O(1) expected.  Candidate offsets found in the index are confirmed against the storage, so hash collisions are harmless.
+    auto const offset = _index->find( groceryItem, std::hash<GroceryItem>{}( groceryItem ),
+                                      [this]( std::size_t candidate ) -> GroceryItem const & { return _storage.at( candidate ); } );
+    return offset == GroceryListIndex::npos ? _storage.size() : offset;
+  }
+
+  if constexpr( ScreeningStorage<StoragePolicy> )                                   // the storage policy turns away what it doesn't hold without a search
+  {
+    if( !_storage.contains( groceryItem ) )   return _storage.size();
+  }
+
+  auto what_we_need_to_find = std::find(_storage.begin(), _storage.end(), groceryItem);
+  const std::size_t index_of_found = std::distance(_storage.begin(), what_we_need_to_find);
   return index_of_found;
   /////////////////////// END-TO-DO (2) ////////////////////////////
 }
 
 
 
+// priceRange() const
+template<typename StoragePolicy>
+typename BasicGroceryList<StoragePolicy>::Items BasicGroceryList<StoragePolicy>::priceRange( Money low, Money high ) const
+{
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
+  if( high < low ) return {};
+
+  // Without the sorted indexes, build them just for this query
+  std::optional<OrderedIndexes> temporary;
+  auto const & byPrice = ( _ordered ? *_ordered : temporary.emplace( orderedIndexes() ) ).byPrice;
+  return itemsAt( byPrice.lowerBound( low ), byPrice.upperBound( high ) );
+}
+
+
+
+// cheapest() const
+template<typename StoragePolicy>
+typename BasicGroceryList<StoragePolicy>::Items BasicGroceryList<StoragePolicy>::cheapest( std::size_t count ) const
+{
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
+
+  std::optional<OrderedIndexes> temporary;
+  auto const & byPrice = ( _ordered ? *_ordered : temporary.emplace( orderedIndexes() ) ).byPrice;
+  if( count > byPrice.size() )   count = byPrice.size();
+  return itemsAt( byPrice.begin(), std::next( byPrice.begin(), static_cast<std::ptrdiff_t>( count ) ) );
+}
+
+
+
+// byName() const
+template<typename StoragePolicy>
+typename BasicGroceryList<StoragePolicy>::Items BasicGroceryList<StoragePolicy>::byName() const
+{
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
+
+  std::optional<OrderedIndexes> temporary;
+  auto const & byName = ( _ordered ? *_ordered : temporary.emplace( orderedIndexes() ) ).byName;
+  return itemsAt( byName.begin(), byName.end() );
+}
+
+
+
+// startingWith() const
+template<typename StoragePolicy>
+typename BasicGroceryList<StoragePolicy>::Items BasicGroceryList<StoragePolicy>::startingWith( std::string_view prefix ) const
+{
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
+
+  if( _search )
+  {
+    auto const offsets = _search->startingWith( prefix );
+    return itemsAt( offsets.begin(), offsets.end() );
+  }
+
+  // Without the search index, look at every grocery item
+  auto const folded = GroceryListSearchIndex::fold( prefix );
+  Items      items;
+  for( auto const & groceryItem : _storage )   if( GroceryListSearchIndex::namesStartWith( groceryItem, folded ) ) items.push_back( &groceryItem );
+  return items;
+}
+
+
+
+// containing() const
+template<typename StoragePolicy>
+typename BasicGroceryList<StoragePolicy>::Items BasicGroceryList<StoragePolicy>::containing( std::string_view text ) const
+{
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
+
+  if( _search )
+  {
+    auto const offsets = _search->containing( text );
+    return itemsAt( offsets.begin(), offsets.end() );
+  }
+
+  auto const folded = GroceryListSearchIndex::fold( text );
+  Items      items;
+  for( auto const & groceryItem : _storage )   if( GroceryListSearchIndex::namesContain( groceryItem, folded ) ) items.push_back( &groceryItem );
+  return items;
+}
+
+
+
 
 
 
@@ -129,7 +609,8 @@ std::size_t GroceryList::find( const GroceryItem & groceryItem ) const
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // insert( position )
-void GroceryList::insert( const GroceryItem & groceryItem, Position position )
+template<typename StoragePolicy>
+void BasicGroceryList<StoragePolicy>::insert( const GroceryItem & groceryItem, Position position )
 {
   // Convert the TOP and BOTTOM enumerations to an offset and delegate the work
   if     ( position == Position::TOP    )  insert( groceryItem, 0      );
@@ -140,7 +621,8 @@ void GroceryList::insert( const GroceryItem & groceryItem, Position position )
 
 
 // insert( offset )
-void GroceryList::insert( const GroceryItem & groceryItem, std::size_t offsetFromTop )        // insert provided grocery item at offsetFromTop, which places it before the current grocery item at offsetFromTop
+template<typename StoragePolicy>
+void BasicGroceryList<StoragePolicy>::insert( const GroceryItem & groceryItem, std::size_t offsetFromTop )   // insert provided grocery item at offsetFromTop, which places it before the current grocery item at offsetFromTop
 {
   // Validate offset parameter before attempting the insertion.  std::size_t is an unsigned type, so no need to check for negative
   // offsets, and an offset equal to the size of the list says to insert at the end (bottom) of the list.  Anything greater than the
@@ -155,98 +637,35 @@ void GroceryList::insert( const GroceryItem & groceryItem, std::size_t offsetFro
     ///
     /// Remember, you already have a function that tells you if the to-be-inserted grocery item is already in the list, so use it.
     /// Don't implement it again.
-  if (find(groceryItem) != _gList_vector.size()) return;
+  if (find(groceryItem) != _storage.size()) return;
   /////////////////////// END-TO-DO (3) ////////////////////////////
 
 
-  // Inserting into the grocery list means you insert the grocery item into each of the containers (array, vector, list, and
-  // forward_list). Because the data structure concept is different for each container, the way a grocery item gets inserted is a
-  // little different for each.  You are to insert the grocery item into each container such that the ordering of all the containers
-  // is the same.  A check is made at the end of this function to verify the contents of all four containers are indeed the same.
-
-
-  { /**********  Part 1 - Insert into array  ***********************/
-    ///////////////////////// TO-DO (4) //////////////////////////////
-      /// Hint:  "Vector.hpp" in our Sequence Container Implementation Examples shows you how to do this.  (wink wink)
-      /// https://github.com/TBettens/Data_Structure_Implementation_Examples/tree/latest/Sequence%20Container%20Implementation%20Examples/Vector
-      ///
-      /// Unlike the other containers, an std::array has fixed capacity and fixed size (and size is always == capacity) hence has no
-      /// insert() function, so you have to write it yourself. Insert into the array by shifting all the items at and after the
-      /// insertion point (offsetFromTop) to the right opening a gap in the array that can be populated with the given grocery item.
-      /// Remember that arrays have fixed capacity and cannot grow, so make sure there is room in the array for another grocery item
-      /// before you start by verifying _gList_array_size (the number of valid elements) is less than _gList_array.size() (the
-      /// capacity).  If not, throw CapacityExceeded_ex. Also remember that you must keep track of the number of valid grocery items
-      /// in your array, so don't forget to adjust _gList_array_size.
-      ///
-      /// Open a hole to insert new grocery item by shifting to the right everything at and after the insertion point.
-      /// For example:  a[8] = a[7];  a[7] = a[6];  a[6] = a[5];  and so on.
-      /// std::shift_* will be helpful, or write your own loop./*
-      _gList_array_size += 1;
-      if(_gList_array_size > _gList_array.max_size()) throw CapacityExceeded_Ex( "you no more room to add ");
-      std::shift_right(std::next(_gList_array.begin(),offsetFromTop), std::next(_gList_array.begin(), _gList_array_size), 1);
-      _gList_array.at(offsetFromTop) = groceryItem;
-
-     
-    
-    /////////////////////// END-TO-DO (4) ////////////////////////////
-  } // Part 1 - Insert into array
-
-
-
-
-  { /**********  Part 2 - Insert into vector  **********************/
-    ///////////////////////// TO-DO (5) //////////////////////////////
-      /// The vector STL container std::vector has an insert function, which can be directly used here.  But that function takes a
-      /// pointer (or more accurately, an iterator) that points to the grocery item to insert before.  You need to convert the
-      /// zero-based offset from the top (the index) to an iterator by advancing _gList_vector.begin() offsetFromTop times.  The STL
-      /// has a function called std::next() that does that, or you can use simple pointer arithmetic to calculate it.  "Vector.hpp"
-      /// in our Sequence Container Implementation Examples also shows you how convert index to iterator, and iterator to index.
-      ///
-      /// Behind the scenes, std::vector::insert() shifts to the right everything at and after the insertion point, just like you
-      /// did for the array above.
-    _gList_vector.insert(std::next(_gList_vector.begin(), offsetFromTop), groceryItem);
-    if (_gList_vector.size() > _gList_array.max_size()) _gList_vector.pop_back();
-    /////////////////////// END-TO-DO (5) ////////////////////////////
-  } // Part 2 - Insert into vector
-
-
-
-
-  { /**********  Part 3 - Insert into doubly linked list  **********/
-    ///////////////////////// TO-DO (6) //////////////////////////////
-      /// The doubly linked list STL container std::list has an insert function, which can be directly used here.  But that function
-      /// takes a pointer (or more accurately, an iterator) that points to the grocery item to insert before.  You need to convert
-      /// the zero-based offset from the top (the index) to an iterator by advancing _gList_dll.begin() offsetFromTop times.  The
-      /// STL has a function called std::next() that does that, or you can write your own loop.
-    _gList_dll.insert(std::next(_gList_dll.begin(), offsetFromTop), groceryItem);
-    if(_gList_dll.size() > _gList_array.max_size()) _gList_dll.pop_back();
-    /////////////////////// END-TO-DO (6) ////////////////////////////
-  } // Part 3 - Insert into doubly linked list
-
-
-
-
-  { /**********  Part 4 - Insert into singly linked list  **********/
-    ///////////////////////// TO-DO (7) //////////////////////////////
-      /// The singly linked list STL container std::forward_list has an insert function, which can be directly used here.  But that
-      /// function inserts AFTER the grocery item pointed to, not before like the other containers.  A singly linked list cannot
-      /// look backwards, only forward.  You need to convert the zero-based offset from the top (the index) to an iterator by
-      /// advancing _gList_sll.before_begin() offsetFromTop times.  The STL has a function called std::next() that does that, or you
-      /// can write your own loop.
-    _gList_sll.insert_after(std::next(_gList_sll.before_begin(), offsetFromTop), groceryItem);
-    if(gList_sll_size() > _gList_array.max_size()) _gList_sll.erase_after(std::next(_gList_sll.before_begin(),_gList_array.max_size()));
-    /////////////////////// END-TO-DO (7) ////////////////////////////
-  } // Part 4 - Insert into singly linked list
-
-
-  // Verify the internal grocery list state is still consistent amongst the four containers
-  if( !containersAreConsistant() )   throw GroceryList::InvalidInternalState_Ex( "Container consistency error" exception_location );
+  // The storage policy takes care of placing the grocery item into its container(s)
+  _storage.insert( offsetFromTop, groceryItem );
+
+  // Keep the content hash and hash index, if any, in sync with the storage
+  auto const hash = std::hash<GroceryItem>{}( groceryItem );
+  _contentHash.value += itemHash( hash );
+  _orderedHash.value.reset();
+  if( _index )   _index->insertAt( hash, offsetFromTop );
+  if( _ordered )
+  {
+    _ordered->byPrice.insertAt( groceryItem.exactPrice (), offsetFromTop );
+    _ordered->byName .insertAt( groceryItem.productName(), offsetFromTop );
+  }
+  if( _search )   _search->insertAt( groceryItem, offsetFromTop );
+
+
+  // Verify the internal grocery list state is still consistent amongst the containers
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
 } // insert( const GroceryItem & groceryItem, std::size_t offsetFromTop )
 
 
 
 // remove( groceryItem )
-void GroceryList::remove( const GroceryItem & groceryItem )
+template<typename StoragePolicy>
+void BasicGroceryList<StoragePolicy>::remove( const GroceryItem & groceryItem )
 {
   // Delegate to the version of remove() that takes an index as a parameter
   remove( find( groceryItem ) );
@@ -255,92 +674,79 @@ void GroceryList::remove( const GroceryItem & groceryItem )
 
 
 // remove( offset )
-void GroceryList::remove( std::size_t offsetFromTop )
+template<typename StoragePolicy>
+void BasicGroceryList<StoragePolicy>::remove( std::size_t offsetFromTop )
 {
-  // Removing from the grocery list means you remove the grocery item from each of the containers (array, vector, list, and
-  // forward_list). Because the data structure concept is different for each container, the way a grocery item gets removed is a
-  // little different for each.  You are to remove the grocery item from each container such that the ordering of all the containers
-  // is the same.  A check is made at the end of this function to verify the contents of all four containers are indeed the same.
-
   if( offsetFromTop >= size() )   return;                                           // no change occurs if (zero-based) offsetFromTop >= size()
 
+  // Remember the hash of the grocery item being removed while it's still here so the content hash and indexes, if any, can forget
+  // it afterwards
+  auto const & groceryItem = _storage.at( offsetFromTop );
+  auto const   hash        = std::hash<GroceryItem>{}( groceryItem );
+  if( _ordered )
+  {
+    _ordered->byPrice.eraseAt( groceryItem.exactPrice (), offsetFromTop );         // the keys are read from the grocery item, so forget it before
+    _ordered->byName .eraseAt( groceryItem.productName(), offsetFromTop );         // the storage does
+  }
+  if( _search )   _search->eraseAt( offsetFromTop );
 
-  { /**********  Part 1 - Remove from array  ***********************/
-    ///////////////////////// TO-DO (8) //////////////////////////////
-      /// Hint:  "Vector.hpp" in our Sequence Container Implementation Examples shows you how to do this.  (wink wink)
-      ///
-      ///
-      /// Close the hole created by shifting to the left everything at and after the remove point.
-      /// For example:  a[5] = a[6];  a[6] = a[7];  a[7] = a[8];  and so on
-      ///
-      /// std::move() will be helpful, or write your own loop.  Also remember that you must keep track of the number of valid grocery items
-      /// in your array, so don't forget to adjust _gList_array_size.
-      
-      std::shift_left(std::next(_gList_array.begin(), offsetFromTop), std::next(_gList_array.begin(), _gList_array_size) , 1);
-      --_gList_array_size;
-      _gList_array.at(_gList_array_size) = GroceryItem();
-    /////////////////////// END-TO-DO (8) ////////////////////////////
-  } // Part 1 - Remove from array
-
-
-
-
-  { /**********  Part 2 - Remove from vector  **********************/
-    ///////////////////////// TO-DO (9) //////////////////////////////
-      /// The vector STL container std::vector has an erase function, which can be directly used here.  But that function takes a
-      /// pointer (or more accurately, an iterator) that points to the grocery item to be removed.  You need to convert the
-      /// zero-based offset from the top (the index) to an iterator by advancing _gList_vector.begin() offsetFromTop times.  The STL
-      /// has a function called std::next() that does that, or you can use simple pointer arithmetic to calculate it.  "Vector.hpp"
-      /// in our Sequence Container Implementation Examples also shows you how convert index to iterator, and iterator to index.
-      ///
-      /// Behind the scenes, std::vector::erase() shifts to the left everything after the insertion point, just like you did for the
-      /// array above.
-      _gList_vector.erase(std::next(_gList_vector.begin(), offsetFromTop));
-    /////////////////////// END-TO-DO (9) ////////////////////////////
-  } // Part 2 - Remove from vector
-
-
-
-
-  { /**********  Part 3 - Remove from doubly linked list  **********/
-    ///////////////////////// TO-DO (10) //////////////////////////////
-      /// The doubly linked list STL container std::list has an erase function, which can be directly used here.  But that function
-      /// takes a pointer (or more accurately, an iterator) that points to the grocery item to remove.  You need to convert the
-      /// zero-based offset from the top (the index) to an iterator by advancing _gList_dll.begin() offsetFromTop times.  The STL
-      /// has a function called std::next() that does that, or you can write your own loop.
-      _gList_dll.erase(std::next(_gList_dll.begin(), offsetFromTop));
-    /////////////////////// END-TO-DO (10) ////////////////////////////
-  } // Part 3 - Remove from doubly linked list
-
-
-
+  // The storage policy takes care of removing the grocery item from its container(s)
+  _storage.erase( offsetFromTop );
 
-  {/**********  Part 4 - Remove from singly linked list  **********/
-    ///////////////////////// TO-DO (11) //////////////////////////////
-      /// The singly linked list STL container std::forward_list has an erase function, which can be directly used here.  But that
-      /// function erases AFTER the grocery item pointed to, not the one pointed to like the other containers.  A singly linked list
-      /// cannot look backwards, only forward.  You need to convert the zero-based offset from the top (the index) to an iterator by
-      /// advancing _gList_sll.before_begin() offsetFromTop times.  The STL has a function called std::next() that does that, or you
-      /// can write your own loop.
-      _gList_sll.erase_after(std::next(_gList_sll.before_begin(), offsetFromTop));
-    /////////////////////// END-TO-DO (11) ////////////////////////////
-  } // Part 4 - Remove from singly linked list
+  // Keep the content hash and hash index, if any, in sync with the storage
+  _contentHash.value -= itemHash( hash );
+  _orderedHash.value.reset();
+  if( _index )   _index->eraseAt( hash, offsetFromTop );
 
 
-  // Verify the internal grocery list state is still consistent amongst the four containers
-  if( !containersAreConsistant() )   throw GroceryList::InvalidInternalState_Ex( "Container consistency error" exception_location );
+  // Verify the internal grocery list state is still consistent amongst the containers
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
 } // remove( std::size_t offsetFromTop )
 
 
 
 // moveToTop()
-void GroceryList::moveToTop( const GroceryItem & groceryItem )
+template<typename StoragePolicy>
+void BasicGroceryList<StoragePolicy>::moveToTop( const GroceryItem & groceryItem )
 {
+  // A storage policy that can splice does it all in place:  no copy, no duplicate check, and no search unless there's an index
+  // to renumber
+  if constexpr( SplicingStorage<StoragePolicy> )
+  {
+    auto const offset = _index || _ordered || _search ? find( groceryItem ) : 0;
+    if( _storage.moveToTop( groceryItem ) )
+    {
+      _orderedHash.value.reset();
+      if( _index )
+      {
+        auto const hash = std::hash<GroceryItem>{}( groceryItem );
+        _index->eraseAt ( hash, offset );
+        _index->insertAt( hash, 0      );
+      }
+      if( _ordered )
+      {
+        _ordered->byPrice.eraseAt ( groceryItem.exactPrice (), offset );
+        _ordered->byPrice.insertAt( groceryItem.exactPrice (), 0      );
+        _ordered->byName .eraseAt ( groceryItem.productName(), offset );
+        _ordered->byName .insertAt( groceryItem.productName(), 0      );
+      }
+      if( _search )
+      {
+        _search->eraseAt ( offset );
+        _search->insertAt( groceryItem, 0 );
+      }
+    }
+
+    // Verify the internal grocery list state is still consistent amongst the containers
+    if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
+    return;
+  }
+
   ///////////////////////// TO-DO (12) //////////////////////////////
     /// If the grocery item exists, then remove and reinsert it.  Otherwise, do nothing.
     /// Remember, you already have functions to do all this.
     auto found = find(groceryItem);
-   if (found != _gList_vector.size()){
+   if (found != _storage.size()){
     remove(found);
     insert(groceryItem, Position::TOP);
    }
@@ -349,30 +755,141 @@ void GroceryList::moveToTop( const GroceryItem & groceryItem )
 
 
 
+// apply()
+template<typename StoragePolicy>
+void BasicGroceryList<StoragePolicy>::apply( GroceryListPatch const & patch )
+{
+  using Operation = GroceryListPatch::Operation;
+  constexpr auto npos = GroceryListIndex::npos;
+
+  // The base is checked in order, not just by content, since removing by offset from a rearranged list removes the wrong grocery
+  // item.  A grocery list last changed by a patch already knows its hash, from that patch.
+  auto const baseHash = _orderedHash.value ? *_orderedHash.value : orderedHash();
+  if( _storage.size() != patch.baseSize()  ||  baseHash != patch.baseHash() )
+  {
+    throw GroceryListPatch::Mismatch_Ex( "Patch made from a different grocery list" exception_location );
+  }
+
+  // Every edit is checked before any is made, so a patch that doesn't fit - one read from text, say - changes nothing.  In diff()'s
+  // order each removal, bottom up, names an offset in the grocery list as it is now, and the moves and insertions only need to know
+  // which grocery items are already here, which are removed, and which inserted before them.  Whether a grocery item is here is
+  // asked of the hash index or the storage policy if either can say without a search, and otherwise of a temporary hash index
+  // built once, and only if needed.
+  std::vector<GroceryItem const *> members, removed, inserted;
+  GroceryListIndex                 memberIndex, removedIndex, insertedIndex;
+  auto itemAt     = [this     ]( std::size_t candidate ) -> GroceryItem const & { return _storage.at( candidate ); };
+  auto memberAt   = [&members ]( std::size_t candidate ) -> GroceryItem const & { return *members [candidate];   };
+  auto removedAt  = [&removed ]( std::size_t candidate ) -> GroceryItem const & { return *removed [candidate];   };
+  auto insertedAt = [&inserted]( std::size_t candidate ) -> GroceryItem const & { return *inserted[candidate];   };
+
+  auto held = [&]( GroceryItem const & groceryItem, std::size_t hash )
+  {
+    if( _index )   return _index->find( groceryItem, hash, itemAt ) != npos;
+
+    if constexpr     ( ScreeningStorage<StoragePolicy> )   return _storage.contains( groceryItem );
+    else if constexpr( LocatingStorage <StoragePolicy> )   return _storage.offsetOf( groceryItem ) != _storage.size();
+    else
+    {
+      if( members.size() != _storage.size() )
+      {
+        memberIndex.reserve( _storage.size() );
+        for( auto const & member : _storage )
+        {
+          memberIndex.insertAt( std::hash<GroceryItem>{}( member ), members.size() );
+          members.push_back( &member );
+        }
+      }
+      return memberIndex.find( groceryItem, hash, memberAt ) != npos;
+    }
+  };
+  auto present = [&]( GroceryItem const & groceryItem, std::size_t hash )       // here once the removals are made
+  {
+    return held( groceryItem, hash )  &&  removedIndex.find( groceryItem, hash, removedAt ) == npos;
+  };
+
+  auto const & edits = patch.edits();
+  auto         edit  = edits.begin();
+  for( auto bottom = _storage.size();  edit != edits.end()  &&  edit->operation == Operation::REMOVE;  ++edit )
+  {
+    if( edit->offset >= bottom  ||  !( _storage.at( edit->offset ) == edit->groceryItem ) )
+    {
+      throw GroceryListPatch::Mismatch_Ex( "Patch removes a grocery item that isn't there" exception_location );
+    }
+    bottom = edit->offset;
+    removedIndex.insertAt( std::hash<GroceryItem>{}( edit->groceryItem ), removed.size() );
+    removed.push_back( &edit->groceryItem );
+  }
+
+  for( ;  edit != edits.end()  &&  edit->operation == Operation::MOVE_TO_TOP;  ++edit )
+  {
+    if( !present( edit->groceryItem, std::hash<GroceryItem>{}( edit->groceryItem ) ) )
+    {
+      throw GroceryListPatch::Mismatch_Ex( "Patch moves a grocery item that isn't there" exception_location );
+    }
+  }
+
+  for( auto size = _storage.size() - removed.size();  edit != edits.end()  &&  edit->operation == Operation::INSERT;  ++edit, ++size )
+  {
+    if( edit->offset > size )   throw GroceryListPatch::Mismatch_Ex( "Patch inserts past the bottom of the grocery list" exception_location );
+
+    auto const hash = std::hash<GroceryItem>{}( edit->groceryItem );
+    if( present( edit->groceryItem, hash )  ||  insertedIndex.find( edit->groceryItem, hash, insertedAt ) != npos )
+    {
+      throw GroceryListPatch::Mismatch_Ex( "Patch inserts a grocery item that's already there" exception_location );
+    }
+    insertedIndex.insertAt( hash, inserted.size() );
+    inserted.push_back( &edit->groceryItem );
+  }
+
+  if( edit != edits.end() )   throw GroceryListPatch::Mismatch_Ex( "Patch edits out of order" exception_location );
+  members.clear();                                                                  // they point into the storage, which is about to change
+
+
+  // Every edit fits, so make them in place.  diff() writes runs of insertions at consecutive offsets, and a run is inserted as one
+  // batch - one gap opened instead of one per grocery item - without another duplicate pass, since none of them are here.
+  edit = edits.begin();
+  for( ;  edit != edits.end()  &&  edit->operation == Operation::REMOVE;       ++edit )   remove   ( edit->offset      );
+  for( ;  edit != edits.end()  &&  edit->operation == Operation::MOVE_TO_TOP;  ++edit )   moveToTop( edit->groceryItem );
+  while( edit != edits.end() )
+  {
+    auto const               offset = edit->offset;
+    std::vector<GroceryItem> batch;
+    for( ;  edit != edits.end()  &&  edit->offset == offset + batch.size();  ++edit )   batch.emplace_back( edit->groceryItem, allocator() );
+    insertUnique( std::move( batch ), offset );
+  }
+
+  // The patch says what the grocery list now hashes to, so the next patch's base needn't be rehashed
+  _orderedHash.value = patch.resultHash();
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
+}
+
+
+
 // operator+=( initializer_list )
-GroceryList & GroceryList::operator+=( const std::initializer_list<GroceryItem> & rhs )
+template<typename StoragePolicy>
+BasicGroceryList<StoragePolicy> & BasicGroceryList<StoragePolicy>::operator+=( const std::initializer_list<GroceryItem> & rhs )
 {
   ///////////////////////// TO-DO (13) //////////////////////////////
     /// Append (aka concatenate) the right hand side (rhs) to the bottom of this list by repeatedly inserting at the bottom of this
     /// grocery list. The input type is just a container of grocery items accessible with iterators just like all the other
     /// containers.  The constructor above gives an example.  Remember to add that grocery item at the bottom of each container
     /// (array, vector, list, and forward_list) of this grocery list, and that you already have a function that does that.
-  for (const auto & items : rhs)
-  {
-    insert(items,Position::BOTTOM);
-  }
-  
+    ///
+    /// Inserting one grocery item at a time re-checks for duplicates, shifts, and verifies consistency for every grocery item, so
+    /// the whole braced list goes in as a single batch instead.
+  insert( rhs.begin(), rhs.end(), size() );
   /////////////////////// END-TO-DO (13) ////////////////////////////
 
-  // Verify the internal grocery list state is still consistent amongst the four containers
-  if( !containersAreConsistant() )   throw GroceryList::InvalidInternalState_Ex( "Container consistency error" exception_location );
+  // Verify the internal grocery list state is still consistent amongst the containers
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
   return *this;
 }
 
 
 
 // operator+=( GroceryList )
-GroceryList & GroceryList::operator+=( const GroceryList & rhs )
+template<typename StoragePolicy>
+BasicGroceryList<StoragePolicy> & BasicGroceryList<StoragePolicy>::operator+=( const BasicGroceryList & rhs )
 {
   ///////////////////////// TO-DO (14) //////////////////////////////
     /// Append (aka concatenate) the right hand side (rhs) to the bottom of this list by repeatedly inserting at the bottom of this
@@ -380,14 +897,71 @@ GroceryList & GroceryList::operator+=( const GroceryList & rhs )
     /// to traverse. Walk the container you picked inserting its grocery items to the bottom of this grocery list. Remember to add
     /// that grocery item at the bottom of each container (array, vector, list, and forward_list) of this grocery list, and that you
     /// already have a function that does that.
-  for (const auto & items : rhs._gList_vector)
+    ///
+    /// As above, the whole rhs goes in as a single batch.  The batch is gathered before anything is inserted, so appending a list
+    /// to itself is fine.
+  insert( rhs._storage.begin(), rhs._storage.end(), size() );
+  /////////////////////// END-TO-DO (14) ////////////////////////////
+
+  // Verify the internal grocery list state is still consistent amongst the containers
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
+  return *this;
+}
+
+
+
+// indexed( enabled )
+template<typename StoragePolicy>
+BasicGroceryList<StoragePolicy> & BasicGroceryList<StoragePolicy>::indexed( bool enabled ) &
+{
+  if constexpr( LocatingStorage<StoragePolicy> )   return *this;                                   // the storage policy is already an index, and can't be opted out of
+
+  if( !enabled )
   {
-    insert(items, Position::BOTTOM);
+    _index.reset();
+    return *this;
   }
-  /////////////////////// END-TO-DO (14) ////////////////////////////
 
-  // Verify the internal grocery list state is still consistent amongst the four containers
-  if( !containersAreConsistant() )   throw GroceryList::InvalidInternalState_Ex( "Container consistency error" exception_location );
+  if( _index ) return *this;                                                        // already indexed
+
+  // Build the index from the current content, top to bottom, so each grocery item lands at its current offset
+  _index.emplace();
+  std::size_t offset = 0;
+  for( auto const & groceryItem : _storage )   _index->insertAt( std::hash<GroceryItem>{}( groceryItem ), offset++ );
+
+  return *this;
+}
+
+
+
+// ordered( enabled )
+template<typename StoragePolicy>
+BasicGroceryList<StoragePolicy> & BasicGroceryList<StoragePolicy>::ordered( bool enabled ) &
+{
+  if     ( !enabled )   _ordered.reset();
+  else if( !_ordered )  _ordered = orderedIndexes();
+  return *this;
+}
+
+
+
+// searchable( enabled )
+template<typename StoragePolicy>
+BasicGroceryList<StoragePolicy> & BasicGroceryList<StoragePolicy>::searchable( bool enabled ) &
+{
+  if( !enabled )
+  {
+    _search.reset();
+    return *this;
+  }
+
+  if( _search ) return *this;                                                       // already searchable
+
+  // Build the index from the current content, top to bottom, so each grocery item lands at its current offset
+  _search.emplace();
+  std::size_t offset = 0;
+  for( auto const & groceryItem : _storage )   _search->insertAt( groceryItem, offset++ );
+
   return *this;
 }
 
@@ -408,9 +982,10 @@ GroceryList & GroceryList::operator+=( const GroceryList & rhs )
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // operator<=>
-std::weak_ordering GroceryList::operator<=>( GroceryList const & rhs ) const
+template<typename StoragePolicy>
+std::weak_ordering BasicGroceryList<StoragePolicy>::operator<=>( BasicGroceryList const & rhs ) const
 {
-  if( !containersAreConsistant() || !rhs.containersAreConsistant() )   throw GroceryList::InvalidInternalState_Ex( "Container consistency error" exception_location );
+  if( !containersAreConsistant() || !rhs.containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
 
   ///////////////////////// TO-DO (15) //////////////////////////////
     /// Find the common extent.  That is, if one list has 20 grocery items, and the other has only 13, then the common extent is 13
@@ -421,28 +996,17 @@ std::weak_ordering GroceryList::operator<=>( GroceryList const & rhs ) const
     ///
     ///
     /// The content of all the grocery lists's containers is the same - so pick an easy one to walk.
-  unsigned its = 0;
-  for (const auto & array : _gList_array)
-  {
-    auto results = array <=> rhs._gList_vector[its];
-    if (results != 0){
-      return results;
-    }
-    ++its;
-  }
-  return size() <=> rhs.size() ;
-  
-  
-  
+  return std::lexicographical_compare_three_way( _storage.begin(), _storage.end(), rhs._storage.begin(), rhs._storage.end() );
   /////////////////////// END-TO-DO (15) ////////////////////////////
 }
 
 
 
 // operator==
-bool GroceryList::operator==( GroceryList const & rhs ) const
+template<typename StoragePolicy>
+bool BasicGroceryList<StoragePolicy>::operator==( BasicGroceryList const & rhs ) const
 {
-  if( !containersAreConsistant() || !rhs.containersAreConsistant() )   throw GroceryList::InvalidInternalState_Ex( "Container consistency error" exception_location );
+  if( !containersAreConsistant() || !rhs.containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
 
   ///////////////////////// TO-DO (16) //////////////////////////////
     /// Two lists are different if their sizes are different, or one of their grocery items is different.  Otherwise the lists are
@@ -453,15 +1017,9 @@ bool GroceryList::operator==( GroceryList const & rhs ) const
     /// Walk the list looking for grocery items that don't match.  The content of all the grocery lists's containers is the same -
     /// so pick an easy one to walk.
     if (size() != rhs.size()) return false;
-   
-      unsigned its = 0;
-      for (const auto & array : _gList_array) {
-        if(!(array == rhs._gList_array[its])) return false;
-        ++its;
-      }
-   
-    return true;
-   
+    if (_contentHash.value != rhs._contentHash.value) return false;                 // different grocery items, no need to look.  Equal hashes still need a look
+
+    return std::equal( _storage.begin(), _storage.end(), rhs._storage.begin() );
   /////////////////////// END-TO-DO (16) ////////////////////////////
 }
 
@@ -481,49 +1039,291 @@ bool GroceryList::operator==( GroceryList const & rhs ) const
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// allocator() const
+template<typename StoragePolicy>
+GroceryItem::allocator_type BasicGroceryList<StoragePolicy>::allocator() const noexcept
+{
+  if constexpr( AllocatorAwareStorage<StoragePolicy> )   return _storage.resource();
+  else                                                    return {};              // the default resource, as the storage's containers copy into
+}
+
+
+
+// insertBatch()
+template<typename StoragePolicy>
+void BasicGroceryList<StoragePolicy>::insertBatch( std::vector<GroceryItem> && batch, std::size_t offsetFromTop )
+{
+  if( offsetFromTop > size() )   throw InvalidOffset_Ex( "Insertion position beyond end of current list size" exception_location );
+
+
+  // Prevent duplicate entries.  A grocery item is skipped if it's already in this grocery list, or if it appeared earlier in the
+  // batch - exactly what inserting the batch one grocery item at a time would do.  Grocery items already in the list are found by
+  // the hash index if there is one.  Otherwise, and for the batch itself, a temporary hash index is built as we go over the
+  // grocery items seen so far (members), so that's linear in the batch (plus the list), rather than a linear search of the list
+  // for every grocery item in the batch.  A storage policy that locates or screens its own grocery items stands in for the hash
+  // index.
+  constexpr bool locating = LocatingStorage<StoragePolicy>  ||  ScreeningStorage<StoragePolicy>;
+  auto held = [this]( GroceryItem const & groceryItem )
+  {
+    if constexpr     ( ScreeningStorage<StoragePolicy> )   return _storage.contains( groceryItem );
+    else if constexpr( LocatingStorage <StoragePolicy> )   return _storage.offsetOf( groceryItem ) != _storage.size();
+    else                                                    return false;
+  };
+
+  std::vector<GroceryItem const *> members;
+  GroceryListIndex                 seen;
+  auto memberAt = [&members]( std::size_t candidate ) -> GroceryItem const & { return *members[candidate]; };
+  auto itemAt   = [this    ]( std::size_t candidate ) -> GroceryItem const & { return _storage.at( candidate ); };
+
+  auto const expected = batch.size() + ( locating || _index ? 0 : _storage.size() );
+  members.reserve( expected );
+  seen   .reserve( expected );
+
+  if( !locating  &&  !_index )
+  {
+    for( auto const & groceryItem : _storage )
+    {
+      seen.insertAt( std::hash<GroceryItem>{}( groceryItem ), members.size() );
+      members.push_back( &groceryItem );
+    }
+  }
+
+  std::vector<bool> keep( batch.size() );
+  for( std::size_t i = 0; i < batch.size(); ++i )
+  {
+    auto const & groceryItem = batch[i];
+    auto const   hash        = std::hash<GroceryItem>{}( groceryItem );
+
+    if constexpr( locating )   { if( held( groceryItem ) ) continue; }
+    if( _index  &&  _index->find( groceryItem, hash, itemAt ) != GroceryListIndex::npos ) continue;
+    if( seen.find( groceryItem, hash, memberAt ) != GroceryListIndex::npos )               continue;
+
+    seen.insertAt( hash, members.size() );
+    members.push_back( &groceryItem );
+    keep[i] = true;
+  }
+  seen.clear();                                                                     // members point into the batch, which is about to be rearranged
+  members.clear();
+
+
+  // Squeeze out the duplicates
+  std::size_t kept = 0;
+  for( std::size_t i = 0; i < batch.size(); ++i )
+  {
+    if( !keep[i] ) continue;
+    if( kept != i )   batch[kept] = std::move( batch[i] );
+    ++kept;
+  }
+  batch.erase( batch.begin() + static_cast<std::ptrdiff_t>( kept ), batch.end() );
+
+
+  insertUnique( std::move( batch ), offsetFromTop );
+}
+
+
+
+// insertUnique()
+template<typename StoragePolicy>
+void BasicGroceryList<StoragePolicy>::insertUnique( std::vector<GroceryItem> && batch, std::size_t offsetFromTop )
+{
+  // Hash the grocery items before the storage takes them, for the content hash and so the hash index, if any, can record them
+  // afterwards
+  std::vector<std::size_t>      hashes;
+  std::vector<Money>            prices;
+  std::vector<std::pmr::string> names;
+  std::size_t                   contentHash = 0;
+  if( _index   )   hashes.reserve( batch.size() );
+  if( _ordered )   { prices.reserve( batch.size() );  names.reserve( batch.size() ); }
+  for( auto const & groceryItem : batch )
+  {
+    auto const hash = std::hash<GroceryItem>{}( groceryItem );
+    contentHash += itemHash( hash );
+    if( _index   )   hashes.push_back( hash );
+    if( _ordered )   { prices.push_back( groceryItem.exactPrice() );  names.push_back( groceryItem.productName() ); }
+  }
+
+  // The search index reads the names itself, while the batch still has them
+  if( _search )   _search->insertAt( batch, offsetFromTop );
+
+  // One storage insertion opening one gap, and one index renumbering
+  _storage.insert( offsetFromTop, std::move( batch ) );
+  _contentHash.value += contentHash;
+  _orderedHash.value.reset();
+  if( _index   )   _index->insertAt( hashes, offsetFromTop );
+  if( _ordered )
+  {
+    _ordered->byPrice.insertAt( std::move( prices ), offsetFromTop );
+    _ordered->byName .insertAt( std::move( names  ), offsetFromTop );
+  }
+
+
+  // Verify the internal grocery list state is still consistent amongst the containers
+  if( !containersAreConsistant() )   throw InvalidInternalState_Ex( "Container consistency error" exception_location );
+}
+
+
+
 // containersAreConsistant() const
-bool GroceryList::containersAreConsistant() const
+template<typename StoragePolicy>
+bool BasicGroceryList<StoragePolicy>::containersAreConsistant() const
 {
-  // Sizes of all containers must be equal to each other
-  if(    _gList_array_size != _gList_vector.size()
-      || _gList_array_size != _gList_dll.size()
-      || _gList_array_size !=  gList_sll_size() ) return false;
+  // Everything but the selected policy compiles away.  With Checks::NONE this is just "return true", and the calls sprinkled
+  // throughout the public interface cost nothing.
+  auto sizesAreConsistant = [this]()
+  {
+    return _storage.sizesAreConsistant()
+        && ( !_index    ||  _index->size() == _storage.size() )
+        && ( !_ordered  ||  ( _ordered->byPrice.size() == _storage.size()  &&  _ordered->byName.size() == _storage.size() ) )
+        && ( !_search   ||  _search->size() == _storage.size() );
+  };
+
+  auto contentsAreConsistant = [&]()
+  {
+    if( !sizesAreConsistant() || !_storage.contentsAreConsistant() ) return false;
+
+    // The content hash must be the sum of the grocery items' hashes
+    std::size_t contentHash = 0;
+    for( auto const & groceryItem : _storage )   contentHash += itemHash( std::hash<GroceryItem>{}( groceryItem ) );
+    if( contentHash != _contentHash.value ) return false;
+
+    // A hash kept from the last patch applied must still be the grocery list's
+    if( _orderedHash.value  &&  *_orderedHash.value != orderedHash() ) return false;
+
+    // Every grocery item must be found by the hash index, if any, at its current offset
+    if( _index )
+    {
+      auto        itemAt = [this]( std::size_t candidate ) -> GroceryItem const & { return _storage.at( candidate ); };
+      std::size_t offset = 0;
+      for( auto const & groceryItem : _storage )
+      {
+        if( _index->find( groceryItem, std::hash<GroceryItem>{}( groceryItem ), itemAt ) != offset++ ) return false;
+      }
+    }
 
-  // Element content and order must be equal to each other
-  auto current_array_position   = _gList_array .cbegin();
-  auto current_vector_position  = _gList_vector.cbegin();
-  auto current_dll_position     = _gList_dll   .cbegin();
-  auto current_sll_position     = _gList_sll   .cbegin();
+    // Every sorted index entry must carry the key of the grocery item at its offset
+    if( _ordered )
+    {
+      for( auto const & [price, offset] : _ordered->byPrice )   if( _storage.at( offset ).exactPrice () != price ) return false;
+      for( auto const & [name,  offset] : _ordered->byName  )   if( _storage.at( offset ).productName() != name  ) return false;
+    }
 
-  auto end = _gList_vector.cend();
-  while( current_vector_position != end )
+    // Every grocery item must be found by the search index, if any, at its current offset
+    if( _search )
+    {
+      std::size_t offset = 0;
+      for( auto const & groceryItem : _storage )
+      {
+        auto const offsets = _search->startingWith( groceryItem.productName() );
+        if( !std::binary_search( offsets.begin(), offsets.end(), offset++ ) ) return false;
+      }
+    }
+    return true;
+  };
+
+
+  if      constexpr( consistencyChecks == Checks::NONE    )   return true;
+  else if constexpr( consistencyChecks == Checks::SIZES   )   return sizesAreConsistant();
+  else if constexpr( consistencyChecks == Checks::SAMPLED )
   {
-    if(    *current_array_position != *current_vector_position
-       || *current_array_position != *current_dll_position
-       || *current_array_position != *current_sll_position ) return false;
+    // Count checks per thread rather than per grocery list so the sampling state doesn't become part of the object
+    thread_local std::size_t checkCount = 0;
+    if( ++checkCount % checkSampleInterval != 0 ) return sizesAreConsistant();
+    return contentsAreConsistant();
+  }
+  else                                                        return contentsAreConsistant();
+}
+
 
-    // Advance the iterators to the next element in unison
-    ++current_array_position;
-    ++current_vector_position;
-    ++current_dll_position;
-    ++current_sll_position;
+
+// orderedIndexes() const
+template<typename StoragePolicy>
+typename BasicGroceryList<StoragePolicy>::OrderedIndexes BasicGroceryList<StoragePolicy>::orderedIndexes() const
+{
+  // Gather the keys top to bottom and let each index sort its batch once
+  std::vector<Money>            prices;
+  std::vector<std::pmr::string> names;
+  prices.reserve( _storage.size() );
+  names .reserve( _storage.size() );
+  for( auto const & groceryItem : _storage )
+  {
+    prices.push_back( groceryItem.exactPrice () );
+    names .push_back( groceryItem.productName() );
+  }
+
+  OrderedIndexes indexes;
+  indexes.byPrice.insertAt( std::move( prices ), 0 );
+  indexes.byName .insertAt( std::move( names  ), 0 );
+  return indexes;
+}
+
+
+
+// itemsAt() const
+template<typename StoragePolicy>
+template<typename Iterator>
+typename BasicGroceryList<StoragePolicy>::Items BasicGroceryList<StoragePolicy>::itemsAt( Iterator first, Iterator last ) const
+{
+  // Either plain offsets or index entries carrying one
+  auto offsetOf = []( auto const & element ) noexcept -> std::size_t
+  {
+    if constexpr( std::is_integral_v<std::remove_cvref_t<decltype( element )>> )   return element;
+    else                                                                            return element.offset;
+  };
+
+  Items items;
+  items.reserve( static_cast<std::size_t>( std::distance( first, last ) ) );
+
+  // Storage that reaches an offset in constant (or logarithmic) time is simply asked for each one.  The trees, which locate or
+  // screen their own grocery items, are the latter
+  if constexpr( std::random_access_iterator<typename StoragePolicy::const_iterator>  ||  LocatingStorage<StoragePolicy>
+                                                                                     ||  ScreeningStorage<StoragePolicy> )
+  {
+    for( ; first != last; ++first )   items.push_back( &_storage.at( offsetOf( *first ) ) );
   }
 
-  return true;
+  // Otherwise visit the offsets in ascending order, walking the storage just once, and put each grocery item where it belongs
+  else
+  {
+    std::vector<std::pair<std::size_t, std::size_t>> wanted;                      // (offset, slot in items)
+    wanted.reserve( items.capacity() );
+    for( ; first != last; ++first )   wanted.emplace_back( offsetOf( *first ), wanted.size() );
+    std::sort( wanted.begin(), wanted.end() );
+
+    items.resize( wanted.size() );
+    auto        current = _storage.begin();
+    std::size_t offset  = 0;
+    for( auto const & [target, slot] : wanted )
+    {
+      std::advance( current, static_cast<std::ptrdiff_t>( target - offset ) );
+      offset      = target;
+      items[slot] = &*current;
+    }
+  }
+
+  return items;
+}
+
+
+
+// orderedHash() const
+template<typename StoragePolicy>
+std::size_t BasicGroceryList<StoragePolicy>::orderedHash() const noexcept
+{
+  // Each grocery item's hash is mixed in after those above it, so the same grocery items in another order hash differently
+  auto hash = itemHash( _storage.size() );
+  for( auto const & groceryItem : _storage )   hash = itemHash( hash ^ std::hash<GroceryItem>{}( groceryItem ) );
+  return hash;
 }
 
 
 
-// gList_sll_size() const
-std::size_t GroceryList::gList_sll_size() const
+// itemHash()
+template<typename StoragePolicy>
+std::size_t BasicGroceryList<StoragePolicy>::itemHash( std::size_t hash ) noexcept
 {
-  ///////////////////////// TO-DO (17) //////////////////////////////
-    /// Some implementations of a singly linked list maintain the size (number of elements in the list).  std::forward_list does
-    /// not. The size of singly linked list must be calculated on demand by walking the list from beginning to end counting the
-    /// number of elements visited.  The STL's std::distance() function does that, or you can write your own loop.
-  return std::distance(_gList_sll.begin(), _gList_sll.end());
-  
-  /////////////////////// END-TO-DO (17) ////////////////////////////
+  // The SplitMix64 finalizer.  std::hash<GroceryItem> is a good hash, but summing them would let any structure left in its low
+  // bits pile up; mixing first makes every bit of the sum depend on every bit of every grocery item's hash.
+  return splitMix64( hash );
 }
 
 
@@ -543,14 +1343,15 @@ std::size_t GroceryList::gList_sll_size() const
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // operator<<
-std::ostream & operator<<( std::ostream & stream, const GroceryList & groceryList )
+template<typename StoragePolicy>
+std::ostream & operator<<( std::ostream & stream, const BasicGroceryList<StoragePolicy> & groceryList )
 {
-  if( !groceryList.containersAreConsistant() )   throw GroceryList::InvalidInternalState_Ex( "Container consistency error" exception_location );
+  if( !groceryList.containersAreConsistant() )   throw GroceryListBase::InvalidInternalState_Ex( "Container consistency error" exception_location );
 
   // For each grocery item in the provided grocery list, insert the grocery item into the provided stream.  Each grocery item is
   // inserted on a new line and preceded with its index (aka offset from top)
   unsigned count = 0;
-  for( auto && groceryItem : groceryList._gList_sll )   stream << '\n' << std::setw(5) << count++ << ":  " << groceryItem;
+  for( auto && groceryItem : groceryList._storage )   stream << '\n' << std::setw(5) << count++ << ":  " << groceryItem;
 
   return stream;
 }
@@ -558,18 +1359,64 @@ std::ostream & operator<<( std::ostream & stream, const GroceryList & groceryLis
 
 
 // operator>>
-std::istream & operator>>( std::istream & stream, GroceryList & groceryList )
+template<typename StoragePolicy>
+std::istream & operator>>( std::istream & stream, BasicGroceryList<StoragePolicy> & groceryList )
 {
-  if( !groceryList.containersAreConsistant() )   throw GroceryList::InvalidInternalState_Ex( "Container consistency error" exception_location );
+  if( !groceryList.containersAreConsistant() )   throw GroceryListBase::InvalidInternalState_Ex( "Container consistency error" exception_location );
 
   ///////////////////////// TO-DO (18) //////////////////////////////
     /// Extract until end of file grocery items from the provided stream and insert them at the bottom of the provided grocery list.
     /// Be sure to extract grocery items and not individual fields such as product name or UPC.
+    /// The grocery items are gathered and then appended as a single batch.
+    std::vector<GroceryItem> batch;
     GroceryItem holder;
     while (stream >> holder){
-    groceryList.insert(holder, GroceryList::Position::BOTTOM);
+    batch.push_back(std::move(holder));
     }
+    groceryList.insertBatch(std::move(batch), groceryList.size());
   /////////////////////// END-TO-DO (18) ////////////////////////////
 
   return stream;
 }
+
+
+
+
+
+
+
+
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Explicit instantiations
+//
+// The member functions above are defined here rather than in the header, so each storage policy a grocery list can be used with
+// is instantiated here.  Add a block for any new storage policy.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template class     BasicGroceryList<SmallVectorStorage<>>;
+template std::ostream & operator<<( std::ostream &, BasicGroceryList<SmallVectorStorage<>> const & );
+template std::istream & operator>>( std::istream &, BasicGroceryList<SmallVectorStorage<>>       & );
+
+template class     BasicGroceryList<VectorStorage>;
+template std::ostream & operator<<( std::ostream &, BasicGroceryList<VectorStorage> const & );
+template std::istream & operator>>( std::istream &, BasicGroceryList<VectorStorage>       & );
+
+template class     BasicGroceryList<ListStorage>;
+template std::ostream & operator<<( std::ostream &, BasicGroceryList<ListStorage> const & );
+template std::istream & operator>>( std::istream &, BasicGroceryList<ListStorage>       & );
+
+template class     BasicGroceryList<TreeStorage>;
+template std::ostream & operator<<( std::ostream &, BasicGroceryList<TreeStorage> const & );
+template std::istream & operator>>( std::istream &, BasicGroceryList<TreeStorage>       & );
+
+template class     BasicGroceryList<PersistentStorage>;
+template std::ostream & operator<<( std::ostream &, BasicGroceryList<PersistentStorage> const & );
+template std::istream & operator>>( std::istream &, BasicGroceryList<PersistentStorage>       & );
+
+template class     BasicGroceryList<ShadowStorage<>>;
+template std::ostream & operator<<( std::ostream &, BasicGroceryList<ShadowStorage<>> const & );
+template std::istream & operator>>( std::istream &, BasicGroceryList<ShadowStorage<>>       & );
@@ -1,78 +1,255 @@
 #pragma once                                                                                  // include guard
 
-#include <array>
 #include <compare>                                                                            // weak_ordering
 #include <cstddef>                                                                            // size_t
-#include <forward_list>
+#include <filesystem>                                                                         // path
 #include <initializer_list>
 #include <iostream>
-#include <list>
-#include <stdexcept>                                                                          // domain_error, length_error, logic_error
+#include <iterator>                                                                           // input_iterator, forward_iterator, distance()
+#include <memory_resource>                                                                    // memory_resource
+#include <optional>
+#include <functional>                                                                         // hash
+#include <ranges>                                                                             // input_range, sized_range, size()
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>                                                                            // move(), exchange()
 #include <vector>
 
 #include "GroceryItem.hpp"
+#include "GroceryListBase.hpp"
+#include "GroceryListIndex.hpp"
+#include "GroceryListOrderedIndex.hpp"
+#include "GroceryListPatch.hpp"
+#include "GroceryListSearchIndex.hpp"
+#include "GroceryListStorage.hpp"
+#include "Money.hpp"
 
 
-class GroceryList
+// A grocery list is parameterized by how it stores its grocery items.  See GroceryListStorage.hpp for the available storage
+// policies.  Most code should simply use GroceryList, which picks the default storage policy.  The member functions are
+// implemented in GroceryList.cpp and explicitly instantiated there for each storage policy.
+template<typename StoragePolicy>  class BasicGroceryList;
+
+using GroceryList = BasicGroceryList<SmallVectorStorage<>>;
+
+
+
+// Insertion and Extraction Operators
+template<typename StoragePolicy>  std::ostream & operator<<( std::ostream & stream, BasicGroceryList<StoragePolicy> const & groceryList );
+template<typename StoragePolicy>  std::istream & operator>>( std::istream & stream, BasicGroceryList<StoragePolicy>       & groceryList );
+
+class GroceryListWriter;                                                                      // the insertion operator's text, without the stream
+class GroceryCatalog;                                                                         // the grocery items, column by column
+
+
+
+template<typename StoragePolicy>
+class BasicGroceryList : public GroceryListBase
 {
   // Insertion and Extraction Operators
-  friend std::ostream & operator<<( std::ostream & stream, GroceryList const & groceryList );
-  friend std::istream & operator>>( std::istream & stream, GroceryList       & groceryList );
+  friend std::ostream & operator<< <>( std::ostream & stream, BasicGroceryList const & groceryList );
+  friend std::istream & operator>> <>( std::istream & stream, BasicGroceryList       & groceryList );
+  friend class GroceryListWriter;
+  friend class GroceryCatalog;
 
   public:
-    // Types and Exceptions
-    enum class Position {TOP, BOTTOM};
-
-    struct InvalidInternalState_Ex : std::domain_error { using domain_error::domain_error; }; // Thrown if internal data structures become inconsistent with each other
-    struct CapacityExceeded_Ex     : std::length_error { using length_error::length_error; }; // Thrown if more grocery items are inserted than will fit
-    struct InvalidOffset_Ex        : std::logic_error  { using logic_error ::logic_error;  }; // Thrown if inserting beyond current size
+    // Types and Exceptions (see GroceryListBase for Position and the exceptions)
+    using Storage = StoragePolicy;
 
 
     // Constructors, destructor, and assignments
     //
     // The compiler synthesized copy and move constructors, and copy and move assignment operators work just fine.  But since I also
     // have user defined constructors, I need to explicitly say the compiler synthesized default constructor is also okay.
-    GroceryList() = default;                                                                  // constructs an empty grocery list
-    GroceryList( std::initializer_list<GroceryItem> const & initList );                       // constructs a grocery list from a braced list of grocery items
+    BasicGroceryList() = default;                                                             // constructs an empty grocery list
+    BasicGroceryList( std::initializer_list<GroceryItem> const & initList );                  // constructs a grocery list from a braced list of grocery items
+    explicit BasicGroceryList( std::pmr::memory_resource * resource )                         // constructs an empty grocery list whose storage allocates from resource, an arena or
+      requires AllocatorAwareStorage<StoragePolicy>;                                          // pool that must outlive it.  Copies of it allocate from the default resource
+
+    static BasicGroceryList loadFile( std::filesystem::path const & path );                   // constructs a grocery list from a whole file of grocery items in one pass.  The file is
+                                                                                              // memory mapped and parsed in place (see MappedFile and GroceryItemParser), duplicates
+                                                                                              // are skipped.  Throws std::system_error or GroceryItemParser::MalformedRecord_Ex
+    static BasicGroceryList loadImage( std::filesystem::path const & path );                  // constructs a grocery list from a file written by saveImage(), memory mapped and read in
+                                                                                              // place.  Throws std::system_error or GroceryListImage::MalformedImage_Ex
+
+    static BasicGroceryList unionOf( std::span<BasicGroceryList const> lists,                 // constructs a grocery list of all the lists' grocery items, in order, each grocery
+                                     unsigned threads = 0 );                                  // item kept only where it first occurs.  The hashing and duplicate removal are split
+                                                                                              // across threads worker threads, 0 for one per hardware thread
 
 
     // Queries
-    std::size_t size() const;                                                                 // returns the number of grocery items in this grocery list
+    std::size_t size   () const;                                                              // returns the number of grocery items in this grocery list
+    bool        indexed() const noexcept;                                                     // returns true if find() is answered by a hash index (or a LocatingStorage policy)
+                                                                                              // instead of a linear search
+    bool        ordered() const noexcept;                                                     // returns true if the price and product name queries below are answered by sorted
+                                                                                              // indexes instead of sorting on demand
+    bool        searchable() const noexcept;                                                  // returns true if the name searches below are answered by a search index instead of
+                                                                                              // a linear search
+    Money       total  () const;                                                              // returns the sum of the grocery items' prices, exactly.  Throws Money::Overflow_Ex
+                                                                                              // if the sum can't be represented
+    std::size_t hash   () const noexcept;                                                     // returns a hash of the grocery items (but not their order), kept up to date as the list
+                                                                                              // changes so it's constant time.  Equal lists hash alike, see operator==
+    void        saveImage( std::filesystem::path const & path ) const;                        // writes the grocery items to a file in the binary GroceryListImage format, in one write
+                                                                                              // call.  Throws std::system_error
+
+    static GroceryListPatch diff( BasicGroceryList const & from,                              // returns the edits that turn from into to (see GroceryListPatch).  Takes O(n log n)
+                                  BasicGroceryList const & to   );                            // time, but the patch only grows with the change, not with the grocery lists
 
 
     // Accessors
     std::size_t find( const GroceryItem & groceryItem ) const;                                // returns the grocery item's (zero-based) offset from top, size() if grocery item not found
 
+    using Items = std::vector<GroceryItem const *>;                                          // the grocery items selected by a query.  They're this list's own grocery items, not
+                                                                                              // copies, valid until the list is next modified
+    Items priceRange( Money low, Money high ) const;                                          // returns the grocery items priced from low through high, cheapest first
+    Items cheapest  ( std::size_t count     ) const;                                          // returns the count (or size(), if fewer) cheapest grocery items, cheapest first
+    Items byName    (                       ) const;                                          // returns every grocery item, ordered by product name
+                                                                                              // All three take O(log n + k) time when ordered(), O(n log n) time otherwise.  Grocery
+                                                                                              // items with equal prices or names come in list order
+
+    Items startingWith( std::string_view prefix ) const;                                      // returns the grocery items whose product or brand name starts with prefix, in list order
+    Items containing  ( std::string_view text   ) const;                                      // returns the grocery items whose product or brand name contains text, in list order
+                                                                                              // Both ignore ASCII letter case, and take time proportional to the matches (and for
+                                                                                              // containing(), the candidates sharing text's rarest trigram) when searchable()
+
 
     // Modifiers
     void insert   ( GroceryItem const & groceryItem, Position    position = Position::TOP );  // inserts the grocery item at the top (beginning) or bottom (end) of the grocery list
     void insert   ( GroceryItem const & groceryItem, std::size_t offsetFromTop            );  // inserts before the existing grocery item currently at that offset
 
+    template<std::input_iterator InputIt>                                                     // inserts grocery items [first, last), in order, before the existing grocery item
+    void insert   ( InputIt first, InputIt last, std::size_t offsetFromTop                 ); // currently at that offset.  Duplicates are skipped, just like inserting one at a time
+
+    template<std::ranges::input_range Range>
+    void appendRange( Range && groceryItems                                               );  // inserts a range of grocery items, in order, at the bottom of the grocery list
+
     void remove   ( GroceryItem const & groceryItem                                       );  // no change occurs if grocery item not found
     void remove   ( std::size_t         offsetFromTop                                     );  // no change occurs if (zero-based) offsetFromTop >= size()
 
     void moveToTop( GroceryItem const & groceryItem                                       );  // finds then moves grocery item from its current position to the top of the grocery list
 
-    GroceryList & operator+=( std::initializer_list<GroceryItem> const & rhs );               // appends (aka concatenates) a braced list of grocery items to the end of this list
-    GroceryList & operator+=( GroceryList                        const & rhs );               // appends (aka concatenates) the rhs list to the bottom of this list
+    void apply    ( GroceryListPatch const & patch                                        );  // replays the patch's edits, in order.  Throws GroceryListPatch::Mismatch_Ex, changing
+                                                                                              // nothing, if this isn't the grocery list the patch was made from (the same grocery
+                                                                                              // items in the same order), or if an edit doesn't fit it.  The checks take time with
+                                                                                              // the patch, not the list, once apply() made the last change and if the list is
+                                                                                              // indexed (or its storage policy locates or screens grocery items).  The edits cost
+                                                                                              // what they would made one by one
+
+    BasicGroceryList & operator+=( std::initializer_list<GroceryItem> const & rhs );          // appends (aka concatenates) a braced list of grocery items to the end of this list
+    BasicGroceryList & operator+=( BasicGroceryList                   const & rhs );          // appends (aka concatenates) the rhs list to the bottom of this list
+
+    BasicGroceryList & indexed   ( bool enabled                                 ) &;          // opts in (true) or out (false) of maintaining a hash index of this list's grocery items.
+                                                                                              // No effect with a LocatingStorage policy, which is always its own index.  A
+                                                                                              // ScreeningStorage policy needs no index to turn away grocery items it doesn't hold,
+                                                                                              // but finds the ones it does by a linear search unless indexed
+    BasicGroceryList & ordered   ( bool enabled                                 ) &;          // opts in (true) or out (false) of maintaining sorted indexes by price and product name
+    BasicGroceryList & searchable( bool enabled                                 ) &;          // opts in (true) or out (false) of maintaining a product and brand name search index
 
 
     // Relational Operators
-    std::weak_ordering operator<=>( GroceryList const & rhs ) const;
-    bool               operator== ( GroceryList const & rhs ) const;
+    std::weak_ordering operator<=>( BasicGroceryList const & rhs ) const;
+    bool               operator== ( BasicGroceryList const & rhs ) const;
 
 
   private:
     // Instance Attributes
-    std::array       <GroceryItem, 11>  _gList_array;                                         // underlying containers holding grocery items
-    std::vector      <GroceryItem    >  _gList_vector;                                        // operations performed on once container must be
-    std::list        <GroceryItem    >  _gList_dll;                                           // replicated across all containers
-    std::forward_list<GroceryItem    >  _gList_sll;
-
-    std::size_t                         _gList_array_size = 0;                                // number of valid elements in _gList_array
+    StoragePolicy                       _storage;                                             // the grocery items, top to bottom
+    std::optional<GroceryListIndex>     _index;                                               // opt-in secondary index:  grocery item -> offset from top
+
+    struct ContentHash                                                                        // the sum of every grocery item's mixed hash (see itemHash()).  A sum
+    {                                                                                         // is updated in constant time wherever a grocery item comes or goes,
+      std::size_t value = 0;                                                                  // and moving a grocery item to the top doesn't change it at all.
+                                                                                              // Moving from a grocery list leaves its storage empty, and this 0 to
+      ContentHash() = default;                                                                // match
+      ContentHash( ContentHash const &  ) = default;
+      ContentHash( ContentHash       && other ) noexcept : value( std::exchange( other.value, 0 ) ) {}
+      ContentHash & operator=( ContentHash const &  ) = default;
+      ContentHash & operator=( ContentHash       && rhs ) noexcept { value = std::exchange( rhs.value, 0 ); return *this; }
+    } _contentHash;
+
+    struct OrderedHash                                                                        // orderedHash() as the last patch applied left it, so the next patch's
+    {                                                                                         // base is checked without walking the grocery list.  Any other change
+      std::optional<std::size_t> value;                                                       // forgets it, as does moving from the grocery list
+
+      OrderedHash() = default;
+      OrderedHash( OrderedHash const &  ) = default;
+      OrderedHash( OrderedHash       && other ) noexcept : value( std::exchange( other.value, std::nullopt ) ) {}
+      OrderedHash & operator=( OrderedHash const &  ) = default;
+      OrderedHash & operator=( OrderedHash       && rhs ) noexcept { value = std::exchange( rhs.value, std::nullopt ); return *this; }
+    } _orderedHash;
+
+    struct OrderedIndexes
+    {
+      GroceryListOrderedIndex<Money           > byPrice;
+      GroceryListOrderedIndex<std::pmr::string> byName;
+    };
+    std::optional<OrderedIndexes>       _ordered;                                             // opt-in secondary indexes:  price -> offset, product name -> offset
+    std::optional<GroceryListSearchIndex> _search;                                            // opt-in secondary index:  name prefix or substring -> offsets
 
 
     // Helper member functions
-    bool        containersAreConsistant() const;
-    std::size_t gList_sll_size         () const;                                              // std::forward_list doesn't maintain size, so calculate it on demand
+    bool        containersAreConsistant() const;                                              // applies the consistencyChecks policy
+    static std::size_t itemHash( std::size_t hash ) noexcept;                                 // a grocery item's std::hash mixed so sums of them stay well distributed
+    std::size_t orderedHash() const noexcept;                                                 // a hash of the grocery items in order, unlike hash().  Identifies a patch's base
+    OrderedIndexes orderedIndexes() const;                                                    // sorted indexes of the current content, built from scratch
+    GroceryItem::allocator_type allocator() const noexcept;                                   // the storage's (see AllocatorAwareStorage), so a batch gathered with it moves into
+                                                                                              // the storage without its product names being copied again
+    template<typename Iterator>
+    Items       itemsAt     ( Iterator first, Iterator last ) const;                          // the grocery items at the offsets [first, last) (or those of index entries), in that order
+    void        insertBatch ( std::vector<GroceryItem> && batch, std::size_t offsetFromTop ); // one duplicate pass, one gap, and one consistency check for the whole batch
+    void        insertUnique( std::vector<GroceryItem> && batch, std::size_t offsetFromTop ); // same, less the duplicate pass - the caller guarantees there are none
+};
+
+
+
+
+
+
+
+
+// Hash support so grocery lists can be used as keys in unordered containers, consistent with operator==
+template<typename StoragePolicy>
+struct std::hash<BasicGroceryList<StoragePolicy>>
+{
+  std::size_t operator()( BasicGroceryList<StoragePolicy> const & groceryList ) const noexcept { return groceryList.hash(); }
 };
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Member function templates
+*******************************************************************************/
+
+// insert( range )
+template<typename StoragePolicy>
+template<std::input_iterator InputIt>
+void BasicGroceryList<StoragePolicy>::insert( InputIt first, InputIt last, std::size_t offsetFromTop )
+{
+  // Gather the grocery items up front.  The range may well be this grocery list's own grocery items, and the insertion shouldn't
+  // pull the rug out from under it.
+  std::vector<GroceryItem> batch;
+  if constexpr( std::forward_iterator<InputIt> )   batch.reserve( static_cast<std::size_t>( std::distance( first, last ) ) );
+
+  for( ;  first != last;  ++first )   batch.emplace_back( *first, allocator() );
+  insertBatch( std::move( batch ), offsetFromTop );
+}
+
+
+
+// appendRange()
+template<typename StoragePolicy>
+template<std::ranges::input_range Range>
+void BasicGroceryList<StoragePolicy>::appendRange( Range && groceryItems )
+{
+  std::vector<GroceryItem> batch;
+  if constexpr( std::ranges::sized_range<Range> )   batch.reserve( std::ranges::size( groceryItems ) );
+
+  for( auto && groceryItem : groceryItems )   batch.emplace_back( groceryItem, allocator() );
+  insertBatch( std::move( batch ), size() );
+}
@@ -0,0 +1,63 @@
+#pragma once                                                                                  // include guard
+
+#include <cstddef>                                                                            // size_t
+#include <cstdint>                                                                            // uint64_t
+#include <stdexcept>                                                                          // domain_error, length_error, logic_error
+
+
+
+// Internal container consistency checking is selected at build time.  Define GROCERY_LIST_CHECKS as one of
+//    FULL     every check walks and compares all containers element by element (and the hash index, if any)
+//    SAMPLED  every check compares container sizes, and every GroceryListBase::checkSampleInterval-th check is FULL
+//    SIZES    every check compares only the sizes that are known in constant time
+//    NONE     no checks at all, they compile away to nothing
+// for example "-DGROCERY_LIST_CHECKS=SAMPLED".  Build_vsc.sh passes it along from the environment.  When not defined, debug builds
+// get FULL checks and release (NDEBUG) builds get none.
+#ifndef GROCERY_LIST_CHECKS
+  #ifdef NDEBUG
+    #define GROCERY_LIST_CHECKS NONE
+  #else
+    #define GROCERY_LIST_CHECKS FULL
+  #endif
+#endif
+
+
+
+// Types, exceptions, and build policies shared by every grocery list regardless of how it stores its grocery items.  Sharing them
+// means, for example, GroceryList::Position::TOP can be passed to any grocery list, and catching GroceryList::InvalidOffset_Ex
+// catches it no matter which storage policy threw it.
+class GroceryListBase
+{
+  public:
+    // Types and Exceptions
+    enum class Position {TOP, BOTTOM};
+    enum class Checks   {NONE, SIZES, SAMPLED, FULL};
+
+    struct InvalidInternalState_Ex : std::domain_error { using domain_error::domain_error; }; // Thrown if internal data structures become inconsistent with each other
+    struct CapacityExceeded_Ex     : std::length_error { using length_error::length_error; }; // Thrown if more grocery items are inserted than will fit
+    struct InvalidOffset_Ex        : std::logic_error  { using logic_error ::logic_error;  }; // Thrown if inserting beyond current size
+
+
+    // Build Policies
+    static constexpr Checks      consistencyChecks   = Checks::GROCERY_LIST_CHECKS;         // this build's container consistency checking policy
+    static constexpr std::size_t checkSampleInterval = 64;                                    // with Checks::SAMPLED, how often a check is a full check
+};
+
+
+
+// The SplitMix64 finalizer, a bijection whose every output bit depends on every input bit.  Grocery lists mix grocery item hashes
+// with it (see BasicGroceryList::itemHash()), and the tree storage policies draw node priorities from it.
+constexpr std::uint64_t splitMix64( std::uint64_t value ) noexcept
+{
+  value = ( value ^ ( value >> 30 ) ) * 0xbf58'476d'1ce4'e5b9ULL;
+  value = ( value ^ ( value >> 27 ) ) * 0x94d0'49bb'1331'11ebULL;
+  return value ^ ( value >> 31 );
+}
+
+
+
+// The SplitMix64 generator:  advances state by the golden ratio increment and returns the next pseudo random number
+constexpr std::uint64_t nextSplitMix64( std::uint64_t & state ) noexcept
+{
+  return splitMix64( state += 0x9e37'79b9'7f4a'7c15ULL );
+}
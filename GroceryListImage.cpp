@@ -0,0 +1,215 @@
+#include <cstddef>                                                                  // size_t
+#include <cstdint>                                                                  // uint32_t, uint64_t, int64_t
+#include <cstring>                                                                  // memcpy(), memcmp()
+#include <limits>                                                                   // numeric_limits
+#include <stdexcept>                                                                // length_error, logic_error
+#include <string>
+#include <string_view>
+#include <type_traits>                                                              // is_trivially_copyable_v
+#include <utility>                                                                  // move()
+
+#include "GroceryItem.hpp"
+#include "GroceryListImage.hpp"
+#include "Money.hpp"
+
+
+
+
+/*******************************************************************************
+**  Implementation of non-member private types, objects, and functions
+*******************************************************************************/
+namespace    // unnamed, anonymous namespace
+{
+  // The on-disk layout.  Both are copied in and out with memcpy(), so nothing depends on the bytes being aligned.
+  struct Header
+  {
+    char          magic[4];
+    std::uint32_t version;
+    std::uint64_t count;                                                            // grocery items, and so records
+    std::uint64_t blobSize;                                                         // bytes
+    std::uint64_t reserved;                                                         // zero, room for flags in later versions
+  };
+
+  struct Record
+  {
+    std::int64_t  priceMills;
+    std::uint32_t upcCode;                                                          // blob offsets
+    std::uint32_t brandName;
+    std::uint32_t productName;
+    std::uint32_t reserved;                                                         // zero, keeps records a multiple of 8 bytes
+  };
+
+  static_assert( sizeof( Header ) == 32  &&  std::is_trivially_copyable_v<Header>, "the header's layout is part of the format" );
+  static_assert( sizeof( Record ) == 24  &&  std::is_trivially_copyable_v<Record>, "the records' layout is part of the format" );
+
+  constexpr char          MAGIC[4]   = { 'G', 'L', 'S', 'T' };
+  constexpr std::size_t   PREFIX     = sizeof( std::uint32_t );                     // the length ahead of each string in the blob
+  constexpr std::uint32_t MAX_OFFSET = std::numeric_limits<std::uint32_t>::max();
+}    // unnamed, anonymous namespace
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  GroceryListImage - Constructors
+*******************************************************************************/
+
+// Constructor
+GroceryListImage::GroceryListImage( std::string_view bytes )
+{
+  Header header;
+  if( bytes.size() < sizeof( header ) )   throw MalformedImage_Ex( "Grocery list image:  too short for a header" );
+  std::memcpy( &header, bytes.data(), sizeof( header ) );
+
+  // A version written in the other byte order reads as a huge number, so this also rejects images from the wrong kind of machine
+  if( std::memcmp( header.magic, MAGIC, sizeof( MAGIC ) ) != 0 )   throw MalformedImage_Ex( "Grocery list image:  not a grocery list image" );
+  if( header.version != VERSION )                                  throw MalformedImage_Ex( "Grocery list image:  unsupported version " + std::to_string( header.version ) );
+
+  auto const available = bytes.size() - sizeof( header );
+  if( header.count > available / sizeof( Record ) )                throw MalformedImage_Ex( "Grocery list image:  record table truncated" );
+
+  auto const recordsSize = header.count * sizeof( Record );
+  if( header.blobSize != available - recordsSize )                 throw MalformedImage_Ex( "Grocery list image:  blob size doesn't match the file" );
+
+  _records = bytes.substr( sizeof( header ), recordsSize );
+  _blob    = bytes.substr( sizeof( header ) + recordsSize );
+  _size    = header.count;
+
+  // Check every record's strings lie within the blob once, here, so viewing grocery items later needn't
+  auto fits = [this]( std::uint32_t offset ) noexcept
+  {
+    if( _blob.size() < PREFIX  ||  offset > _blob.size() - PREFIX ) return false;
+
+    std::uint32_t length;
+    std::memcpy( &length, _blob.data() + offset, PREFIX );
+    return length <= _blob.size() - PREFIX - offset;
+  };
+
+  for( std::size_t i = 0; i < _size; ++i )
+  {
+    Record record;
+    std::memcpy( &record, _records.data() + i * sizeof( Record ), sizeof( Record ) );
+    if( !fits( record.upcCode )  ||  !fits( record.brandName )  ||  !fits( record.productName ) )
+    {
+      throw MalformedImage_Ex( "Grocery list image:  record " + std::to_string( i ) + " refers outside the blob" );
+    }
+  }
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  GroceryListImage - Queries
+*******************************************************************************/
+
+// size() const
+std::size_t GroceryListImage::size() const noexcept
+{
+  return _size;
+}
+
+
+
+// operator[]() const
+GroceryListImage::Item GroceryListImage::operator[]( std::size_t position ) const noexcept
+{
+  Record record;
+  std::memcpy( &record, _records.data() + position * sizeof( Record ), sizeof( Record ) );
+
+  return { stringAt( record.upcCode ), stringAt( record.brandName ), stringAt( record.productName ), Money::fromMills( record.priceMills ) };
+}
+
+
+
+// stringAt() const
+std::string_view GroceryListImage::stringAt( std::uint32_t offset ) const noexcept
+{
+  std::uint32_t length;
+  std::memcpy( &length, _blob.data() + offset, PREFIX );
+  return { _blob.data() + offset + PREFIX, length };
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  GroceryListImage::Builder
+*******************************************************************************/
+
+// Constructor
+GroceryListImage::Builder::Builder( std::size_t count )
+  : _count( count )
+{
+  // The header and record table are a fixed size, so they're laid out up front and the blob grows after them.  The reserve is a
+  // guess, grocery items typically carry somewhat less text than this.
+  _bytes.reserve( sizeof( Header ) + count * ( sizeof( Record ) + 64 ) );
+  _bytes.resize ( sizeof( Header ) + count *   sizeof( Record )        );
+}
+
+
+
+// add()
+void GroceryListImage::Builder::add( GroceryItem const & groceryItem )
+{
+  if( _added == _count )   throw std::length_error( "Grocery list image:  more grocery items added than the image was built for" );
+
+  Record record{};
+  record.priceMills  = groceryItem.exactPrice().mills();
+  record.upcCode     = append( groceryItem.upcCode() );
+  record.productName = append( groceryItem.productName() );
+
+  // Brand names repeat a lot, so each brand's text is stored once
+  auto const & brandName = groceryItem.brandName();
+  if( auto const found = _brands.find( brandName );  found != _brands.end() )   record.brandName = found->second;
+  else                                                                          record.brandName = _brands.emplace( brandName, append( brandName ) ).first->second;
+
+  std::memcpy( _bytes.data() + sizeof( Header ) + _added * sizeof( Record ), &record, sizeof( Record ) );
+  ++_added;
+}
+
+
+
+// finish()
+std::string GroceryListImage::Builder::finish() &&
+{
+  if( _added != _count )   throw std::logic_error( "Grocery list image:  fewer grocery items added than the image was built for" );
+
+  Header header{};
+  std::memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+  header.version  = VERSION;
+  header.count    = _count;
+  header.blobSize = _bytes.size() - sizeof( Header ) - _count * sizeof( Record );
+  std::memcpy( _bytes.data(), &header, sizeof( Header ) );
+
+  return std::move( _bytes );
+}
+
+
+
+// append()
+std::uint32_t GroceryListImage::Builder::append( std::string_view text )
+{
+  auto const offset = _bytes.size() - sizeof( Header ) - _count * sizeof( Record );
+  if( offset > MAX_OFFSET  ||  text.size() > MAX_OFFSET )   throw std::length_error( "Grocery list image:  more than 4 GiB of text" );
+
+  auto const length = static_cast<std::uint32_t>( text.size() );
+  char       prefix[PREFIX];
+  std::memcpy( prefix, &length, PREFIX );
+
+  _bytes.append( prefix, PREFIX );
+  _bytes.append( text );
+  return static_cast<std::uint32_t>( offset );
+}
@@ -0,0 +1,90 @@
+#pragma once                                                                                  // include guard
+
+#include <cstddef>                                                                            // size_t
+#include <cstdint>                                                                            // uint32_t
+#include <stdexcept>                                                                          // runtime_error
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "GroceryItem.hpp"
+#include "Money.hpp"
+
+
+// A compact binary image of a sequence of grocery items, for checkpointing grocery lists without the text format's quoting,
+// escaping, and number formatting.  An image is laid out as
+//
+//    header    magic "GLST", format version, grocery item count, and blob size
+//    records   one fixed size record per grocery item:  its price in mills and the blob offsets of its UPC code, brand, and
+//              product name
+//    blob      the strings, each a 32-bit length followed by that many bytes.  Brand names are stored once and shared.
+//
+// in the writing machine's byte order (an image from a machine of the other order fails the version check).  A Builder lays an
+// image out in a single buffer, so it's written with one write() call.  Reading validates an image once, up front, then views its
+// grocery items in place - string views into the image, no allocation - so a memory mapped file (see MappedFile) can be read
+// without copying it.
+class GroceryListImage
+{
+  public:
+    static constexpr std::uint32_t VERSION = 1;                                               // the only format version so far
+
+    // Exceptions
+    struct MalformedImage_Ex : std::runtime_error { using runtime_error::runtime_error; };   // Thrown if the bytes aren't an image this version can read
+
+    struct Item                                                                               // a view of one grocery item, valid as long as the image's bytes are
+    {
+      std::string_view upcCode;
+      std::string_view brandName;
+      std::string_view productName;
+      Money            price;
+    };
+
+    class Builder;
+
+
+    // Constructors
+    explicit GroceryListImage( std::string_view bytes );                                      // validates the image, which must outlive this object
+
+
+    // Queries
+    std::size_t size      (                      ) const noexcept;                            // returns the number of grocery items in the image
+    Item        operator[]( std::size_t position ) const noexcept;                            // the grocery item at position, which must be less than size()
+
+
+  private:
+    // Instance Attributes
+    std::string_view _records;                                                                // the record table
+    std::string_view _blob;                                                                   // the strings the records refer to
+    std::size_t      _size = 0;
+
+
+    // Helper member functions
+    std::string_view stringAt( std::uint32_t offset ) const noexcept;                         // the length prefixed string at offset into the blob
+};
+
+
+
+// Lays out an image of a known number of grocery items, added one at a time
+class GroceryListImage::Builder
+{
+  public:
+    // Constructors
+    explicit Builder( std::size_t count );                                                    // an image of exactly count grocery items
+
+
+    // Modifiers
+    void        add   ( GroceryItem const & groceryItem );                                    // appends the next grocery item.  Throws std::length_error past count items or 4 GiB of text
+    std::string finish(                               ) &&;                                   // returns the finished image.  Throws std::logic_error if fewer than count items were added
+
+
+  private:
+    // Instance Attributes
+    std::string                                            _bytes;                            // header, records, then the blob as it grows
+    std::size_t                                            _count;
+    std::size_t                                            _added = 0;
+    std::unordered_map<std::string, std::uint32_t>         _brands;                           // brand name -> its offset in the blob
+
+
+    // Helper member functions
+    std::uint32_t append( std::string_view text );                                            // adds a length prefixed string to the blob, returns its offset
+};
@@ -0,0 +1,174 @@
+#include <cstddef>                                                                  // size_t, ptrdiff_t
+#include <utility>                                                                  // swap()
+#include <vector>
+
+#include "GroceryListIndex.hpp"
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// size() const
+std::size_t GroceryListIndex::size() const noexcept
+{
+  return _size;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// insertAt()
+void GroceryListIndex::insertAt( std::size_t hash, std::size_t offset )
+{
+  reserve( _size + 1 );
+  shift( offset, 1 );                                                               // make room, offsets are dense so nothing moves when appending
+  place( hash, offset );
+}
+
+
+
+// insertAt( batch )
+void GroceryListIndex::insertAt( std::vector<std::size_t> const & hashes, std::size_t offset )
+{
+  if( hashes.empty() ) return;
+
+  reserve( _size + hashes.size() );                                                 // at most one rehash for the whole batch
+  shift( offset, static_cast<std::ptrdiff_t>( hashes.size() ) );                    // and one renumbering pass
+  for( auto const hash : hashes )   place( hash, offset++ );
+}
+
+
+
+// eraseAt()
+void GroceryListIndex::eraseAt( std::size_t hash, std::size_t offset )
+{
+  if( _size == 0 ) return;
+
+  // Locate the slot holding this offset
+  auto const mask = _slots.size() - 1;
+  auto       i    = home( hash );
+  while( _slots[i].offset != npos  &&  _slots[i].offset != offset )   i = ( i + 1 ) & mask;
+  if( _slots[i].offset == npos ) return;                                            // not indexed, nothing to do
+
+  // Backward shift deletion.  Rather than leaving a tombstone, pull later members of the cluster back into the hole when doing so
+  // doesn't move them in front of their home slot.  This keeps lookups from degrading as grocery items come and go.
+  for( auto j = ( i + 1 ) & mask;  _slots[j].offset != npos;  j = ( j + 1 ) & mask )
+  {
+    auto const k = home( _slots[j].hash );
+
+    bool const staysPut = i <= j ? ( i < k  &&  k <= j )                            // is k cyclically within (i, j] ?
+                                 : ( i < k  ||  k <= j );
+    if( staysPut ) continue;
+
+    _slots[i] = _slots[j];
+    i = j;
+  }
+
+  _slots[i] = {};
+  --_size;
+
+  shift( offset + 1, -1 );                                                       // close the gap, nothing moves when removing from the bottom
+}
+
+
+
+// reserve()
+void GroceryListIndex::reserve( std::size_t count )
+{
+  // Keep the load factor at or below 1/2 so probe sequences stay short
+  if( 2 * count <= _slots.size() ) return;
+
+  auto newCapacity = _slots.empty() ? std::size_t{ 16 } : 2 * _slots.size();
+  while( 2 * count > newCapacity )   newCapacity *= 2;
+  rehash( newCapacity );
+}
+
+
+
+// clear()
+void GroceryListIndex::clear() noexcept
+{
+  _slots.clear();
+  _size = 0;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Private member functions
+*******************************************************************************/
+
+// home() const
+std::size_t GroceryListIndex::home( std::size_t hash ) const noexcept
+{
+  return hash & ( _slots.size() - 1 );
+}
+
+
+
+// shift()
+void GroceryListIndex::shift( std::size_t from, std::ptrdiff_t delta ) noexcept
+{
+  // Offsets are dense, so when from is beyond the largest offset recorded there's nothing to renumber.  That's always the case
+  // when appending to or removing from the bottom of the list.  (Shifting happens before inserting but after erasing, hence the
+  // different limits.)
+  if( from >= _size + ( delta > 0 ? 0 : 1 ) ) return;
+
+  for( auto & slot : _slots )
+  {
+    if( slot.offset == npos  ||  slot.offset < from ) continue;
+    slot.offset = static_cast<std::size_t>( static_cast<std::ptrdiff_t>( slot.offset ) + delta );
+  }
+}
+
+
+
+// place()
+void GroceryListIndex::place( std::size_t hash, std::size_t offset ) noexcept
+{
+  auto const mask = _slots.size() - 1;
+  auto       i    = home( hash );
+  while( _slots[i].offset != npos )   i = ( i + 1 ) & mask;
+
+  _slots[i] = { hash, offset };
+  ++_size;
+}
+
+
+
+// rehash()
+void GroceryListIndex::rehash( std::size_t newCapacity )
+{
+  std::vector<Slot> oldSlots( newCapacity );
+  std::swap( oldSlots, _slots );
+
+  auto const mask = _slots.size() - 1;
+  for( auto const & slot : oldSlots )
+  {
+    if( slot.offset == npos ) continue;
+
+    auto i = home( slot.hash );
+    while( _slots[i].offset != npos )   i = ( i + 1 ) & mask;
+    _slots[i] = slot;
+  }
+}
@@ -0,0 +1,85 @@
+#pragma once                                                                                  // include guard
+
+#include <cstddef>                                                                            // size_t, ptrdiff_t
+#include <functional>                                                                         // hash
+#include <vector>
+
+#include "GroceryItem.hpp"
+
+
+// An open addressing (linear probing) hash table answering "is this grocery item present, and at what offset" in O(1) expected time.
+//
+// The index doesn't hold grocery items, only each item's hash value and its (zero-based) offset from the top of the owning grocery
+// list.  Candidate offsets are confirmed by asking the owner for the grocery item at that offset, so the index never disagrees with
+// the owner about what equality means.  Offsets are always dense (0 through size()-1), so inserting or removing at the bottom of
+// the list never needs to renumber anything.  Inserting or removing anywhere else renumbers the trailing offsets, which is a walk
+// over plain integers - much cheaper than the grocery item comparisons it replaces.
+class GroceryListIndex
+{
+  public:
+    static constexpr std::size_t npos = static_cast<std::size_t>( -1 );                       // returned by find() when not found
+
+
+    // Queries
+    std::size_t size() const noexcept;                                                        // returns the number of grocery items indexed
+
+
+    // Accessors
+    template<typename ItemAt>                                                                 // itemAt( offset ) returns the owner's grocery item at that offset
+    std::size_t find( GroceryItem const & groceryItem, std::size_t hash, ItemAt itemAt ) const;  // returns the grocery item's offset, npos if not found
+
+
+    // Modifiers
+    void insertAt( std::size_t hash, std::size_t offset );                                   // records a new grocery item at offset, renumbering the offsets at and after it (+1)
+    void insertAt( std::vector<std::size_t> const & hashes, std::size_t offset );             // records a batch of new grocery items starting at offset, renumbering once (+hashes.size())
+    void eraseAt ( std::size_t hash, std::size_t offset );                                   // forgets the grocery item at offset, renumbering the offsets after it (-1)
+    void clear   (                                      ) noexcept;
+    void reserve ( std::size_t count                    );                                   // grow, if needed, so count grocery items keep the load factor at or below 1/2
+
+
+  private:
+    struct Slot
+    {
+      std::size_t hash   = 0;
+      std::size_t offset = npos;                                                              // npos marks an empty slot
+    };
+
+    // Instance Attributes
+    std::vector<Slot> _slots;                                                                 // capacity is always zero or a power of two
+    std::size_t       _size = 0;                                                              // number of occupied slots
+
+
+    // Helper member functions
+    std::size_t home   ( std::size_t hash                      ) const noexcept;              // preferred slot for a hash value
+    void        shift  ( std::size_t from, std::ptrdiff_t delta ) noexcept;                   // renumber offsets at and after from
+    void        place  ( std::size_t hash, std::size_t offset  ) noexcept;                    // store into the first free slot of hash's probe sequence
+    void        rehash ( std::size_t newCapacity               );
+};
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Member function templates
+*******************************************************************************/
+
+// find() const
+template<typename ItemAt>
+std::size_t GroceryListIndex::find( GroceryItem const & groceryItem, std::size_t hash, ItemAt itemAt ) const
+{
+  if( _size == 0 ) return npos;
+
+  // Probe until an empty slot ends the cluster.  Comparing hash values first means grocery items are compared only on a (very
+  // likely) match.
+  auto const mask = _slots.size() - 1;
+  for( auto i = home( hash ); _slots[i].offset != npos; i = ( i + 1 ) & mask )
+  {
+    if( _slots[i].hash == hash  &&  itemAt( _slots[i].offset ) == groceryItem ) return _slots[i].offset;
+  }
+
+  return npos;
+}
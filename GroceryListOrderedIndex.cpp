@@ -0,0 +1,165 @@
+#include <algorithm>                                                                // lower_bound(), upper_bound(), sort(), inplace_merge()
+#include <cstddef>                                                                  // size_t, ptrdiff_t
+#include <iterator>                                                                 // next()
+#include <memory_resource>                                                          // pmr::string
+#include <string>
+#include <utility>                                                                  // move()
+#include <vector>
+
+#include "GroceryListOrderedIndex.hpp"
+#include "Money.hpp"
+
+
+
+
+/*******************************************************************************
+**  Implementation of non-member private types, objects, and functions
+*******************************************************************************/
+namespace    // unnamed, anonymous namespace
+{
+  // Entries order by key, then offset
+  template<typename Entry>
+  bool precedes( Entry const & lhs, Entry const & rhs )
+  {
+    if( lhs.key < rhs.key ) return true;
+    if( rhs.key < lhs.key ) return false;
+    return lhs.offset < rhs.offset;
+  }
+}    // unnamed, anonymous namespace
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+template<typename Key>  std::size_t                                       GroceryListOrderedIndex<Key>::size () const noexcept  { return _entries.size();   }
+template<typename Key>  typename GroceryListOrderedIndex<Key>::const_iterator GroceryListOrderedIndex<Key>::begin() const noexcept  { return _entries.cbegin(); }
+template<typename Key>  typename GroceryListOrderedIndex<Key>::const_iterator GroceryListOrderedIndex<Key>::end  () const noexcept  { return _entries.cend();   }
+
+
+
+// lowerBound() const
+template<typename Key>
+typename GroceryListOrderedIndex<Key>::const_iterator GroceryListOrderedIndex<Key>::lowerBound( Key const & key ) const
+{
+  return std::lower_bound( _entries.cbegin(), _entries.cend(), key, []( Entry const & entry, Key const & value ) { return entry.key < value; } );
+}
+
+
+
+// upperBound() const
+template<typename Key>
+typename GroceryListOrderedIndex<Key>::const_iterator GroceryListOrderedIndex<Key>::upperBound( Key const & key ) const
+{
+  return std::upper_bound( _entries.cbegin(), _entries.cend(), key, []( Key const & value, Entry const & entry ) { return value < entry.key; } );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// insertAt()
+template<typename Key>
+void GroceryListOrderedIndex<Key>::insertAt( Key key, std::size_t offset )
+{
+  shift( offset, 1 );                                                               // make room, offsets are dense so nothing moves when appending
+
+  Entry entry{ std::move( key ), offset };
+  auto const position = std::lower_bound( _entries.begin(), _entries.end(), entry, precedes<Entry> );
+  _entries.insert( position, std::move( entry ) );
+}
+
+
+
+// insertAt( batch )
+template<typename Key>
+void GroceryListOrderedIndex<Key>::insertAt( std::vector<Key> && keys, std::size_t offset )
+{
+  if( keys.empty() ) return;
+
+  // One renumbering pass, then sort just the batch and merge it in, rather than a binary search and a shift for every grocery item
+  shift( offset, static_cast<std::ptrdiff_t>( keys.size() ) );
+
+  auto const oldSize = static_cast<std::ptrdiff_t>( _entries.size() );
+  _entries.reserve( _entries.size() + keys.size() );
+  for( auto & key : keys )   _entries.push_back( { std::move( key ), offset++ } );
+
+  auto const middle = std::next( _entries.begin(), oldSize );
+  std::sort         ( middle,            _entries.end(), precedes<Entry> );
+  std::inplace_merge( _entries.begin(), middle, _entries.end(), precedes<Entry> );
+}
+
+
+
+// eraseAt()
+template<typename Key>
+void GroceryListOrderedIndex<Key>::eraseAt( Key const & key, std::size_t offset )
+{
+  auto const position = std::lower_bound( _entries.begin(), _entries.end(), Entry{ key, offset }, precedes<Entry> );
+  if( position == _entries.end()  ||  position->offset != offset ) return;
+
+  _entries.erase( position );
+  shift( offset + 1, -1 );                                                          // close the gap, nothing moves when removing from the bottom
+}
+
+
+
+// clear()
+template<typename Key>
+void GroceryListOrderedIndex<Key>::clear() noexcept
+{
+  _entries.clear();
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Private member functions
+*******************************************************************************/
+
+// shift()
+template<typename Key>
+void GroceryListOrderedIndex<Key>::shift( std::size_t from, std::ptrdiff_t delta ) noexcept
+{
+  // Offsets are dense, so when from is beyond the largest offset recorded there's nothing to renumber.  (Shifting happens before
+  // inserting but after erasing, hence the different limits.)
+  if( from >= _entries.size() + ( delta > 0 ? 0 : 1 ) ) return;
+
+  for( auto & entry : _entries )
+  {
+    if( entry.offset < from ) continue;
+    entry.offset = static_cast<std::size_t>( static_cast<std::ptrdiff_t>( entry.offset ) + delta );
+  }
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Explicit instantiations
+*******************************************************************************/
+
+template class GroceryListOrderedIndex<Money           >;                           // by price
+template class GroceryListOrderedIndex<std::pmr::string>;                           // by product name
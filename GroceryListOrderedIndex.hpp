@@ -0,0 +1,49 @@
+#pragma once                                                                                  // include guard
+
+#include <cstddef>                                                                            // size_t, ptrdiff_t
+#include <vector>
+
+
+// A sorted index answering "which grocery items have keys in this range, in key order" in O(log n + k) time.  Like
+// GroceryListIndex, it doesn't hold grocery items, only each grocery item's key (its price, or its product name) and its offset
+// from the top of the owning grocery list.  Entries are kept sorted by key, and grocery items with equal keys by offset, so they
+// come out in list order.  Renumbering offsets never changes that order, so inserting or removing anywhere in the list is a binary
+// search, a walk over plain integers to renumber, and a shift of the entries after the one inserted or removed.
+//
+// Implemented in GroceryListOrderedIndex.cpp and explicitly instantiated there for the keys BasicGroceryList uses.
+template<typename Key>
+class GroceryListOrderedIndex
+{
+  public:
+    struct Entry
+    {
+      Key         key;
+      std::size_t offset;
+    };
+
+    using const_iterator = typename std::vector<Entry>::const_iterator;
+
+
+    // Queries
+    std::size_t    size      (                 ) const noexcept;                              // returns the number of grocery items indexed
+    const_iterator begin     (                 ) const noexcept;                              // all the entries, in key order
+    const_iterator end       (                 ) const noexcept;
+    const_iterator lowerBound( Key const & key ) const;                                       // the first entry whose key is not less than key
+    const_iterator upperBound( Key const & key ) const;                                       // the first entry whose key is greater than key
+
+
+    // Modifiers
+    void insertAt( Key               key,  std::size_t offset );                              // records a new grocery item at offset, renumbering the offsets at and after it (+1)
+    void insertAt( std::vector<Key> && keys, std::size_t offset );                            // records a batch of new grocery items starting at offset, renumbering once (+keys.size())
+    void eraseAt ( Key const &       key,  std::size_t offset );                              // forgets the grocery item at offset, renumbering the offsets after it (-1)
+    void clear   (                                            ) noexcept;
+
+
+  private:
+    // Instance Attributes
+    std::vector<Entry> _entries;                                                              // sorted by key, then offset
+
+
+    // Helper member functions
+    void shift( std::size_t from, std::ptrdiff_t delta ) noexcept;                            // renumber offsets at and after from
+};
@@ -0,0 +1,104 @@
+#include <cstddef>                                                                  // size_t
+#include <ios>                                                                      // ios::floatfield, ios::showpoint, ios::showpos
+#include <iostream>
+#include <utility>                                                                  // move()
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "GroceryListPatch.hpp"
+#include "Money.hpp"
+
+
+
+
+/*******************************************************************************
+**  Constructors
+*******************************************************************************/
+
+// Constructor - edits to a grocery list
+GroceryListPatch::GroceryListPatch( std::size_t baseSize, std::size_t baseHash, std::size_t resultHash, std::vector<Edit> edits )
+  : _baseSize( baseSize ), _baseHash( baseHash ), _resultHash( resultHash ), _edits( std::move( edits ) )
+{}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+std::size_t                                GroceryListPatch::baseSize  () const noexcept   { return _baseSize;      }
+std::size_t                                GroceryListPatch::baseHash  () const noexcept   { return _baseHash;      }
+std::size_t                                GroceryListPatch::resultHash() const noexcept   { return _resultHash;    }
+std::vector<GroceryListPatch::Edit> const & GroceryListPatch::edits     () const noexcept   { return _edits;         }
+bool                                       GroceryListPatch::empty     () const noexcept   { return _edits.empty(); }
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Non-member functions
+*******************************************************************************/
+
+// operator<<
+std::ostream & operator<<( std::ostream & stream, GroceryListPatch const & patch )
+{
+  // Prices are written with every digit they have, whatever the stream's own format, so they read back exactly.  15 significant
+  // digits show every mill of an amount under a trillion dollars, and past that 17 reproduce the double it's read back through.
+  auto const flags     = stream.flags();
+  auto const precision = stream.precision();
+  stream.unsetf( std::ios::floatfield | std::ios::showpoint | std::ios::showpos );
+
+  stream << patch._baseSize << ' ' << patch._baseHash << ' ' << patch._resultHash << ' ' << patch._edits.size() << '\n';
+
+  for( auto const & edit : patch._edits )
+  {
+    auto const mills = edit.groceryItem.exactPrice().mills();
+    stream.precision( mills < 1'000'000'000'000'000  &&  mills > -1'000'000'000'000'000 ? 15 : 17 );
+
+    if     ( edit.operation == GroceryListPatch::Operation::REMOVE      )   stream << "- " << edit.offset << ' ' << edit.groceryItem << '\n';
+    else if( edit.operation == GroceryListPatch::Operation::MOVE_TO_TOP )   stream << "^ "                      << edit.groceryItem << '\n';
+    else                                                                     stream << "+ " << edit.offset << ' ' << edit.groceryItem << '\n';
+  }
+
+  stream.flags    ( flags     );
+  stream.precision( precision );
+  return stream;
+}
+
+
+
+// operator>>
+std::istream & operator>>( std::istream & stream, GroceryListPatch & patch )
+{
+  // As the grocery item extraction operator does, work in a local object and move it into place only if all goes well
+  GroceryListPatch holder;
+  std::size_t      count = 0;
+  if( !( stream >> holder._baseSize >> holder._baseHash >> holder._resultHash >> count ) ) return stream;
+
+  for( std::size_t i = 0;  i < count;  ++i )
+  {
+    GroceryListPatch::Edit edit;
+    char                   operation = '\0';
+    stream >> operation;
+
+    if     ( operation == '-' ) { edit.operation = GroceryListPatch::Operation::REMOVE;       stream >> edit.offset >> edit.groceryItem; }
+    else if( operation == '^' ) { edit.operation = GroceryListPatch::Operation::MOVE_TO_TOP;  stream >> edit.groceryItem;                }
+    else if( operation == '+' ) { edit.operation = GroceryListPatch::Operation::INSERT;       stream >> edit.offset >> edit.groceryItem; }
+    else                          stream.setstate( std::ios::failbit );
+    if( !stream ) return stream;
+
+    holder._edits.push_back( std::move( edit ) );
+  }
+
+  patch = std::move( holder );
+  return stream;
+}
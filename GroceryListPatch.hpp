@@ -0,0 +1,80 @@
+#pragma once                                                                                  // include guard
+
+#include <cstddef>                                                                            // size_t
+#include <iostream>
+#include <stdexcept>                                                                          // logic_error
+#include <vector>
+
+#include "GroceryItem.hpp"
+
+
+// An edit script that turns one grocery list into another:  removals by offset, grocery items moved to the top, and insertions at
+// offsets, to be replayed in order.  BasicGroceryList::diff() makes one and BasicGroceryList::apply() replays it, so a grocery list
+// kept in sync somewhere else needs only the edits, not the whole list.  For example:
+//
+//    auto patch = GroceryList::diff( before, after );                 // sender
+//    replica.apply( patch );                                          // receiver, whose replica was equal to before
+//
+// A patch remembers the size of the grocery list it was made from and a hash of its grocery items in order, and each removal
+// remembers the grocery item it removes.  The edits come in the order diff() writes them:  removals from the bottom up, then moves
+// to the top, then insertions.  apply() refuses a grocery list that doesn't match, rearrangements of it included, and a patch
+// whose edits don't fit - edits out of that order, a removal of another grocery item, a move of one that isn't there, or an
+// insertion of one that is.  A patch also carries the hash, in order, of the grocery list it makes, which the grocery list keeps
+// so the next patch's base is checked without rehashing it.  The insertion and extraction operators write and read a patch as
+// text:  a header line of that size, both hashes, and the number of edits, then one line per edit
+//
+//    - offset groceryItem             remove the grocery item at offset, which must be groceryItem
+//    ^ groceryItem                    move the grocery item to the top
+//    + offset groceryItem             insert the grocery item at offset
+//
+// with grocery items written as the grocery item insertion operator writes them, but with every digit of their prices whatever the
+// stream's precision, so a patch read back is the patch written.
+class GroceryListPatch
+{
+  // Insertion and Extraction Operators
+  friend std::ostream & operator<<( std::ostream & stream, GroceryListPatch const & patch );
+  friend std::istream & operator>>( std::istream & stream, GroceryListPatch       & patch );
+
+  public:
+    // Types and Exceptions
+    struct Mismatch_Ex : std::logic_error { using logic_error::logic_error; };               // Thrown if a patch is applied to a grocery list other than the one it was made from,
+                                                                                              // or its edits don't fit the grocery list
+
+    enum class Operation {REMOVE, MOVE_TO_TOP, INSERT};
+
+    struct Edit
+    {
+      Operation   operation   = Operation::REMOVE;
+      std::size_t offset      = 0;                                                            // REMOVE and INSERT only
+      GroceryItem groceryItem;                                                                // the grocery item removed, moved, or inserted
+
+      bool operator==( Edit const & ) const = default;
+    };
+
+
+    // Constructors
+    GroceryListPatch() = default;                                                             // the empty patch of an empty grocery list
+    GroceryListPatch( std::size_t baseSize, std::size_t baseHash,                             // edits to a grocery list of baseSize grocery items hashing to baseHash in order,
+                      std::size_t resultHash, std::vector<Edit> edits );                      // making one hashing to resultHash in order
+
+
+    // Queries
+    std::size_t               baseSize  () const noexcept;                                    // the size() of the grocery list the patch applies to
+    std::size_t               baseHash  () const noexcept;                                    // a hash of the grocery items, in order, of the grocery list the patch applies to.
+                                                                                              // Unlike BasicGroceryList::hash(), a rearranged grocery list hashes differently
+    std::size_t               resultHash() const noexcept;                                    // the same hash of the grocery list the patch makes
+    std::vector<Edit> const & edits     () const noexcept;                                    // in the order they're applied
+    bool                      empty     () const noexcept;                                    // true if there are no edits
+
+
+    // Relational Operators
+    bool operator==( GroceryListPatch const & ) const = default;
+
+
+  private:
+    // Instance Attributes
+    std::size_t       _baseSize   = 0;
+    std::size_t       _baseHash   = 0;
+    std::size_t       _resultHash = 0;
+    std::vector<Edit> _edits;
+};
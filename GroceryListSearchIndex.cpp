@@ -0,0 +1,332 @@
+#include <algorithm>                                                                // lower_bound(), sort(), unique(), inplace_merge(), search(), equal(), find()
+#include <cstddef>                                                                  // size_t, ptrdiff_t
+#include <cstdint>                                                                  // uint32_t
+#include <initializer_list>
+#include <iterator>                                                                 // next()
+#include <limits>                                                                   // numeric_limits
+#include <span>
+#include <stdexcept>                                                                // length_error
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "GroceryListSearchIndex.hpp"
+
+
+
+
+/*******************************************************************************
+**  Implementation of non-member private types, objects, and functions
+*******************************************************************************/
+namespace    // unnamed, anonymous namespace
+{
+  // ASCII lower case, leaving every other byte (including UTF-8 sequences) alone
+  char foldChar( char c ) noexcept
+  {
+    return 'A' <= c  &&  c <= 'Z'  ?  static_cast<char>( c - 'A' + 'a' )  :  c;
+  }
+
+
+
+  // Each trigram packs three (already folded) bytes into the low 24 bits.  Trigrams never span two names.
+  std::vector<std::uint32_t> trigramsOf( std::initializer_list<std::string_view> foldedNames )
+  {
+    std::vector<std::uint32_t> trigrams;
+    for( auto const name : foldedNames )
+    {
+      for( std::size_t i = 0; i + 3 <= name.size(); ++i )
+      {
+        trigrams.push_back(   std::uint32_t{ static_cast<unsigned char>( name[i    ] ) } << 16
+                            | std::uint32_t{ static_cast<unsigned char>( name[i + 1] ) } <<  8
+                            | std::uint32_t{ static_cast<unsigned char>( name[i + 2] ) }       );
+      }
+    }
+
+    std::sort( trigrams.begin(), trigrams.end() );
+    trigrams.erase( std::unique( trigrams.begin(), trigrams.end() ), trigrams.end() );
+    return trigrams;
+  }
+}    // unnamed, anonymous namespace
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// size() const
+std::size_t GroceryListSearchIndex::size() const noexcept
+{
+  return _idAt.size();
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Accessors
+*******************************************************************************/
+
+// startingWith() const
+std::vector<std::size_t> GroceryListSearchIndex::startingWith( std::string_view prefix ) const
+{
+  auto const folded = fold( prefix );
+
+  // The names starting with the prefix are adjacent, beginning with the first name not less than the prefix
+  auto current = std::lower_bound( _prefixes.cbegin(), _prefixes.cend(), std::string_view{ folded },
+                                   [this]( Prefix const & entry, std::string_view value ) noexcept { return nameOf( entry ) < value; } );
+
+  std::vector<std::size_t> offsets;
+  for( ; current != _prefixes.cend()  &&  nameOf( *current ).starts_with( folded ); ++current )   offsets.push_back( _offsetOf[current->id] );
+
+  // A grocery item whose product and brand names both match is listed once
+  std::sort( offsets.begin(), offsets.end() );
+  offsets.erase( std::unique( offsets.begin(), offsets.end() ), offsets.end() );
+  return offsets;
+}
+
+
+
+// containing() const
+std::vector<std::size_t> GroceryListSearchIndex::containing( std::string_view text ) const
+{
+  auto const folded   = fold( text );
+  auto       mentions = [this, &folded]( Id id ) noexcept
+  {
+    return _names[id].product.find( folded ) != std::string::npos  ||  _names[id].brand.find( folded ) != std::string::npos;
+  };
+
+  std::vector<std::size_t> offsets;
+
+  // Too short for a trigram, so every grocery item is a candidate
+  if( folded.size() < 3 )
+  {
+    for( std::size_t offset = 0; offset < _idAt.size(); ++offset )   if( mentions( _idAt[offset] ) ) offsets.push_back( offset );
+    return offsets;
+  }
+
+  // Otherwise only the grocery items mentioning the query's rarest trigram are.  A trigram nobody mentions means no matches at all.
+  std::vector<Id> const * candidates = nullptr;
+  for( auto const trigram : trigramsOf( { folded } ) )
+  {
+    auto const postings = _trigrams.find( trigram );
+    if( postings == _trigrams.end() ) return offsets;
+    if( candidates == nullptr  ||  postings->second.size() < candidates->size() )   candidates = &postings->second;
+  }
+
+  for( auto const id : *candidates )   if( mentions( id ) ) offsets.push_back( _offsetOf[id] );
+  std::sort( offsets.begin(), offsets.end() );
+  return offsets;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// insertAt()
+void GroceryListSearchIndex::insertAt( GroceryItem const & groceryItem, std::size_t offset )
+{
+  insertAt( std::span<GroceryItem const>{ &groceryItem, 1 }, offset );
+}
+
+
+
+// insertAt( batch )
+void GroceryListSearchIndex::insertAt( std::span<GroceryItem const> groceryItems, std::size_t offset )
+{
+  if( groceryItems.empty() ) return;
+
+  std::vector<Id>     ids;
+  std::vector<Prefix> prefixes;
+  ids     .reserve(     groceryItems.size() );
+  prefixes.reserve( 2 * groceryItems.size() );
+
+  for( auto const & groceryItem : groceryItems )
+  {
+    // Reuse a forgotten grocery item's id before making up a new one
+    Id id;
+    if( !_freeIds.empty() )
+    {
+      id = _freeIds.back();
+      _freeIds.pop_back();
+    }
+    else
+    {
+      if( _names.size() >= std::numeric_limits<Id>::max() )   throw std::length_error( "GroceryListSearchIndex:  too many grocery items to index" );
+      id = static_cast<Id>( _names.size() );
+      _names   .emplace_back();
+      _offsetOf.emplace_back();
+    }
+
+    auto & names = _names[id];
+    names.product = fold( groceryItem.productName() );
+    names.brand   = fold( groceryItem.brandName  () );
+    for( auto const trigram : trigramsOf( { names.product, names.brand } ) )   _trigrams[trigram].push_back( id );
+
+    prefixes.push_back( { id, false } );
+    prefixes.push_back( { id, true  } );
+    ids     .push_back( id );
+  }
+
+  // Sort just the batch's names and merge them in, rather than a binary search and a shift for every grocery item
+  auto precede = [this]( Prefix lhs, Prefix rhs ) noexcept { return precedes( lhs, rhs ); };
+  std::sort( prefixes.begin(), prefixes.end(), precede );
+
+  auto const oldSize = static_cast<std::ptrdiff_t>( _prefixes.size() );
+  _prefixes.insert( _prefixes.end(), prefixes.begin(), prefixes.end() );
+  std::inplace_merge( _prefixes.begin(), std::next( _prefixes.begin(), oldSize ), _prefixes.end(), precede );
+
+  // Open the gap in the offset -> id table and renumber from there down
+  _idAt.insert( std::next( _idAt.begin(), static_cast<std::ptrdiff_t>( offset ) ), ids.begin(), ids.end() );
+  renumber( offset );
+}
+
+
+
+// eraseAt()
+void GroceryListSearchIndex::eraseAt( std::size_t offset )
+{
+  if( offset >= _idAt.size() ) return;                                              // not indexed, nothing to do
+
+  auto const id = _idAt[offset];
+
+  for( bool const brand : { false, true } )
+  {
+    Prefix const prefix{ id, brand };
+    auto const   position = std::lower_bound( _prefixes.begin(), _prefixes.end(), prefix,
+                                              [this]( Prefix lhs, Prefix rhs ) noexcept { return precedes( lhs, rhs ); } );
+    if( position != _prefixes.end()  &&  position->id == id  &&  position->brand == brand )   _prefixes.erase( position );
+  }
+
+  // Posting lists are unordered, so the id is swapped with the last one and dropped.  Empty lists are dropped too.
+  for( auto const trigram : trigramsOf( { _names[id].product, _names[id].brand } ) )
+  {
+    auto const postings = _trigrams.find( trigram );
+    if( postings == _trigrams.end() ) continue;
+
+    auto & ids = postings->second;
+    *std::find( ids.begin(), ids.end(), id ) = ids.back();
+    ids.pop_back();
+    if( ids.empty() )   _trigrams.erase( postings );
+  }
+
+  _names[id] = {};                                                                  // release the names' memory while the id waits for reuse
+  _freeIds.push_back( id );
+
+  _idAt.erase( std::next( _idAt.begin(), static_cast<std::ptrdiff_t>( offset ) ) );
+  renumber( offset );
+}
+
+
+
+// clear()
+void GroceryListSearchIndex::clear() noexcept
+{
+  _names   .clear();
+  _prefixes.clear();
+  _trigrams.clear();
+  _idAt    .clear();
+  _offsetOf.clear();
+  _freeIds .clear();
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Matching
+*******************************************************************************/
+
+// fold()
+std::string GroceryListSearchIndex::fold( std::string_view text )
+{
+  std::string folded( text );
+  for( auto & c : folded )   c = foldChar( c );
+  return folded;
+}
+
+
+
+// namesStartWith()
+bool GroceryListSearchIndex::namesStartWith( GroceryItem const & groceryItem, std::string_view foldedPrefix ) noexcept
+{
+  auto startsWith = [foldedPrefix]( std::string_view name ) noexcept
+  {
+    return name.size() >= foldedPrefix.size()
+        && std::equal( foldedPrefix.begin(), foldedPrefix.end(), name.begin(), []( char p, char n ) noexcept { return p == foldChar( n ); } );
+  };
+  return startsWith( groceryItem.productName() )  ||  startsWith( groceryItem.brandName() );
+}
+
+
+
+// namesContain()
+bool GroceryListSearchIndex::namesContain( GroceryItem const & groceryItem, std::string_view foldedText ) noexcept
+{
+  if( foldedText.empty() ) return true;
+
+  auto contains = [foldedText]( std::string_view name ) noexcept
+  {
+    return std::search( name.begin(), name.end(), foldedText.begin(), foldedText.end(), []( char n, char t ) noexcept { return foldChar( n ) == t; } ) != name.end();
+  };
+  return contains( groceryItem.productName() )  ||  contains( groceryItem.brandName() );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Private member functions
+*******************************************************************************/
+
+// nameOf() const
+std::string_view GroceryListSearchIndex::nameOf( Prefix prefix ) const noexcept
+{
+  return prefix.brand ? _names[prefix.id].brand : _names[prefix.id].product;
+}
+
+
+
+// precedes() const
+bool GroceryListSearchIndex::precedes( Prefix lhs, Prefix rhs ) const noexcept
+{
+  // By name, then id, then which name, so every entry has exactly one place
+  auto const lhsName = nameOf( lhs );
+  auto const rhsName = nameOf( rhs );
+  if( lhsName != rhsName ) return lhsName < rhsName;
+  if( lhs.id  != rhs.id  ) return lhs.id  < rhs.id;
+  return lhs.brand < rhs.brand;
+}
+
+
+
+// renumber()
+void GroceryListSearchIndex::renumber( std::size_t from ) noexcept
+{
+  for( auto offset = from; offset < _idAt.size(); ++offset )   _offsetOf[_idAt[offset]] = offset;
+}
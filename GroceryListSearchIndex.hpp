@@ -0,0 +1,79 @@
+#pragma once                                                                                  // include guard
+
+#include <cstddef>                                                                            // size_t
+#include <cstdint>                                                                            // uint32_t
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "GroceryItem.hpp"
+
+
+// A typeahead index answering "which grocery items have a product or brand name starting with (or containing) this text" without
+// visiting every grocery item.  Matching ignores ASCII letter case.
+//
+// Each grocery item indexed is given an id that stays put while the grocery items around it come and go, and under it the index
+// keeps a case folded copy of the grocery item's names.  Everything else refers to ids rather than offsets:
+//   o) Prefixes:    every name, sorted, so the names starting with a prefix are one binary search away and adjacent.  It's a trie
+//                   flattened into an array of small (id, which name) entries.
+//   o) Substrings:  an inverted index from each three character sequence (trigram) to the ids of the grocery items whose names
+//                   contain it.  A query's rarest trigram narrows the candidates, which are then confirmed against their names.
+//                   Queries shorter than a trigram confirm every grocery item.
+// Only the id <-> offset tables are renumbered as grocery items are inserted and removed, and only from the edit to the bottom of
+// the list.
+class GroceryListSearchIndex
+{
+  public:
+    // Queries
+    std::size_t size() const noexcept;                                                        // returns the number of grocery items indexed
+
+
+    // Accessors - each returns the offsets of the matching grocery items, in ascending order
+    std::vector<std::size_t> startingWith( std::string_view prefix ) const;                   // product or brand name starts with prefix
+    std::vector<std::size_t> containing  ( std::string_view text   ) const;                   // product or brand name contains text
+
+
+    // Modifiers
+    void insertAt( GroceryItem const &          groceryItem,  std::size_t offset );           // records a new grocery item at offset, renumbering the offsets at and after it (+1)
+    void insertAt( std::span<GroceryItem const> groceryItems, std::size_t offset );           // records a batch of new grocery items starting at offset, renumbering once
+    void eraseAt (                                            std::size_t offset );           // forgets the grocery item at offset, renumbering the offsets after it (-1)
+    void clear   (                                                              ) noexcept;
+
+
+    // Matching a grocery item directly, for the owner's unindexed searches
+    static std::string fold          ( std::string_view text );                               // ASCII lower case
+    static bool        namesStartWith( GroceryItem const & groceryItem, std::string_view foldedPrefix ) noexcept;
+    static bool        namesContain  ( GroceryItem const & groceryItem, std::string_view foldedText   ) noexcept;
+
+
+  private:
+    using Id = std::uint32_t;
+
+    struct Names                                                                              // case folded
+    {
+      std::string product;
+      std::string brand;
+    };
+
+    struct Prefix
+    {
+      Id   id;
+      bool brand;                                                                             // _names[id].brand if true, _names[id].product otherwise
+    };
+
+    // Instance Attributes
+    std::vector<Names>                                 _names;                                // id -> names
+    std::vector<Prefix>                                _prefixes;                             // sorted by name, then id
+    std::unordered_map<std::uint32_t, std::vector<Id>> _trigrams;                             // trigram -> ids of the grocery items mentioning it, unordered
+    std::vector<Id>                                    _idAt;                                 // offset -> id
+    std::vector<std::size_t>                           _offsetOf;                             // id -> offset
+    std::vector<Id>                                    _freeIds;                              // ids of forgotten grocery items, ready for reuse
+
+
+    // Helper member functions
+    std::string_view nameOf  ( Prefix      prefix          ) const noexcept;
+    bool             precedes( Prefix      lhs, Prefix rhs ) const noexcept;                  // the sorted order of _prefixes
+    void             renumber( std::size_t from            ) noexcept;                        // brings _offsetOf up to date for the offsets at and after from
+};
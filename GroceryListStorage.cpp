@@ -0,0 +1,1382 @@
+#include <algorithm>                                                                // any_of(), none_of()
+#include <cstddef>                                                                  // size_t, ptrdiff_t
+#include <functional>                                                               // hash
+#include <iterator>                                                                 // distance(), next(), prev(), make_move_iterator()
+#include <limits>                                                                   // numeric_limits
+#include <memory>                                                                   // allocate_shared()
+#include <memory_resource>                                                          // memory_resource, polymorphic_allocator, get_default_resource()
+#include <string>
+#include <utility>                                                                  // move(), swap(), exchange(), pair
+#include <vector>
+
+#include "ExceptionLocation.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryListBase.hpp"
+#include "GroceryListStorage.hpp"
+
+
+
+
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// VectorStorage
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VectorStorage::VectorStorage( std::pmr::memory_resource * resource )
+  : _items( resource )
+{}
+
+
+
+std::pmr::memory_resource *   VectorStorage::resource() const noexcept                      { return _items.get_allocator().resource(); }
+VectorStorage::const_iterator VectorStorage::begin() const noexcept                          { return _items.cbegin();         }
+VectorStorage::const_iterator VectorStorage::end  () const noexcept                          { return _items.cend  ();         }
+std::size_t                   VectorStorage::size () const noexcept                          { return _items.size  ();         }
+GroceryItem const &           VectorStorage::at   ( std::size_t offset ) const               { return _items[offset];          }
+bool                          VectorStorage::sizesAreConsistant   () const noexcept          { return true;                    }  // a single container can't disagree with itself
+bool                          VectorStorage::contentsAreConsistant() const noexcept          { return true;                    }
+
+
+
+// insert()
+void VectorStorage::insert( std::size_t offset, GroceryItem const & groceryItem )
+{
+  _items.insert( std::next( _items.begin(), static_cast<std::ptrdiff_t>( offset ) ), groceryItem );
+}
+
+
+
+// insert( batch )
+void VectorStorage::insert( std::size_t offset, std::vector<GroceryItem> && groceryItems )
+{
+  // Moved in one by one, even into an empty vector:  the batch's own block didn't come from this storage's resource.  The grocery
+  // items did if BasicGroceryList gathered them (see AllocatorAwareStorage), so their product names move rather than copy.
+  _items.insert( std::next( _items.begin(), static_cast<std::ptrdiff_t>( offset ) ),
+                 std::make_move_iterator( groceryItems.begin() ), std::make_move_iterator( groceryItems.end() ) );
+}
+
+
+
+// erase()
+void VectorStorage::erase( std::size_t offset )
+{
+  _items.erase( std::next( _items.begin(), static_cast<std::ptrdiff_t>( offset ) ) );
+}
+
+
+
+
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ListStorage
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ListStorage::ListStorage( std::pmr::memory_resource * resource )
+  : _items( resource ), _nodes( resource )
+{}
+
+ListStorage::ListStorage( ListStorage const & other )
+  : ListStorage( other, std::pmr::get_default_resource() )
+{}
+
+ListStorage::ListStorage( ListStorage const & other, std::pmr::memory_resource * resource )
+  : _items( other._items, resource ), _nodes( resource )
+{
+  record( _items.cbegin(), _items.cend() );                                         // the copy's own nodes, not other's
+}
+
+std::pmr::memory_resource * ListStorage::resource() const noexcept
+{
+  return _items.get_allocator().resource();
+}
+
+ListStorage & ListStorage::operator=( ListStorage rhs )
+{
+  // Lists can only swap nodes allocated from the same resource, so rhs is first copied into this one's if need be
+  if( rhs._items.get_allocator() != _items.get_allocator() )   return *this = ListStorage( rhs, _items.get_allocator().resource() );
+
+  _items.swap( rhs._items );                                                        // swapping lists keeps their iterators valid
+  _nodes.swap( rhs._nodes );
+  return *this;
+}
+
+
+
+ListStorage::const_iterator ListStorage::begin() const noexcept                              { return _items.cbegin();                      }
+ListStorage::const_iterator ListStorage::end  () const noexcept                              { return _items.cend  ();                      }
+std::size_t                 ListStorage::size () const noexcept                              { return _items.size  ();                      }
+GroceryItem const &         ListStorage::at   ( std::size_t offset ) const                   { return *iteratorAt( offset );                }
+bool                        ListStorage::sizesAreConsistant() const noexcept                 { return _items.size() == _nodes.size();       }
+
+bool ListStorage::contentsAreConsistant() const noexcept
+{
+  if( !sizesAreConsistant() ) return false;
+
+  for( auto node = _items.cbegin();  node != _items.cend();  ++node )
+  {
+    bool recorded = false;
+    for( auto [first, last] = _nodes.equal_range( *node );  first != last  &&  !recorded;  ++first )   recorded = *first == node;
+    if( !recorded ) return false;
+  }
+  return true;
+}
+
+
+
+// insert()
+void ListStorage::insert( std::size_t offset, GroceryItem const & groceryItem )
+{
+  auto const node = _items.insert( iteratorAt( offset ), groceryItem );
+  record( node, std::next( node ) );
+}
+
+
+
+// insert( batch )
+void ListStorage::insert( std::size_t offset, std::vector<GroceryItem> && groceryItems )
+{
+  auto const next  = iteratorAt( offset );
+  auto const first = _items.insert( next, std::make_move_iterator( groceryItems.begin() ), std::make_move_iterator( groceryItems.end() ) );
+  record( first, next );
+}
+
+
+
+// erase()
+void ListStorage::erase( std::size_t offset )
+{
+  auto const node = iteratorAt( offset );
+  forget( node );
+  _items.erase( node );
+}
+
+
+
+// moveToTop()
+bool ListStorage::moveToTop( GroceryItem const & groceryItem )
+{
+  // Splicing relinks the node, nothing is copied and every iterator (those in _nodes included) stays valid
+  auto const found = _nodes.find( groceryItem );
+  if( found == _nodes.end() ) return false;
+
+  _items.splice( _items.cbegin(), _items, *found );
+  return true;
+}
+
+
+
+// forget()
+void ListStorage::forget( const_iterator node ) noexcept
+{
+  for( auto [first, last] = _nodes.equal_range( *node );  first != last;  ++first )
+  {
+    if( *first == node )
+    {
+      _nodes.erase( first );
+      return;
+    }
+  }
+}
+
+
+
+// record()
+void ListStorage::record( const_iterator first, const_iterator last )
+{
+  // If a node can't be recorded, take the whole range back out so the list and _nodes still agree
+  auto next = first;
+  try
+  {
+    for( ;  next != last;  ++next )   _nodes.insert( next );
+  }
+  catch( ... )
+  {
+    for( auto node = first;  node != next;  ++node )   forget( node );
+    _items.erase( first, last );
+    throw;
+  }
+}
+
+
+
+// iteratorAt() const
+ListStorage::const_iterator ListStorage::iteratorAt( std::size_t offset ) const
+{
+  // Walk from whichever end is closer.  An offset of size() is the end of the list.
+  auto const distance = static_cast<std::ptrdiff_t>( offset );
+  auto const size     = static_cast<std::ptrdiff_t>( _items.size() );
+
+  if( distance <= size / 2 )   return std::next( _items.cbegin(), distance        );
+  else                         return std::prev( _items.cend  (), size - distance );
+}
+
+
+
+// NodeHash and NodeEqual
+std::size_t ListStorage::NodeHash::operator()( const_iterator      node        ) const noexcept   { return std::hash<GroceryItem>{}( *node       ); }
+std::size_t ListStorage::NodeHash::operator()( GroceryItem const & groceryItem ) const noexcept   { return std::hash<GroceryItem>{}( groceryItem ); }
+
+bool ListStorage::NodeEqual::operator()( const_iterator      lhs, const_iterator      rhs ) const noexcept   { return *lhs == *rhs; }
+bool ListStorage::NodeEqual::operator()( GroceryItem const & lhs, const_iterator      rhs ) const noexcept   { return  lhs == *rhs; }
+bool ListStorage::NodeEqual::operator()( const_iterator      lhs, GroceryItem const & rhs ) const noexcept   { return *lhs ==  rhs; }
+
+
+
+
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// TreeStorage
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TreeStorage::const_iterator::const_iterator( Node const * node ) noexcept : _node( node )  {}
+
+TreeStorage::const_iterator::reference TreeStorage::const_iterator::operator* () const noexcept   { return  _node->item; }
+TreeStorage::const_iterator::pointer   TreeStorage::const_iterator::operator->() const noexcept   { return &_node->item; }
+
+TreeStorage::const_iterator TreeStorage::const_iterator::operator++( int ) noexcept
+{
+  auto const previous = *this;
+  ++*this;
+  return previous;
+}
+
+
+
+// const_iterator::operator++()
+TreeStorage::const_iterator & TreeStorage::const_iterator::operator++() noexcept
+{
+  // The successor is the leftmost node of the right subtree if there is one, otherwise the nearest ancestor we're to the left of
+  if( _node->right != nullptr )
+  {
+    _node = _node->right;
+    while( _node->left != nullptr )   _node = _node->left;
+    return *this;
+  }
+
+  while( _node->parent != nullptr  &&  _node == _node->parent->right )   _node = _node->parent;
+  _node = _node->parent;
+  return *this;
+}
+
+
+
+TreeStorage::TreeStorage( std::pmr::memory_resource * resource )
+  : _nodes( resource )
+{}
+
+TreeStorage::TreeStorage( TreeStorage const & other )
+  : TreeStorage( other, std::pmr::get_default_resource() )
+{}
+
+TreeStorage::TreeStorage( TreeStorage const & other, std::pmr::memory_resource * resource )
+  : TreeStorage( resource )                                                         // delegating, so the destructor cleans up if a copy throws part way through
+{
+  _nodes.reserve( other._nodes.size() );
+  _root = clone( other._root, nullptr );
+  _seed = other._seed;
+}
+
+TreeStorage::TreeStorage( TreeStorage && other ) noexcept
+  : _root( std::exchange( other._root, nullptr ) ), _nodes( std::move( other._nodes ) ), _seed( other._seed )
+{
+  other._nodes.clear();                                                             // so other's destructor frees nothing, whatever moving left behind
+}
+
+TreeStorage & TreeStorage::operator=( TreeStorage rhs )
+{
+  // Nodes can only change hands between storages allocating from the same resource, so rhs is first copied into this one's if
+  // need be
+  if( rhs._nodes.get_allocator() != _nodes.get_allocator() )   return *this = TreeStorage( rhs, _nodes.get_allocator().resource() );
+
+  std::swap( _root, rhs._root );
+  _nodes.swap( rhs._nodes );
+  std::swap( _seed, rhs._seed );
+  return *this;
+}
+
+std::pmr::memory_resource * TreeStorage::resource() const noexcept
+{
+  return _nodes.get_allocator().resource();
+}
+
+TreeStorage::~TreeStorage() noexcept
+{
+  auto nodes = allocator();
+  for( auto node : _nodes )   nodes.delete_object( node );                          // _nodes holds every node exactly once, no need to walk the tree
+}
+
+
+
+TreeStorage::const_iterator TreeStorage::begin() const noexcept
+{
+  Node const * node = _root;
+  while( node != nullptr  &&  node->left != nullptr )   node = node->left;
+  return const_iterator( node );
+}
+
+TreeStorage::const_iterator TreeStorage::end  () const noexcept                     { return const_iterator();           }
+std::size_t                 TreeStorage::size () const noexcept                     { return countOf( _root );           }
+GroceryItem const &         TreeStorage::at   ( std::size_t offset ) const          { return nodeAt( offset )->item;     }
+
+bool TreeStorage::sizesAreConsistant() const noexcept
+{
+  return countOf( _root ) == _nodes.size()  &&  ( _root == nullptr  ||  _root->parent == nullptr );
+}
+
+bool TreeStorage::contentsAreConsistant() const noexcept
+{
+  return sizesAreConsistant()  &&  isConsistant( _root, nullptr );
+}
+
+
+
+// offsetOf() const
+std::size_t TreeStorage::offsetOf( GroceryItem const & groceryItem ) const
+{
+  auto const node = nodeOf( groceryItem );
+  return node == nullptr ? size() : rank( node );
+}
+
+
+
+// insert()
+void TreeStorage::insert( std::size_t offset, GroceryItem const & groceryItem )
+{
+  auto const node           = makeNode( GroceryItem( groceryItem, allocator() ) );
+  auto const [top, bottom]  = split( _root, offset );
+
+  _root         = merge( merge( top, node ), bottom );
+  _root->parent = nullptr;
+}
+
+
+
+// insert( batch )
+void TreeStorage::insert( std::size_t offset, std::vector<GroceryItem> && groceryItems )
+{
+  if( groceryItems.empty() ) return;
+
+  // Build the batch into a treap of its own in linear time, then splice it in with one split and two merges (logarithmic time)
+  // instead of a split and merge per grocery item.  If a node can't be made, forget the ones that were - the tree hasn't changed.
+  std::vector<Node *> nodes;
+  nodes.reserve( groceryItems.size() );
+  try
+  {
+    for( auto & groceryItem : groceryItems )   nodes.push_back( makeNode( std::move( groceryItem ) ) );
+  }
+  catch( ... )
+  {
+    for( auto node : nodes )   forget( node );
+    throw;
+  }
+
+  auto const batch          = build( nodes );
+  auto const [top, bottom]  = split( _root, offset );
+
+  _root         = merge( merge( top, batch ), bottom );
+  _root->parent = nullptr;
+}
+
+
+
+// erase()
+void TreeStorage::erase( std::size_t offset )
+{
+  auto const node = nodeAt( offset );
+  detach( node );
+  forget( node );
+}
+
+
+
+// moveToTop()
+bool TreeStorage::moveToTop( GroceryItem const & groceryItem )
+{
+  // The node itself is relinked, so nothing is copied and _nodes doesn't change
+  auto const node = nodeOf( groceryItem );
+  if( node == nullptr ) return false;
+
+  detach( node );
+  _root         = merge( node, _root );
+  _root->parent = nullptr;
+  return true;
+}
+
+
+
+// detach()
+void TreeStorage::detach( Node * node ) noexcept
+{
+  // Merging the node's subtrees takes the node's place, and every ancestor now counts one grocery item fewer
+  auto const parent      = node->parent;
+  auto const replacement = merge( node->left, node->right );
+
+  if( replacement != nullptr )       replacement->parent = parent;
+  if     ( parent == nullptr       ) _root          = replacement;
+  else if( parent->left == node    ) parent->left   = replacement;
+  else                               parent->right  = replacement;
+
+  for( auto ancestor = parent;  ancestor != nullptr;  ancestor = ancestor->parent )   --ancestor->count;
+
+  node->parent = node->left = node->right = nullptr;
+  node->count  = 1;
+}
+
+
+
+// makeNode()
+TreeStorage::Node * TreeStorage::makeNode( GroceryItem && groceryItem )
+{
+  // SplitMix64 over a counter:  cheap, and good enough that no insertion order can make the tree lopsided
+  auto const priority = nextSplitMix64( _seed );
+
+  auto const node = allocator().new_object<Node>( Node{ GroceryItem( std::move( groceryItem ), allocator() ), priority } );
+  try
+  {
+    _nodes.insert( node );
+  }
+  catch( ... )
+  {
+    allocator().delete_object( node );
+    throw;
+  }
+  return node;
+}
+
+
+
+// allocator() const
+std::pmr::polymorphic_allocator<TreeStorage::Node> TreeStorage::allocator() const noexcept
+{
+  return _nodes.get_allocator();
+}
+
+
+
+// build()
+TreeStorage::Node * TreeStorage::build( std::vector<Node *> const & nodes )
+{
+  // The classic stack based Cartesian tree construction.  The stack holds the right spine built so far.  Each new node pops the
+  // spine nodes of lower priority, which become its left subtree, and goes to the end of the spine.  A popped node's subtree is
+  // complete, so that's when it's counted.
+  std::vector<Node *> spine;
+  for( auto node : nodes )
+  {
+    Node * popped = nullptr;
+    while( !spine.empty()  &&  spine.back()->priority < node->priority )
+    {
+      popped = spine.back();
+      spine.pop_back();
+      update( popped );
+    }
+
+    node->left = popped;
+    if( !spine.empty() )   spine.back()->right = node;
+    spine.push_back( node );
+  }
+
+  for( auto node = spine.rbegin();  node != spine.rend();  ++node )   update( *node );
+  spine.front()->parent = nullptr;
+  return spine.front();
+}
+
+
+
+// nodeAt() const
+TreeStorage::Node * TreeStorage::nodeAt( std::size_t offset ) const noexcept
+{
+  auto node = _root;
+  while( true )
+  {
+    auto const above = countOf( node->left );
+    if     ( offset <  above )   node    = node->left;
+    else if( offset == above )   return node;
+    else                       { offset -= above + 1;  node = node->right; }
+  }
+}
+
+
+
+// nodeOf() const
+TreeStorage::Node * TreeStorage::nodeOf( GroceryItem const & groceryItem ) const noexcept
+{
+  // BasicGroceryList never holds duplicates, but nothing here depends on that.  If it did, the topmost one is the answer.
+  auto   [first, last] = _nodes.equal_range( groceryItem );
+  Node * found         = nullptr;
+  for( ;  first != last;  ++first )
+  {
+    if( found == nullptr  ||  rank( *first ) < rank( found ) )   found = *first;
+  }
+  return found;
+}
+
+
+
+// forget()
+void TreeStorage::forget( Node * node ) noexcept
+{
+  for( auto [first, last] = _nodes.equal_range( node );  first != last;  ++first )
+  {
+    if( *first == node )
+    {
+      _nodes.erase( first );
+      break;
+    }
+  }
+  allocator().delete_object( node );
+}
+
+
+
+// clone()
+TreeStorage::Node * TreeStorage::clone( Node const * node, Node * parent )
+{
+  if( node == nullptr ) return nullptr;
+
+  auto const result = allocator().new_object<Node>( Node{ GroceryItem( node->item, allocator() ), node->priority, node->count, parent } );
+  try
+  {
+    _nodes.insert( result );                                                        // owned by _nodes from here on
+  }
+  catch( ... )
+  {
+    allocator().delete_object( result );
+    throw;
+  }
+
+  result->left  = clone( node->left,  result );
+  result->right = clone( node->right, result );
+  return result;
+}
+
+
+
+// isConsistant() const
+bool TreeStorage::isConsistant( Node const * node, Node const * parent ) const noexcept
+{
+  if( node == nullptr ) return true;
+
+  if( node->parent != parent                                                  ) return false;
+  if( node->count  != 1 + countOf( node->left ) + countOf( node->right )      ) return false;
+  if( parent != nullptr  &&  parent->priority < node->priority                ) return false;
+
+  bool recorded = false;
+  for( auto [first, last] = _nodes.equal_range( node->item );  first != last  &&  !recorded;  ++first )   recorded = *first == node;
+
+  return recorded  &&  isConsistant( node->left, node )  &&  isConsistant( node->right, node );
+}
+
+
+
+// countOf()
+std::size_t TreeStorage::countOf( Node const * node ) noexcept
+{
+  return node == nullptr ? 0 : node->count;
+}
+
+
+
+// update()
+void TreeStorage::update( Node * node ) noexcept
+{
+  node->count = 1 + countOf( node->left ) + countOf( node->right );
+  if( node->left  != nullptr )   node->left ->parent = node;
+  if( node->right != nullptr )   node->right->parent = node;
+}
+
+
+
+// rank()
+std::size_t TreeStorage::rank( Node const * node ) noexcept
+{
+  // Everything in the left subtree comes first, plus, for every ancestor we're to the right of, that ancestor and its left subtree
+  auto offset = countOf( node->left );
+  for( ;  node->parent != nullptr;  node = node->parent )
+  {
+    if( node == node->parent->right )   offset += countOf( node->parent->left ) + 1;
+  }
+  return offset;
+}
+
+
+
+// merge()
+TreeStorage::Node * TreeStorage::merge( Node * top, Node * bottom ) noexcept
+{
+  // The higher priority of the two roots stays the root, and the other merges into its inner side
+  if( top    == nullptr ) return bottom;
+  if( bottom == nullptr ) return top;
+
+  if( top->priority > bottom->priority )
+  {
+    top->right = merge( top->right, bottom );
+    update( top );
+    return top;
+  }
+
+  bottom->left = merge( top, bottom->left );
+  update( bottom );
+  return bottom;
+}
+
+
+
+// split()
+std::pair<TreeStorage::Node *, TreeStorage::Node *> TreeStorage::split( Node * node, std::size_t count ) noexcept
+{
+  if( node == nullptr ) return { nullptr, nullptr };
+
+  std::pair<Node *, Node *> result;
+  if( auto const above = countOf( node->left );  count <= above )
+  {
+    auto const [top, bottom] = split( node->left, count );
+    node->left = bottom;
+    update( node );
+    result     = { top, node };
+  }
+  else
+  {
+    auto const [top, bottom] = split( node->right, count - above - 1 );
+    node->right = top;
+    update( node );
+    result      = { node, bottom };
+  }
+
+  if( result.first  != nullptr )   result.first ->parent = nullptr;
+  if( result.second != nullptr )   result.second->parent = nullptr;
+  return result;
+}
+
+
+
+// NodeHash and NodeEqual
+std::size_t TreeStorage::NodeHash::operator()( Node const *        node        ) const noexcept   { return std::hash<GroceryItem>{}( node->item  ); }
+std::size_t TreeStorage::NodeHash::operator()( GroceryItem const & groceryItem ) const noexcept   { return std::hash<GroceryItem>{}( groceryItem ); }
+
+bool TreeStorage::NodeEqual::operator()( Node const *        lhs, Node const *        rhs ) const noexcept   { return lhs->item == rhs->item; }
+bool TreeStorage::NodeEqual::operator()( GroceryItem const & lhs, Node const *        rhs ) const noexcept   { return lhs       == rhs->item; }
+bool TreeStorage::NodeEqual::operator()( Node const *        lhs, GroceryItem const & rhs ) const noexcept   { return lhs->item == rhs;       }
+
+
+
+
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// PersistentStorage
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+PersistentStorage::const_iterator::const_iterator( Node const * root )                                    { descend( root ); }
+
+PersistentStorage::const_iterator::reference PersistentStorage::const_iterator::operator* () const noexcept   { return *_path.back()->item; }
+PersistentStorage::const_iterator::pointer   PersistentStorage::const_iterator::operator->() const noexcept   { return  _path.back()->item.get(); }
+
+PersistentStorage::const_iterator PersistentStorage::const_iterator::operator++( int )
+{
+  auto const previous = *this;
+  ++*this;
+  return previous;
+}
+
+
+
+// const_iterator::operator++()
+PersistentStorage::const_iterator & PersistentStorage::const_iterator::operator++()
+{
+  // Nodes have no parent pointers (a node may be in many trees), so the ancestors still to come are kept on the path instead.  The
+  // successor is the leftmost node of the right subtree if there is one, otherwise the nearest ancestor we're to the left of.
+  auto const node = _path.back();
+  _path.pop_back();
+  descend( node->right.get() );
+  return *this;
+}
+
+
+
+bool PersistentStorage::const_iterator::operator==( const_iterator const & rhs ) const noexcept
+{
+  if( _path.empty()  ||  rhs._path.empty() )   return _path.empty() == rhs._path.empty();
+  return _path.back() == rhs._path.back();
+}
+
+
+
+void PersistentStorage::const_iterator::descend( Node const * node )
+{
+  for( ;  node != nullptr;  node = node->left.get() )   _path.push_back( node );
+}
+
+
+
+PersistentStorage::PersistentStorage( std::pmr::memory_resource * resource )
+  : _allocator( resource )
+{}
+
+PersistentStorage::PersistentStorage( PersistentStorage const & other )
+  : PersistentStorage( other, std::pmr::get_default_resource() )
+{}
+
+PersistentStorage::PersistentStorage( PersistentStorage const & other, std::pmr::memory_resource * resource )
+  : _allocator( resource ), _seed( other._seed )
+{
+  if( _allocator == other._allocator )                                              // constant time, the nodes are shared
+  {
+    _root    = other._root;
+    _buckets = other._buckets;
+    return;
+  }
+
+  // Sharing would tie this copy to other's resource, so other's grocery items are gathered into this one's and built into a tree
+  // of its own
+  std::vector<GroceryItem> groceryItems;
+  groceryItems.reserve( other.size() );
+  for( auto const & groceryItem : other )   groceryItems.emplace_back( groceryItem, _allocator );
+  insert( 0, std::move( groceryItems ) );
+}
+
+PersistentStorage & PersistentStorage::operator=( PersistentStorage rhs )
+{
+  // Nodes are only shared between storages allocating from the same resource, so rhs is first copied into this one's if need be
+  if( rhs._allocator != _allocator )   return *this = PersistentStorage( rhs, resource() );
+
+  std::swap( _root,    rhs._root    );
+  std::swap( _buckets, rhs._buckets );
+  std::swap( _seed,    rhs._seed    );
+  return *this;
+}
+
+
+
+std::pmr::memory_resource *       PersistentStorage::resource() const noexcept      { return _allocator.resource();         }
+PersistentStorage::const_iterator PersistentStorage::begin() const                  { return const_iterator( _root.get() ); }
+PersistentStorage::const_iterator PersistentStorage::end  () const noexcept         { return const_iterator();              }
+std::size_t                       PersistentStorage::size () const noexcept         { return countOf( _root );              }
+
+bool PersistentStorage::sizesAreConsistant() const noexcept
+{
+  return _root == nullptr  ||  _root->count == 1 + countOf( _root->left ) + countOf( _root->right );
+}
+
+bool PersistentStorage::contentsAreConsistant() const noexcept
+{
+  if( !isConsistant( _root.get(), std::numeric_limits<std::uint64_t>::max() ) ) return false;
+
+  // The buckets must hold exactly the grocery items in the tree:  as many of them, and each one the tree holds
+  Bucket const * previous = nullptr;
+  std::size_t    items    = 0;
+  if( !isConsistant( _buckets.get(), std::numeric_limits<std::uint64_t>::max(), previous, items )  ||  items != size() ) return false;
+
+  for( auto item = begin();  item != end();  ++item )
+  {
+    auto const bucket = bucketOf( _buckets, std::hash<GroceryItem>{}( *item ) );
+    if( bucket == nullptr ) return false;
+    if( std::none_of( bucket->items.begin(), bucket->items.end(), [&]( ItemPtr const & held ) noexcept { return held.get() == &*item; } ) ) return false;
+  }
+  return true;
+}
+
+
+
+// at() const
+GroceryItem const & PersistentStorage::at( std::size_t offset ) const
+{
+  auto node = _root.get();
+  while( true )
+  {
+    auto const above = countOf( node->left );
+    if     ( offset <  above )   node    = node->left.get();
+    else if( offset == above )   return *node->item;
+    else                       { offset -= above + 1;  node = node->right.get(); }
+  }
+}
+
+
+
+// contains() const
+bool PersistentStorage::contains( GroceryItem const & groceryItem ) const
+{
+  auto const bucket = bucketOf( _buckets, std::hash<GroceryItem>{}( groceryItem ) );
+  if( bucket == nullptr ) return false;
+
+  return std::any_of( bucket->items.begin(), bucket->items.end(), [&]( ItemPtr const & item ) { return *item == groceryItem; } );
+}
+
+
+
+// insert()
+void PersistentStorage::insert( std::size_t offset, GroceryItem const & groceryItem )
+{
+  // Everything is built before _root and _buckets change, so if anything throws this version is untouched (and the others never
+  // are)
+  Node const node{ std::allocate_shared<GroceryItem const>( _allocator, groceryItem ), nextPriority(), 1, nullptr, nullptr };
+  auto       buckets = withItem( _buckets, std::hash<GroceryItem>{}( groceryItem ), node.item );
+  auto const [top, bottom] = split( _root, offset );
+  auto       root    = merge( merge( top, makeNode( node, nullptr, nullptr ) ), bottom );
+
+  _root    = std::move( root    );
+  _buckets = std::move( buckets );
+}
+
+
+
+// insert( batch )
+void PersistentStorage::insert( std::size_t offset, std::vector<GroceryItem> && groceryItems )
+{
+  if( groceryItems.empty() ) return;
+
+  // As TreeStorage does:  build the batch into a treap of its own in linear time with the stack based Cartesian tree construction,
+  // then splice it in with one split and two merges.  The nodes are still private to this function while they're linked, so
+  // they're built mutable and frozen when done.
+  std::vector<std::shared_ptr<Node>> spine;
+  auto freeze = []( std::shared_ptr<Node> const & node ) { node->count = 1 + countOf( node->left ) + countOf( node->right ); };
+  auto buckets = _buckets;
+
+  for( auto & groceryItem : groceryItems )
+  {
+    auto const hash = std::hash<GroceryItem>{}( groceryItem );
+    auto       node = std::allocate_shared<Node>( _allocator, Node{ std::allocate_shared<GroceryItem const>( _allocator, std::move( groceryItem ) ), nextPriority(), 1, nullptr, nullptr } );
+    buckets = withItem( buckets, hash, node->item );
+
+    std::shared_ptr<Node> popped;
+    while( !spine.empty()  &&  spine.back()->priority < node->priority )
+    {
+      popped = std::move( spine.back() );
+      spine.pop_back();
+      freeze( popped );
+    }
+
+    node->left = std::move( popped );
+    if( !spine.empty() )   spine.back()->right = node;
+    spine.push_back( std::move( node ) );
+  }
+  for( auto node = spine.rbegin();  node != spine.rend();  ++node )   freeze( *node );
+
+  auto const [top, bottom] = split( _root, offset );
+  auto       root = merge( merge( top, spine.front() ), bottom );
+
+  _root    = std::move( root    );
+  _buckets = std::move( buckets );
+}
+
+
+
+// erase()
+void PersistentStorage::erase( std::size_t offset )
+{
+  auto const [top,     rest  ] = split( _root, offset );
+  auto const [removed, bottom] = split( rest,  1      );
+  auto       buckets = without( _buckets, std::hash<GroceryItem>{}( *removed->item ), removed->item.get() );
+  auto       root    = merge( top, bottom );
+
+  _root    = std::move( root    );
+  _buckets = std::move( buckets );
+}
+
+
+
+// nextPriority()
+std::uint64_t PersistentStorage::nextPriority() noexcept
+{
+  // SplitMix64 over a counter, as TreeStorage draws them
+  return nextSplitMix64( _seed );
+}
+
+
+
+// makeNode()
+PersistentStorage::NodePtr PersistentStorage::makeNode( Node const & node, NodePtr left, NodePtr right ) const
+{
+  auto const count = 1 + countOf( left ) + countOf( right );
+  return std::allocate_shared<Node const>( _allocator, Node{ node.item, node.priority, count, std::move( left ), std::move( right ) } );
+}
+
+
+
+// countOf()
+std::size_t PersistentStorage::countOf( NodePtr const & node ) noexcept
+{
+  return node == nullptr ? 0 : node->count;
+}
+
+
+
+// merge()
+PersistentStorage::NodePtr PersistentStorage::merge( NodePtr const & top, NodePtr const & bottom ) const
+{
+  // As TreeStorage::merge(), but every node whose subtree changes is a new copy rather than changed in place
+  if( top    == nullptr ) return bottom;
+  if( bottom == nullptr ) return top;
+
+  if( top->priority > bottom->priority )   return makeNode( *top,    top->left,                     merge( top->right, bottom ) );
+  else                                     return makeNode( *bottom, merge( top, bottom->left ), bottom->right                );
+}
+
+
+
+// split()
+std::pair<PersistentStorage::NodePtr, PersistentStorage::NodePtr> PersistentStorage::split( NodePtr const & node, std::size_t count ) const
+{
+  // As TreeStorage::split(), copying instead of changing.  Subtrees entirely on one side are shared, not copied.
+  if( node == nullptr       ) return { nullptr, nullptr };
+  if( count == 0            ) return { nullptr, node    };
+  if( count >= node->count  ) return { node,    nullptr };
+
+  if( auto const above = countOf( node->left );  count <= above )
+  {
+    auto [top, bottom] = split( node->left, count );
+    return { std::move( top ), makeNode( *node, std::move( bottom ), node->right ) };
+  }
+  else
+  {
+    auto [top, bottom] = split( node->right, count - above - 1 );
+    return { makeNode( *node, node->left, std::move( top ) ), std::move( bottom ) };
+  }
+}
+
+
+
+// isConsistant()
+bool PersistentStorage::isConsistant( Node const * node, std::uint64_t ceiling ) noexcept
+{
+  if( node == nullptr ) return true;
+
+  if( node->item     == nullptr                                           ) return false;
+  if( node->priority >  ceiling                                           ) return false;
+  if( node->count    != 1 + countOf( node->left ) + countOf( node->right ) ) return false;
+
+  return isConsistant( node->left.get(), node->priority )  &&  isConsistant( node->right.get(), node->priority );
+}
+
+
+
+// makeBucket()
+PersistentStorage::BucketPtr PersistentStorage::makeBucket( std::size_t hash, Items items, BucketPtr left, BucketPtr right ) const
+{
+  return std::allocate_shared<Bucket const>( _allocator, Bucket{ hash, std::move( items ), std::move( left ), std::move( right ) } );
+}
+
+
+
+// makeBucket( copy )
+PersistentStorage::BucketPtr PersistentStorage::makeBucket( Bucket const & bucket, BucketPtr left, BucketPtr right ) const
+{
+  return makeBucket( bucket.hash, Items( bucket.items, _allocator ), std::move( left ), std::move( right ) );
+}
+
+
+
+// priorityOf()
+std::uint64_t PersistentStorage::priorityOf( std::size_t hash ) noexcept
+{
+  // A bucket's priority is a function of its hash, so it needn't be stored.  SplitMix64's finalizer is a bijection, so buckets with
+  // different hashes never tie.
+  return splitMix64( hash );
+}
+
+
+
+// bucketOf()
+PersistentStorage::Bucket const * PersistentStorage::bucketOf( BucketPtr const & root, std::size_t hash ) noexcept
+{
+  auto bucket = root.get();
+  while( bucket != nullptr  &&  bucket->hash != hash )   bucket = ( hash < bucket->hash ? bucket->left : bucket->right ).get();
+  return bucket;
+}
+
+
+
+// withItem()
+PersistentStorage::BucketPtr PersistentStorage::withItem( BucketPtr const & root, std::size_t hash, ItemPtr const & item ) const
+{
+  // Path copying, as the tree does.  A new bucket that outranks the one it meets on the way down takes its place, with that
+  // subtree split around it.
+  if( root == nullptr  ||  ( root->hash != hash  &&  priorityOf( hash ) > priorityOf( root->hash ) ) )
+  {
+    auto [low, high] = split( root, hash );
+    return makeBucket( hash, Items( { item }, _allocator ), std::move( low ), std::move( high ) );
+  }
+
+  if( root->hash == hash )
+  {
+    Items items( root->items, _allocator );
+    items.push_back( item );
+    return makeBucket( hash, std::move( items ), root->left, root->right );
+  }
+
+  if( hash < root->hash ) return makeBucket( *root, withItem( root->left, hash, item ), root->right );
+  else                    return makeBucket( *root, root->left, withItem( root->right, hash, item ) );
+}
+
+
+
+// without()
+PersistentStorage::BucketPtr PersistentStorage::without( BucketPtr const & root, std::size_t hash, GroceryItem const * item ) const
+{
+  // The grocery item removed is the very one held at that address, not just any equal to it
+  if( root == nullptr ) return root;
+
+  if( root->hash == hash )
+  {
+    Items items( root->items, _allocator );
+    std::erase_if( items, [&]( ItemPtr const & held ) noexcept { return held.get() == item; } );
+    if( items.empty() ) return merge( root->left, root->right );
+    return makeBucket( hash, std::move( items ), root->left, root->right );
+  }
+
+  if( hash < root->hash ) return makeBucket( *root, without( root->left, hash, item ), root->right );
+  else                    return makeBucket( *root, root->left, without( root->right, hash, item ) );
+}
+
+
+
+// merge( buckets )
+PersistentStorage::BucketPtr PersistentStorage::merge( BucketPtr const & low, BucketPtr const & high ) const
+{
+  if( low  == nullptr ) return high;
+  if( high == nullptr ) return low;
+
+  if( priorityOf( low->hash ) > priorityOf( high->hash ) )   return makeBucket( *low,  low->left,               merge( low->right, high ) );
+  else                                                       return makeBucket( *high, merge( low, high->left ), high->right               );
+}
+
+
+
+// split( buckets )
+std::pair<PersistentStorage::BucketPtr, PersistentStorage::BucketPtr> PersistentStorage::split( BucketPtr const & root, std::size_t hash ) const
+{
+  if( root == nullptr ) return { nullptr, nullptr };
+
+  if( root->hash < hash )
+  {
+    auto [low, high] = split( root->right, hash );
+    return { makeBucket( *root, root->left, std::move( low ) ), std::move( high ) };
+  }
+  else
+  {
+    auto [low, high] = split( root->left, hash );
+    return { std::move( low ), makeBucket( *root, std::move( high ), root->right ) };
+  }
+}
+
+
+
+// isConsistant( buckets )
+bool PersistentStorage::isConsistant( Bucket const * bucket, std::uint64_t ceiling, Bucket const * & previous, std::size_t & items ) noexcept
+{
+  // Checked in order, so each hash must be above the one visited before it
+  if( bucket == nullptr ) return true;
+
+  auto const priority = priorityOf( bucket->hash );
+  if( priority > ceiling                                                     ) return false;
+  if( !isConsistant( bucket->left.get(), priority, previous, items )        ) return false;
+  if( previous != nullptr  &&  previous->hash >= bucket->hash                ) return false;
+  if( bucket->items.empty()                                                  ) return false;
+
+  for( auto const & item : bucket->items )
+  {
+    if( item == nullptr  ||  std::hash<GroceryItem>{}( *item ) != bucket->hash ) return false;
+  }
+
+  previous = bucket;
+  items   += bucket->items.size();
+  return isConsistant( bucket->right.get(), priority, previous, items );
+}
+
+
+
+
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// SmallVectorStorage
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<std::size_t N>
+SmallVectorStorage<N>::SmallVectorStorage( std::pmr::memory_resource * resource )
+  : _items( resource )
+{}
+
+
+
+template<std::size_t N>  std::pmr::memory_resource *                    SmallVectorStorage<N>::resource() const noexcept               { return _items.get_allocator().resource(); }
+template<std::size_t N>  typename SmallVectorStorage<N>::const_iterator SmallVectorStorage<N>::begin() const noexcept                  { return _items.cbegin();  }
+template<std::size_t N>  typename SmallVectorStorage<N>::const_iterator SmallVectorStorage<N>::end  () const noexcept                  { return _items.cend  ();  }
+template<std::size_t N>  std::size_t                                    SmallVectorStorage<N>::size () const noexcept                  { return _items.size  ();  }
+template<std::size_t N>  GroceryItem const &                            SmallVectorStorage<N>::at   ( std::size_t offset ) const       { return _items[offset];   }
+template<std::size_t N>  bool                                           SmallVectorStorage<N>::sizesAreConsistant   () const noexcept  { return true;             }  // a single container can't disagree with itself
+template<std::size_t N>  bool                                           SmallVectorStorage<N>::contentsAreConsistant() const noexcept  { return true;             }
+
+
+
+// insert()
+template<std::size_t N>
+void SmallVectorStorage<N>::insert( std::size_t offset, GroceryItem const & groceryItem )
+{
+  _items.insert( std::next( _items.cbegin(), static_cast<std::ptrdiff_t>( offset ) ), groceryItem );
+}
+
+
+
+// insert( batch )
+template<std::size_t N>
+void SmallVectorStorage<N>::insert( std::size_t offset, std::vector<GroceryItem> && groceryItems )
+{
+  _items.insert( std::next( _items.cbegin(), static_cast<std::ptrdiff_t>( offset ) ),
+                 std::make_move_iterator( groceryItems.begin() ), std::make_move_iterator( groceryItems.end() ) );
+}
+
+
+
+// erase()
+template<std::size_t N>
+void SmallVectorStorage<N>::erase( std::size_t offset )
+{
+  _items.erase( std::next( _items.cbegin(), static_cast<std::ptrdiff_t>( offset ) ) );
+}
+
+
+
+template class SmallVectorStorage<defaultInlineCapacity>;
+
+
+
+
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ShadowStorage
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<std::size_t N>  typename ShadowStorage<N>::const_iterator ShadowStorage<N>::begin() const noexcept          { return _gList_vector.cbegin();  }
+template<std::size_t N>  typename ShadowStorage<N>::const_iterator ShadowStorage<N>::end  () const noexcept          { return _gList_vector.cend  ();  }
+template<std::size_t N>  std::size_t                               ShadowStorage<N>::size () const noexcept          { return _gList_vector.size  ();  }
+template<std::size_t N>  GroceryItem const &                       ShadowStorage<N>::at   ( std::size_t offset ) const { return _gList_vector[offset];   }
+
+
+
+// insert()
+template<std::size_t N>
+void ShadowStorage<N>::insert( std::size_t offsetFromTop, GroceryItem const & groceryItem )    // insert provided grocery item at offsetFromTop, which places it before the current grocery item at offsetFromTop
+{
+  // Inserting into the grocery list means you insert the grocery item into each of the containers (array, vector, list, and
+  // forward_list). Because the data structure concept is different for each container, the way a grocery item gets inserted is a
+  // little different for each.  You are to insert the grocery item into each container such that the ordering of all the containers
+  // is the same.  A check is made by the grocery list afterwards to verify the contents of all four containers are indeed the same.
+
+
+  { /**********  Part 1 - Insert into small vector  **************/
+      /// The first N grocery items live inside the small vector itself, after that it moves them to the heap and grows
+      /// geometrically just like std::vector.  Either way, SmallVector::insert() shifts to the right everything at and after the
+      /// insertion point opening a gap for the new grocery item, so there's no fixed capacity to run out of.
+      _gList_array.insert( std::next( _gList_array.cbegin(), static_cast<std::ptrdiff_t>( offsetFromTop ) ), groceryItem );
+  } // Part 1 - Insert into small vector
+
+
+
+
+  { /**********  Part 2 - Insert into vector  **********************/
+    ///////////////////////// TO-DO (5) //////////////////////////////
+      /// The vector STL container std::vector has an insert function, which can be directly used here.  But that function takes a
+      /// pointer (or more accurately, an iterator) that points to the grocery item to insert before.  You need to convert the
+      /// zero-based offset from the top (the index) to an iterator by advancing _gList_vector.begin() offsetFromTop times.  The STL
+      /// has a function called std::next() that does that, or you can use simple pointer arithmetic to calculate it.  "Vector.hpp"
+      /// in our Sequence Container Implementation Examples also shows you how convert index to iterator, and iterator to index.
+      ///
+      /// Behind the scenes, std::vector::insert() shifts to the right everything at and after the insertion point, just like you
+      /// did for the small vector above.
+    _gList_vector.insert(std::next(_gList_vector.begin(), offsetFromTop), groceryItem);
+    /////////////////////// END-TO-DO (5) ////////////////////////////
+  } // Part 2 - Insert into vector
+
+
+
+
+  { /**********  Part 3 - Insert into doubly linked list  **********/
+    ///////////////////////// TO-DO (6) //////////////////////////////
+      /// The doubly linked list STL container std::list has an insert function, which can be directly used here.  But that function
+      /// takes a pointer (or more accurately, an iterator) that points to the grocery item to insert before.  You need to convert
+      /// the zero-based offset from the top (the index) to an iterator by advancing _gList_dll.begin() offsetFromTop times.  The
+      /// STL has a function called std::next() that does that, or you can write your own loop.
+    _gList_dll.insert(std::next(_gList_dll.begin(), offsetFromTop), groceryItem);
+    /////////////////////// END-TO-DO (6) ////////////////////////////
+  } // Part 3 - Insert into doubly linked list
+
+
+
+
+  { /**********  Part 4 - Insert into singly linked list  **********/
+    ///////////////////////// TO-DO (7) //////////////////////////////
+      /// The singly linked list STL container std::forward_list has an insert function, which can be directly used here.  But that
+      /// function inserts AFTER the grocery item pointed to, not before like the other containers.  A singly linked list cannot
+      /// look backwards, only forward.  You need to convert the zero-based offset from the top (the index) to an iterator by
+      /// advancing _gList_sll.before_begin() offsetFromTop times.  The STL has a function called std::next() that does that, or you
+      /// can write your own loop.
+    _gList_sll.insert_after(std::next(_gList_sll.before_begin(), offsetFromTop), groceryItem);
+    /////////////////////// END-TO-DO (7) ////////////////////////////
+  } // Part 4 - Insert into singly linked list
+} // insert( std::size_t offsetFromTop, const GroceryItem & groceryItem )
+
+
+
+// insert( batch )
+template<std::size_t N>
+void ShadowStorage<N>::insert( std::size_t offsetFromTop, std::vector<GroceryItem> && groceryItems )
+{
+  // Same four parts as inserting a single grocery item, but each container opens its gap (or walks to its insertion point) only
+  // once for the whole batch.  The last container gets to move the grocery items, the others copy them.
+  auto const offset = static_cast<std::ptrdiff_t>( offsetFromTop );
+
+  _gList_array .insert      ( std::next( _gList_array .cbegin      (), offset ), groceryItems.cbegin(), groceryItems.cend() );
+  _gList_vector.insert      ( std::next( _gList_vector.cbegin      (), offset ), groceryItems.cbegin(), groceryItems.cend() );
+  _gList_dll   .insert      ( std::next( _gList_dll   .cbegin      (), offset ), groceryItems.cbegin(), groceryItems.cend() );
+  _gList_sll   .insert_after( std::next( _gList_sll   .cbefore_begin(), offset ), std::make_move_iterator( groceryItems.begin() ),
+                                                                                  std::make_move_iterator( groceryItems.end  () ) );
+} // insert( std::size_t offsetFromTop, std::vector<GroceryItem> && groceryItems )
+
+
+
+// erase()
+template<std::size_t N>
+void ShadowStorage<N>::erase( std::size_t offsetFromTop )
+{
+  // Removing from the grocery list means you remove the grocery item from each of the containers (array, vector, list, and
+  // forward_list). Because the data structure concept is different for each container, the way a grocery item gets removed is a
+  // little different for each.  You are to remove the grocery item from each container such that the ordering of all the containers
+  // is the same.  A check is made by the grocery list afterwards to verify the contents of all four containers are indeed the same.
+
+
+  { /**********  Part 1 - Remove from small vector  ************/
+      /// SmallVector::erase() closes the hole by shifting to the left everything after the remove point, then destroys the (now
+      /// moved from) last grocery item.
+      _gList_array.erase( std::next( _gList_array.cbegin(), static_cast<std::ptrdiff_t>( offsetFromTop ) ) );
+  } // Part 1 - Remove from small vector
+
+
+
+
+  { /**********  Part 2 - Remove from vector  **********************/
+    ///////////////////////// TO-DO (9) //////////////////////////////
+      /// The vector STL container std::vector has an erase function, which can be directly used here.  But that function takes a
+      /// pointer (or more accurately, an iterator) that points to the grocery item to be removed.  You need to convert the
+      /// zero-based offset from the top (the index) to an iterator by advancing _gList_vector.begin() offsetFromTop times.  The STL
+      /// has a function called std::next() that does that, or you can use simple pointer arithmetic to calculate it.  "Vector.hpp"
+      /// in our Sequence Container Implementation Examples also shows you how convert index to iterator, and iterator to index.
+      ///
+      /// Behind the scenes, std::vector::erase() shifts to the left everything after the insertion point, just like you did for the
+      /// array above.
+      _gList_vector.erase(std::next(_gList_vector.begin(), offsetFromTop));
+    /////////////////////// END-TO-DO (9) ////////////////////////////
+  } // Part 2 - Remove from vector
+
+
+
+
+  { /**********  Part 3 - Remove from doubly linked list  **********/
+    ///////////////////////// TO-DO (10) //////////////////////////////
+      /// The doubly linked list STL container std::list has an erase function, which can be directly used here.  But that function
+      /// takes a pointer (or more accurately, an iterator) that points to the grocery item to remove.  You need to convert the
+      /// zero-based offset from the top (the index) to an iterator by advancing _gList_dll.begin() offsetFromTop times.  The STL
+      /// has a function called std::next() that does that, or you can write your own loop.
+      _gList_dll.erase(std::next(_gList_dll.begin(), offsetFromTop));
+    /////////////////////// END-TO-DO (10) ////////////////////////////
+  } // Part 3 - Remove from doubly linked list
+
+
+
+
+  { /**********  Part 4 - Remove from singly linked list  **********/
+    ///////////////////////// TO-DO (11) //////////////////////////////
+      /// The singly linked list STL container std::forward_list has an erase function, which can be directly used here.  But that
+      /// function erases AFTER the grocery item pointed to, not the one pointed to like the other containers.  A singly linked list
+      /// cannot look backwards, only forward.  You need to convert the zero-based offset from the top (the index) to an iterator by
+      /// advancing _gList_sll.before_begin() offsetFromTop times.  The STL has a function called std::next() that does that, or you
+      /// can write your own loop.
+      _gList_sll.erase_after(std::next(_gList_sll.before_begin(), offsetFromTop));
+    /////////////////////// END-TO-DO (11) ////////////////////////////
+  } // Part 4 - Remove from singly linked list
+} // erase( std::size_t offsetFromTop )
+
+
+
+// sizesAreConsistant() const
+template<std::size_t N>
+bool ShadowStorage<N>::sizesAreConsistant() const noexcept
+{
+  // The forward_list's size has to be counted, so it's left to the full check
+  return _gList_array.size() == _gList_vector.size()
+      && _gList_array.size() == _gList_dll   .size();
+}
+
+
+
+// contentsAreConsistant() const
+template<std::size_t N>
+bool ShadowStorage<N>::contentsAreConsistant() const
+{
+  // Sizes of all containers must be equal to each other
+  if(    !sizesAreConsistant()
+      || _gList_array.size() !=  gList_sll_size() ) return false;
+
+  // Element content and order must be equal to each other
+  auto current_array_position   = _gList_array .cbegin();
+  auto current_vector_position  = _gList_vector.cbegin();
+  auto current_dll_position     = _gList_dll   .cbegin();
+  auto current_sll_position     = _gList_sll   .cbegin();
+
+  auto end = _gList_vector.cend();
+  while( current_vector_position != end )
+  {
+    if(    *current_array_position != *current_vector_position
+       || *current_array_position != *current_dll_position
+       || *current_array_position != *current_sll_position ) return false;
+
+    // Advance the iterators to the next element in unison
+    ++current_array_position;
+    ++current_vector_position;
+    ++current_dll_position;
+    ++current_sll_position;
+  }
+
+  return true;
+}
+
+
+
+// gList_sll_size() const
+template<std::size_t N>
+std::size_t ShadowStorage<N>::gList_sll_size() const
+{
+  ///////////////////////// TO-DO (17) //////////////////////////////
+    /// Some implementations of a singly linked list maintain the size (number of elements in the list).  std::forward_list does
+    /// not. The size of singly linked list must be calculated on demand by walking the list from beginning to end counting the
+    /// number of elements visited.  The STL's std::distance() function does that, or you can write your own loop.
+  return std::distance(_gList_sll.begin(), _gList_sll.end());
+  
+  /////////////////////// END-TO-DO (17) ////////////////////////////
+}
+
+
+
+
+template class ShadowStorage<defaultInlineCapacity>;
@@ -0,0 +1,494 @@
+#pragma once                                                                                  // include guard
+
+#include <concepts>                                                                           // same_as, constructible_from
+#include <cstddef>                                                                            // size_t, ptrdiff_t
+#include <cstdint>                                                                            // uint64_t
+#include <forward_list>
+#include <iterator>                                                                           // forward_iterator_tag
+#include <list>
+#include <memory>                                                                             // shared_ptr
+#include <memory_resource>                                                                    // memory_resource, polymorphic_allocator, pmr containers
+#include <unordered_set>
+#include <utility>                                                                            // pair
+#include <vector>
+
+#include "GroceryItem.hpp"
+#include "GroceryListBase.hpp"
+#include "SmallVector.hpp"
+
+
+// Storage policies for BasicGroceryList.  A storage policy owns the grocery items and keeps them in order, top to bottom.  It
+// knows nothing about duplicates, hash indexes, or offset validation - BasicGroceryList takes care of all that before asking the
+// policy to do anything.  Every storage policy provides:
+//
+//    const_iterator      begin() const, end() const           walks the grocery items top to bottom
+//    std::size_t         size () const                        number of grocery items held
+//    GroceryItem const & at   ( offset ) const                grocery item at (zero-based, valid) offset from top
+//    void                insert( offset, groceryItem )        inserts before the grocery item currently at offset (offset <= size())
+//    void                insert( offset, groceryItems )       inserts a whole batch (std::vector, moved from), in order, the same way
+//    void                erase ( offset )                     removes the grocery item at offset (offset < size())
+//    bool                sizesAreConsistant   () const        constant time internal checks
+//    bool                contentsAreConsistant() const        complete internal checks
+//
+// A storage policy may also locate grocery items itself (see LocatingStorage below), or at least say which it holds (see
+// ScreeningStorage below), and move one to the top without taking it out and putting it back (see SplicingStorage below):
+//
+//    std::size_t         offsetOf ( groceryItem ) const       offset of the grocery item from top, size() if not held
+//    bool                contains ( groceryItem ) const       true if the grocery item is held
+//    bool                moveToTop( groceryItem )             relinks the grocery item at the top, false (and no change) if not held
+//
+// and allocate its nodes from a memory resource the caller supplies (see AllocatorAwareStorage below).
+//
+// SmallVectorStorage is the default.  TreeStorage is for very long grocery lists edited in the middle.  PersistentStorage is for
+// grocery lists copied far more often than they're changed - snapshots, undo history, copies passed by value.  ShadowStorage
+// mirrors every change across four different containers and verifies they agree, so it's four times the work but makes a great
+// reference implementation to validate the others against.
+//
+// The policies taking an inline capacity (N) are implemented in GroceryListStorage.cpp and explicitly instantiated there for the
+// default capacity.  Add an instantiation there (and in GroceryList.cpp) to use another.
+inline constexpr std::size_t defaultInlineCapacity = 11;                                     // grocery items held without a heap allocation
+
+
+
+// Storage policies that can say where a grocery item is without being walked.  BasicGroceryList answers find() by asking them,
+// rather than by searching or keeping a hash index of its own.
+template<typename Storage>
+concept LocatingStorage = requires( Storage const & storage, GroceryItem const & groceryItem )
+{
+  { storage.offsetOf( groceryItem ) } -> std::same_as<std::size_t>;
+};
+
+
+
+// Storage policies that can say whether they hold a grocery item without being walked, but not where.  BasicGroceryList asks them
+// first, so the duplicate check on insertion needs no hash index of its own and find() turns away a grocery item that isn't held
+// without a search.  Finding one that is held is still a linear search, unless the grocery list is indexed.
+template<typename Storage>
+concept ScreeningStorage = requires( Storage const & storage, GroceryItem const & groceryItem )
+{
+  { storage.contains( groceryItem ) } -> std::same_as<bool>;
+};
+
+
+
+// Storage policies that can move a grocery item to the top in place.  BasicGroceryList::moveToTop() hands the whole job to them
+// rather than finding, removing, and reinserting (a copy, and another duplicate check) the grocery item.
+template<typename Storage>
+concept SplicingStorage = requires( Storage & storage, GroceryItem const & groceryItem )
+{
+  { storage.moveToTop( groceryItem ) } -> std::same_as<bool>;
+};
+
+
+
+// Storage policies that can allocate from a caller's memory resource - an arena (std::pmr::monotonic_buffer_resource) or pool -
+// instead of the heap.  BasicGroceryList passes one along when constructed with it.  As with the std::pmr containers, the resource
+// is fixed for the storage's lifetime:  assigning copies grocery items into it, and copies of the storage allocate from the default
+// resource (std::pmr::get_default_resource()) unless given one.  Everything the storage holds comes from the resource, the grocery
+// items' product names included (grocery items are allocator aware, see GroceryItem), so a grocery list given an arena allocates
+// nothing from the global heap per grocery item.  resource() says which it is, so BasicGroceryList can gather a batch of grocery
+// items there too and have it move into the storage without being copied again.
+template<typename Storage>
+concept AllocatorAwareStorage = std::constructible_from<Storage, std::pmr::memory_resource *>
+                             && requires( Storage const & storage ) { { storage.resource() } -> std::same_as<std::pmr::memory_resource *>; };
+
+
+
+// Grocery items held in a single SmallVector.  Like VectorStorage, but the first N grocery items live inside the grocery list
+// itself, so short grocery lists never allocate.
+template<std::size_t N = defaultInlineCapacity>
+class SmallVectorStorage
+{
+  private:
+    using Items = SmallVector<GroceryItem, N, std::pmr::polymorphic_allocator<GroceryItem>>;
+
+  public:
+    using const_iterator = typename Items::const_iterator;
+
+    SmallVectorStorage() = default;                                                           // allocates from the default resource
+    explicit SmallVectorStorage( std::pmr::memory_resource * resource );                      // allocates from resource, which must outlive the storage
+
+    std::pmr::memory_resource * resource() const noexcept;
+
+    const_iterator      begin() const noexcept;
+    const_iterator      end  () const noexcept;
+    std::size_t         size () const noexcept;
+    GroceryItem const & at   ( std::size_t offset ) const;
+
+    void insert( std::size_t offset, GroceryItem const &        groceryItem  );
+    void insert( std::size_t offset, std::vector<GroceryItem> && groceryItems );
+    void erase ( std::size_t offset                                           );
+
+    bool sizesAreConsistant   () const noexcept;
+    bool contentsAreConsistant() const noexcept;
+
+  private:
+    Items _items;
+};
+
+
+
+// Grocery items held in a single std::vector.  Constant time access by offset, linear time insertion and removal (but of a
+// contiguous block, so the shifting is cheap).
+class VectorStorage
+{
+  public:
+    using const_iterator = std::pmr::vector<GroceryItem>::const_iterator;
+
+    VectorStorage() = default;                                                                // allocates from the default resource
+    explicit VectorStorage( std::pmr::memory_resource * resource );                           // allocates from resource, which must outlive the storage
+
+    std::pmr::memory_resource * resource() const noexcept;
+
+    const_iterator      begin() const noexcept;
+    const_iterator      end  () const noexcept;
+    std::size_t         size () const noexcept;
+    GroceryItem const & at   ( std::size_t offset ) const;
+
+    void insert( std::size_t offset, GroceryItem const &        groceryItem  );
+    void insert( std::size_t offset, std::vector<GroceryItem> && groceryItems );
+    void erase ( std::size_t offset                                           );
+
+    bool sizesAreConsistant   () const noexcept;
+    bool contentsAreConsistant() const noexcept;
+
+  private:
+    std::pmr::vector<GroceryItem> _items;
+};
+
+
+
+// Grocery items held in a single std::list.  Nothing ever moves once inserted, but reaching an offset means walking from the
+// nearest end.  Every node is also in a hash set keyed by its grocery item, so moveToTop() goes straight to the node and splices it
+// to the front in constant time (expected) - most recently used ordering for free.
+class ListStorage
+{
+  public:
+    using const_iterator = std::pmr::list<GroceryItem>::const_iterator;
+
+    ListStorage() = default;                                                                  // allocates from the default resource
+    explicit ListStorage( std::pmr::memory_resource * resource );                             // allocates from resource, which must outlive the storage
+    ListStorage( ListStorage const &  other );
+    ListStorage( ListStorage const &  other, std::pmr::memory_resource * resource );
+    ListStorage( ListStorage       && other ) noexcept = default;                             // the nodes move, and so does the resource they came from
+    ListStorage & operator=( ListStorage         rhs );                                       // copy and swap, keeping this storage's resource
+   ~ListStorage() noexcept = default;
+
+    std::pmr::memory_resource * resource() const noexcept;
+
+    const_iterator      begin() const noexcept;
+    const_iterator      end  () const noexcept;
+    std::size_t         size () const noexcept;
+    GroceryItem const & at   ( std::size_t offset ) const;
+
+    void insert( std::size_t offset, GroceryItem const &        groceryItem  );
+    void insert( std::size_t offset, std::vector<GroceryItem> && groceryItems );
+    void erase ( std::size_t offset                                           );
+    bool moveToTop( GroceryItem const & groceryItem );
+
+    bool sizesAreConsistant   () const noexcept;
+    bool contentsAreConsistant() const noexcept;
+
+  private:
+    struct NodeHash                                                                           // nodes hash and compare by their grocery items, so a grocery item
+    {                                                                                         // can be looked up directly
+      using is_transparent = void;
+      std::size_t operator()( const_iterator      node        ) const noexcept;
+      std::size_t operator()( GroceryItem const & groceryItem ) const noexcept;
+    };
+
+    struct NodeEqual
+    {
+      using is_transparent = void;
+      bool operator()( const_iterator      lhs, const_iterator      rhs ) const noexcept;
+      bool operator()( GroceryItem const & lhs, const_iterator      rhs ) const noexcept;
+      bool operator()( const_iterator      lhs, GroceryItem const & rhs ) const noexcept;
+    };
+
+    // Instance Attributes
+    std::pmr::list<GroceryItem>                                      _items;
+    std::pmr::unordered_multiset<const_iterator, NodeHash, NodeEqual> _nodes;                 // every node of _items, by grocery item.  Same resource as _items
+
+
+    // Helper member functions
+    const_iterator iteratorAt( std::size_t offset ) const;                                    // walks from whichever end is closer
+    void           record    ( const_iterator first, const_iterator last );                   // adds [first, last) to _nodes, or takes them back out of _items if it can't
+    void           forget    ( const_iterator node ) noexcept;                                // removes node (and only node) from _nodes
+};
+
+
+
+// Grocery items held in an order statistics tree - a treap (a binary search tree by position, heap ordered by random priority, so
+// expected logarithmic depth) with each node counting the grocery items in its subtree.  Reaching, inserting, and removing at any
+// offset is logarithmic time, and nothing ever moves once inserted.  Every node is also in a hash set keyed by its grocery item,
+// and climbing from a node to the root adds up its offset, so offsetOf() is logarithmic time too.  Walking the grocery items is
+// linear, but each step may climb or descend the tree, so it's slower than walking a vector.
+class TreeStorage
+{
+  private:
+    struct Node;
+
+  public:
+    class const_iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = GroceryItem;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = GroceryItem const *;
+        using reference         = GroceryItem const &;
+
+        const_iterator() noexcept = default;
+
+        reference        operator* () const noexcept;
+        pointer          operator->() const noexcept;
+        const_iterator & operator++()       noexcept;                                        // in order successor
+        const_iterator   operator++( int )  noexcept;
+
+        bool operator==( const_iterator const & ) const noexcept = default;
+
+      private:
+        friend class TreeStorage;
+        explicit const_iterator( Node const * node ) noexcept;
+
+        Node const * _node = nullptr;                                                          // nullptr is end()
+    };
+
+    TreeStorage() = default;                                                                  // allocates from the default resource
+    explicit TreeStorage( std::pmr::memory_resource * resource );                             // allocates from resource, which must outlive the storage
+    TreeStorage( TreeStorage const &  other );
+    TreeStorage( TreeStorage const &  other, std::pmr::memory_resource * resource );
+    TreeStorage( TreeStorage       && other ) noexcept;                                       // the nodes move, and so does the resource they came from
+    TreeStorage & operator=( TreeStorage         rhs );                                       // copy and swap, keeping this storage's resource
+   ~TreeStorage() noexcept;
+
+    std::pmr::memory_resource * resource() const noexcept;
+
+    const_iterator      begin() const noexcept;
+    const_iterator      end  () const noexcept;
+    std::size_t         size () const noexcept;
+    GroceryItem const & at   ( std::size_t offset ) const;
+
+    std::size_t offsetOf( GroceryItem const & groceryItem ) const;                            // size() if not held
+
+    void insert( std::size_t offset, GroceryItem const &        groceryItem  );
+    void insert( std::size_t offset, std::vector<GroceryItem> && groceryItems );
+    void erase ( std::size_t offset                                           );
+    bool moveToTop( GroceryItem const & groceryItem );
+
+    bool sizesAreConsistant   () const noexcept;
+    bool contentsAreConsistant() const noexcept;
+
+  private:
+    struct Node
+    {
+      GroceryItem   item;
+      std::uint64_t priority = 0;                                                            // larger priorities are nearer the root
+      std::size_t   count    = 1;                                                            // grocery items in this subtree, this one included
+      Node *        parent   = nullptr;
+      Node *        left     = nullptr;
+      Node *        right    = nullptr;
+    };
+
+    struct NodeHash                                                                           // nodes hash and compare by their grocery items, so a grocery item
+    {                                                                                         // can be looked up directly
+      using is_transparent = void;
+      std::size_t operator()( Node const *        node        ) const noexcept;
+      std::size_t operator()( GroceryItem const & groceryItem ) const noexcept;
+    };
+
+    struct NodeEqual
+    {
+      using is_transparent = void;
+      bool operator()( Node const *        lhs, Node const * rhs ) const noexcept;
+      bool operator()( GroceryItem const & lhs, Node const * rhs ) const noexcept;
+      bool operator()( Node const *        lhs, GroceryItem const & rhs ) const noexcept;
+    };
+
+    // Instance Attributes
+    Node *                                                    _root = nullptr;
+    std::pmr::unordered_multiset<Node *, NodeHash, NodeEqual> _nodes;                         // every node, by grocery item.  Also owns them, allocated from the same
+                                                                                              // resource (see allocator() and the destructor)
+    std::uint64_t                                             _seed = 0;                      // next priority is drawn from here
+
+
+    // Helper member functions
+    std::pmr::polymorphic_allocator<Node>
+                               allocator() const noexcept;                                    // allocates nodes from _nodes' resource
+    Node *                     makeNode( GroceryItem && groceryItem );                        // allocated (product name and all), prioritized, and recorded in _nodes
+    Node *                     build   ( std::vector<Node *> const & nodes );                 // a treap of nodes, in order, in linear time
+    Node *                     nodeAt  ( std::size_t offset ) const noexcept;
+    Node *                     nodeOf  ( GroceryItem const & groceryItem ) const noexcept;   // the topmost node holding groceryItem, nullptr if none
+    void                       detach  ( Node * node ) noexcept;                              // unlinks node from the tree, but keeps it
+    void                       forget  ( Node * node ) noexcept;                              // removed from _nodes and deallocated
+    Node *                     clone   ( Node const * node, Node * parent );                  // a copy of node's subtree, recorded in _nodes
+    bool                       isConsistant( Node const * node, Node const * parent ) const noexcept;
+
+    static std::size_t         countOf ( Node const * node ) noexcept;                        // 0 for an empty subtree
+    static void                update  ( Node * node ) noexcept;                              // recount node and re-parent its children
+    static std::size_t         rank    ( Node const * node ) noexcept;                        // node's offset from top
+    static Node *              merge   ( Node * top, Node * bottom ) noexcept;                // every node of top comes before every node of bottom
+    static std::pair<Node *, Node *>
+                               split   ( Node * node, std::size_t count ) noexcept;           // the first count grocery items, and the rest
+};
+
+
+
+// Grocery items held in a persistent order statistics tree - a treap like TreeStorage's, but whose nodes are immutable and shared
+// between copies.  Copying is constant time, just another reference to the same root.  A change copies only the nodes on the paths
+// it touches (logarithmic time, expected) and leaves every other copy, and the nodes they share, untouched, so any copy kept is a
+// snapshot of the grocery list as it was.  The grocery items themselves are never copied, nodes share them too.  Reaching any
+// offset is logarithmic time, walking is linear.
+//
+// Beside the tree, a second persistent treap keyed by hash holds the same grocery items, so contains() is logarithmic time - which
+// is what keeps the duplicate check on insertion cheap.  There's no way back up from a node shared by many trees to count its
+// offset, so this is a ScreeningStorage policy rather than a LocatingStorage one:  an indexed grocery list keeps its hash index
+// alongside to find grocery items, at the price of copying that index along with the grocery list.
+//
+// Only copies allocating from the same resource share nodes.  A copy given another resource (a copy of a grocery list in an arena,
+// say, which allocates from the default resource) copies every grocery item into it instead, in linear time, so no copy ever holds
+// on to nodes from a resource it wasn't given.
+class PersistentStorage
+{
+  private:
+    struct Node;
+    using NodePtr = std::shared_ptr<Node const>;
+
+  public:
+    class const_iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = GroceryItem;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = GroceryItem const *;
+        using reference         = GroceryItem const &;
+
+        const_iterator() noexcept = default;
+
+        reference        operator* () const noexcept;
+        pointer          operator->() const noexcept;
+        const_iterator & operator++();                                                        // in order successor
+        const_iterator   operator++( int );
+
+        bool operator==( const_iterator const & rhs ) const noexcept;
+
+      private:
+        friend class PersistentStorage;
+        explicit const_iterator( Node const * root );
+
+        void descend( Node const * node );                                                   // pushes node and its left spine
+
+        std::vector<Node const *> _path;                                                      // the current node on top, below it the ancestors still to come.  Empty is end()
+    };
+
+    PersistentStorage() = default;                                                            // allocates from the default resource
+    explicit PersistentStorage( std::pmr::memory_resource * resource );                       // allocates from resource, which must outlive the storage
+    PersistentStorage( PersistentStorage const &  other );
+    PersistentStorage( PersistentStorage const &  other, std::pmr::memory_resource * resource ); // shares other's nodes if they came from resource, otherwise copies into it
+    PersistentStorage( PersistentStorage       && other ) noexcept = default;                 // the nodes move, and so does the resource they came from
+    PersistentStorage & operator=( PersistentStorage rhs );                                   // copy and swap, keeping this storage's resource
+   ~PersistentStorage() noexcept = default;
+
+    std::pmr::memory_resource * resource() const noexcept;
+
+    const_iterator      begin() const;
+    const_iterator      end  () const noexcept;
+    std::size_t         size () const noexcept;
+    GroceryItem const & at   ( std::size_t offset ) const;
+
+    bool contains( GroceryItem const & groceryItem ) const;
+
+    void insert( std::size_t offset, GroceryItem const &        groceryItem  );
+    void insert( std::size_t offset, std::vector<GroceryItem> && groceryItems );
+    void erase ( std::size_t offset                                           );
+
+    bool sizesAreConsistant   () const noexcept;
+    bool contentsAreConsistant() const noexcept;
+
+  private:
+    using ItemPtr   = std::shared_ptr<GroceryItem const>;
+    using Items     = std::pmr::vector<ItemPtr>;
+    struct Bucket;
+    using BucketPtr = std::shared_ptr<Bucket const>;
+
+    struct Node
+    {
+      ItemPtr                            item;
+      std::uint64_t                      priority = 0;                                        // larger priorities are nearer the root
+      std::size_t                        count    = 1;                                        // grocery items in this subtree, this one included
+      NodePtr                            left;
+      NodePtr                            right;
+    };
+
+    struct Bucket                                                                             // the grocery items sharing a hash.  Ordered by hash, heap ordered by
+    {                                                                                         // priorityOf( hash )
+      std::size_t                        hash = 0;
+      Items                              items;
+      BucketPtr                          left;
+      BucketPtr                          right;
+    };
+
+    // Instance Attributes
+    std::pmr::polymorphic_allocator<> _allocator;                                             // every node, bucket, and grocery item is allocated with this
+    NodePtr                           _root;
+    BucketPtr                         _buckets;                                               // the same grocery items, by hash
+    std::uint64_t                     _seed = 0;                                              // next priority is drawn from here
+
+
+    // Helper member functions
+    std::uint64_t              nextPriority() noexcept;
+
+    NodePtr                    makeNode( Node const & node, NodePtr left, NodePtr right ) const;   // a copy of node, sharing its grocery item, with new subtrees
+    static std::size_t         countOf ( NodePtr const & node ) noexcept;                     // 0 for an empty subtree
+    NodePtr                    merge   ( NodePtr const & top, NodePtr const & bottom ) const; // every grocery item of top comes before every grocery item of bottom
+    std::pair<NodePtr, NodePtr>
+                               split   ( NodePtr const & node, std::size_t count ) const;     // the first count grocery items, and the rest
+    static bool                isConsistant( Node const * node, std::uint64_t ceiling ) noexcept;
+
+    BucketPtr                  makeBucket( std::size_t hash, Items items, BucketPtr left, BucketPtr right ) const;   // items must already be allocated with _allocator
+    BucketPtr                  makeBucket( Bucket const & bucket, BucketPtr left, BucketPtr right ) const;          // a copy of bucket with new subtrees
+    static std::uint64_t       priorityOf( std::size_t hash ) noexcept;
+    static Bucket const *      bucketOf  ( BucketPtr const & root, std::size_t hash ) noexcept;
+    BucketPtr                  withItem  ( BucketPtr const & root, std::size_t hash, ItemPtr const & item ) const;
+    BucketPtr                  without   ( BucketPtr const & root, std::size_t hash, GroceryItem const * item ) const;
+    BucketPtr                  merge     ( BucketPtr const & low,  BucketPtr const & high ) const;
+    std::pair<BucketPtr, BucketPtr>
+                               split     ( BucketPtr const & root, std::size_t hash ) const;  // hashes below hash, and above it.  hash itself mustn't be there
+    static bool                isConsistant( Bucket const * bucket, std::uint64_t ceiling, Bucket const * & previous, std::size_t & items ) noexcept;
+};
+
+
+
+// Grocery items replicated across a SmallVector (the first N grocery items held inline), std::vector, std::list, and
+// std::forward_list.  Operations performed on one container are replicated across all containers, and the consistency checks
+// verify they all agree.
+template<std::size_t N = defaultInlineCapacity>
+class ShadowStorage
+{
+  public:
+    using const_iterator = std::vector<GroceryItem>::const_iterator;
+
+    const_iterator      begin() const noexcept;
+    const_iterator      end  () const noexcept;
+    std::size_t         size () const noexcept;
+    GroceryItem const & at   ( std::size_t offset ) const;
+
+    void insert( std::size_t offset, GroceryItem const &        groceryItem  );
+    void insert( std::size_t offset, std::vector<GroceryItem> && groceryItems );
+    void erase ( std::size_t offset                                           );
+
+    bool sizesAreConsistant   () const noexcept;
+    bool contentsAreConsistant() const;
+
+  private:
+    // Instance Attributes
+    SmallVector      <GroceryItem, N>   _gList_array;                                         // underlying containers holding grocery items
+    std::vector      <GroceryItem   >   _gList_vector;                                        // operations performed on once container must be
+    std::list        <GroceryItem   >   _gList_dll;                                           // replicated across all containers
+    std::forward_list<GroceryItem   >   _gList_sll;
+
+
+    // Helper member functions
+    std::size_t gList_sll_size() const;                                                       // std::forward_list doesn't maintain size, so calculate it on demand
+};
@@ -0,0 +1,181 @@
+#include <cerrno>                                                                     // errno, EINTR
+#include <charconv>                                                                   // to_chars()
+#include <cstddef>                                                                    // size_t
+#include <string>
+#include <string_view>
+#include <system_error>                                                               // system_error, generic_category()
+
+#include <unistd.h>                                                                   // write()
+
+#include "ExceptionLocation.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryList.hpp"
+#include "GroceryListStorage.hpp"
+#include "GroceryListWriter.hpp"
+#include "Money.hpp"
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Constructors, assignments, and destructor
+*******************************************************************************/
+
+// Constructor - file descriptor
+GroceryListWriter::GroceryListWriter( int fileDescriptor )
+  : _fileDescriptor( fileDescriptor ), _text( _buffer )
+{
+  _buffer.reserve( BLOCK_SIZE + 1'024 );                                            // a block, plus the grocery item that fills it
+}
+
+
+
+// Constructor - std::string
+GroceryListWriter::GroceryListWriter( std::string & destination )
+  : _text( destination )
+{}
+
+
+
+// Destructor
+GroceryListWriter::~GroceryListWriter() noexcept
+{
+  try                { flush(); }
+  catch( ... )       {}                                                             // destructors mustn't throw, call flush() to hear about failures
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// write( groceryItem )
+GroceryListWriter & GroceryListWriter::write( GroceryItem const & groceryItem )
+{
+  appendQuoted( groceryItem.upcCode    () );   _text.append( ", " );
+  appendQuoted( groceryItem.brandName  () );   _text.append( ", " );
+  appendQuoted( groceryItem.productName() );   _text.append( ", " );
+  appendPrice ( groceryItem.exactPrice () );
+
+  if( _fileDescriptor >= 0  &&  _buffer.size() >= BLOCK_SIZE )   flush();
+  return *this;
+}
+
+
+
+// write( groceryList )
+template<typename StoragePolicy>
+GroceryListWriter & GroceryListWriter::write( BasicGroceryList<StoragePolicy> const & groceryList )
+{
+  if( !groceryList.containersAreConsistant() )   throw GroceryListBase::InvalidInternalState_Ex( "Container consistency error" exception_location );
+
+  // Each grocery item on a new line, preceded by its index (aka offset from top)
+  std::size_t count = 0;
+  for( auto const & groceryItem : groceryList._storage )
+  {
+    _text.push_back( '\n' );
+    appendIndex( count++ );
+    _text.append( ":  " );
+    write( groceryItem );
+  }
+  return *this;
+}
+
+
+
+// flush()
+void GroceryListWriter::flush()
+{
+  if( _fileDescriptor < 0 ) return;                                                 // the destination string already has everything
+
+  std::string_view pending = _buffer;
+  while( !pending.empty() )
+  {
+    auto const written = ::write( _fileDescriptor, pending.data(), pending.size() );
+    if( written < 0 )
+    {
+      if( errno == EINTR ) continue;
+      throw std::system_error( errno, std::generic_category(), "Unable to write grocery list text" exception_location );
+    }
+    pending.remove_prefix( static_cast<std::size_t>( written ) );
+  }
+  _buffer.clear();                                                                  // keeps its capacity for the next block
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Private member functions
+*******************************************************************************/
+
+// appendQuoted()
+void GroceryListWriter::appendQuoted( std::string_view text )
+{
+  // Copy the runs between characters needing an escape whole, rather than a character at a time
+  _text.push_back( '"' );
+  for( auto special = text.find_first_of( "\"\\" );  special != std::string_view::npos;  special = text.find_first_of( "\"\\" ) )
+  {
+    _text.append( text.substr( 0, special ) );
+    _text.push_back( '\\' );
+    _text.push_back( text[special] );
+    text.remove_prefix( special + 1 );
+  }
+  _text.append( text );
+  _text.push_back( '"' );
+}
+
+
+
+// appendIndex()
+void GroceryListWriter::appendIndex( std::size_t offset )
+{
+  char       digits[20];
+  auto const end    = std::to_chars( digits, digits + sizeof( digits ), offset ).ptr;
+  auto const length = static_cast<std::size_t>( end - digits );
+
+  if( length < 5 )   _text.append( 5 - length, ' ' );                               // right aligned in a field of 5, as setw( 5 ) does
+  _text.append( digits, length );
+}
+
+
+
+// appendPrice()
+void GroceryListWriter::appendPrice( Money price )
+{
+  char       buffer[48];
+  auto const end = price.toChars( buffer, buffer + sizeof( buffer ) ).ptr;
+  _text.append( buffer, static_cast<std::size_t>( end - buffer ) );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Explicit instantiations
+*******************************************************************************/
+
+template GroceryListWriter & GroceryListWriter::write( BasicGroceryList<SmallVectorStorage<>> const & );
+template GroceryListWriter & GroceryListWriter::write( BasicGroceryList<VectorStorage       > const & );
+template GroceryListWriter & GroceryListWriter::write( BasicGroceryList<ListStorage         > const & );
+template GroceryListWriter & GroceryListWriter::write( BasicGroceryList<TreeStorage         > const & );
+template GroceryListWriter & GroceryListWriter::write( BasicGroceryList<PersistentStorage   > const & );
+template GroceryListWriter & GroceryListWriter::write( BasicGroceryList<ShadowStorage<>     > const & );
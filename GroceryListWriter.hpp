@@ -0,0 +1,56 @@
+#pragma once                                                                                  // include guard
+
+#include <cstddef>                                                                            // size_t
+#include <string>
+#include <string_view>
+
+#include "GroceryItem.hpp"
+#include "GroceryList.hpp"
+#include "Money.hpp"
+
+
+// Writes grocery items and grocery lists in exactly the text the insertion operators write to a stream in its default state, but
+// without the stream machinery:  no sentries, no width and fill state, no locale, no virtual call per field.  Text is formatted
+// straight into one reusable buffer - numbers with std::to_chars, strings quoted and escaped as std::quoted would - and handed
+// over in large blocks, either to a file descriptor or by appending to a std::string.  For example:
+//
+//    GroceryListWriter( fileDescriptor ).write( groceryList );
+//
+// The destination must outlive the writer.  Text still buffered is written by flush() and by the destructor, but only flush()
+// reports failures.
+class GroceryListWriter
+{
+  public:
+    static constexpr std::size_t BLOCK_SIZE = 64 * 1024;                                      // bytes buffered before handing them to a file descriptor
+
+
+    // Constructors, assignments, and destructor
+    explicit GroceryListWriter( int           fileDescriptor );                               // writes to an open file descriptor, in blocks
+    explicit GroceryListWriter( std::string & destination    );                               // appends to destination, which is the buffer
+
+    GroceryListWriter            ( GroceryListWriter const & ) = delete;                      // owns buffered text, so no copies
+    GroceryListWriter & operator=( GroceryListWriter const & ) = delete;
+   ~GroceryListWriter            (                           ) noexcept;                      // flushes, ignoring failures
+
+
+    // Modifiers
+    GroceryListWriter & write( GroceryItem const & groceryItem );                             // as operator<<( std::ostream &, GroceryItem const & ) writes it
+
+    template<typename StoragePolicy>
+    GroceryListWriter & write( BasicGroceryList<StoragePolicy> const & groceryList );         // as operator<<( std::ostream &, BasicGroceryList const & ) writes it
+
+    void flush();                                                                             // hands any buffered text to the file descriptor.  Throws std::system_error
+
+
+  private:
+    // Instance Attributes
+    int           _fileDescriptor = -1;                                                       // -1 when writing to a std::string
+    std::string   _buffer;                                                                    // text not yet handed to the file descriptor
+    std::string & _text;                                                                      // where text is formatted:  _buffer, or the destination string
+
+
+    // Helper member functions
+    void appendQuoted( std::string_view text   );                                             // as std::quoted writes text
+    void appendIndex ( std::size_t      offset );                                             // as std::setw( 5 ) writes offset
+    void appendPrice ( Money            price  );
+};
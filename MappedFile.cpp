@@ -0,0 +1,109 @@
+#include <cerrno>                                                                     // errno
+#include <cstddef>                                                                    // size_t
+#include <filesystem>                                                                 // path
+#include <fstream>                                                                    // ifstream
+#include <iterator>                                                                   // istreambuf_iterator
+#include <string>
+#include <string_view>
+#include <system_error>                                                               // system_error, generic_category()
+
+#if __has_include( <sys/mman.h> )
+  #include <fcntl.h>                                                                  // open()
+  #include <sys/mman.h>                                                               // mmap(), munmap(), madvise()
+  #include <sys/stat.h>                                                               // fstat()
+  #include <unistd.h>                                                                 // close()
+  #define MAPPED_FILE_USES_MMAP 1
+#endif
+
+#include "ExceptionLocation.hpp"
+#include "MappedFile.hpp"
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Constructors, assignments, and destructor
+*******************************************************************************/
+
+#if defined( MAPPED_FILE_USES_MMAP )
+
+  // Constructor
+  MappedFile::MappedFile( std::filesystem::path const & path )
+  {
+    int const file = ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+    if( file < 0 )   throw std::system_error( errno, std::generic_category(), "Unable to open \"" + path.string() + "\"" exception_location );
+
+    struct stat status {};
+    if( ::fstat( file, &status ) != 0 )
+    {
+      auto const error = errno;
+      ::close( file );
+      throw std::system_error( error, std::generic_category(), "Unable to size \"" + path.string() + "\"" exception_location );
+    }
+
+    // Zero length mappings aren't allowed, but there's nothing to map anyway.  The mapping stays valid after the file is closed.
+    _size = static_cast<std::size_t>( status.st_size );
+    if( _size > 0 )
+    {
+      _mapping = ::mmap( nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0 );
+      if( _mapping == MAP_FAILED )
+      {
+        auto const error = errno;
+        _mapping = nullptr;
+        ::close( file );
+        throw std::system_error( error, std::generic_category(), "Unable to map \"" + path.string() + "\"" exception_location );
+      }
+
+      ::madvise( _mapping, _size, MADV_SEQUENTIAL );                                  // just a hint, read ahead aggressively and drop pages behind
+    }
+
+    ::close( file );
+  }
+
+
+
+  // Destructor
+  MappedFile::~MappedFile() noexcept
+  {
+    if( _mapping != nullptr )   ::munmap( _mapping, _size );
+  }
+
+#else
+
+  // Constructor
+  MappedFile::MappedFile( std::filesystem::path const & path )
+  {
+    std::ifstream file( path, std::ios::binary );
+    if( !file )   throw std::system_error( errno, std::generic_category(), "Unable to open \"" + path.string() + "\"" exception_location );
+
+    _copy.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+  }
+
+
+
+  // Destructor
+  MappedFile::~MappedFile() noexcept = default;
+
+#endif
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// contents() const
+std::string_view MappedFile::contents() const noexcept
+{
+  if( _mapping != nullptr )   return { static_cast<char const *>( _mapping ), _size };
+  return _copy;
+}
@@ -0,0 +1,34 @@
+#pragma once                                                                                  // include guard
+
+#include <cstddef>                                                                            // size_t
+#include <filesystem>                                                                         // path
+#include <string>
+#include <string_view>
+
+
+// A read only view of a whole file's contents.  Where the platform supports it (POSIX) the file is memory mapped, so the contents
+// are paged in by the operating system as they're touched and never copied into the process.  Elsewhere the file is simply read
+// into memory.  Either way, contents() stays valid for the life of the MappedFile.
+//
+// Throws std::system_error if the file can't be opened or mapped.
+class MappedFile
+{
+  public:
+    // Constructors, assignments, and destructor
+    explicit MappedFile( std::filesystem::path const & path );
+
+    MappedFile            ( MappedFile const & ) = delete;                                    // owns the mapping, so no copies
+    MappedFile & operator=( MappedFile const & ) = delete;
+   ~MappedFile            (                    ) noexcept;
+
+
+    // Queries
+    std::string_view contents() const noexcept;                                               // the whole file
+
+
+  private:
+    // Instance Attributes
+    void *      _mapping = nullptr;                                                           // start of the mapped region, nullptr if not mapped
+    std::size_t _size    = 0;                                                                 // bytes mapped
+    std::string _copy;                                                                        // the file's contents when it couldn't be (or didn't need to be) mapped
+};
@@ -0,0 +1,190 @@
+#include <algorithm>                                                                  // copy()
+#include <charconv>                                                                   // to_chars(), to_chars_result, chars_format
+#include <cmath>                                                                      // round()
+#include <cstddef>                                                                    // size_t
+#include <cstdint>                                                                    // int64_t, uint64_t
+#include <iostream>                                                                   // istream, ostream, ios
+#include <locale>                                                                     // locale
+#include <string>
+#include <string_view>
+#include <system_error>                                                               // errc
+
+#include "ExceptionLocation.hpp"
+#include "Money.hpp"
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Constructors
+*******************************************************************************/
+
+// fromDollars()
+Money Money::fromDollars( double dollars )
+{
+  // Every int64_t is within [-2^63, 2^63), and both bounds are exact doubles.  The negated test also rejects NaN.
+  auto const mills = std::round( dollars * MILLS_PER_DOLLAR );
+  if( !( mills >= -0x1p63  &&  mills < 0x1p63 ) )   throw Overflow_Ex( "$" + std::to_string( dollars ) + " can't be represented in mills" exception_location );
+
+  return fromMills( static_cast<Mills>( mills ) );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// toDollars() const
+double Money::toDollars() const noexcept
+{
+  // Both operands are exact (for any amount under 2^53 mills), so the division is correctly rounded
+  return static_cast<double>( _mills ) / MILLS_PER_DOLLAR;
+}
+
+
+
+// toChars() const
+std::to_chars_result Money::toChars( char * first, char * last, int precision ) const noexcept
+{
+  // "%g" prints the shortest of fixed or scientific notation showing at most precision significant digits.  An amount of money has
+  // at most three decimals, so whenever it needs no more than precision significant digits (and isn't so large "%g" would switch
+  // to scientific) its exact digits are exactly what "%g" prints - written here straight from the integer, without any floating
+  // point formatting.  Everything else formats the equivalent double.
+  if( precision >= 1  &&  precision <= 15 )
+  {
+    std::uint64_t magnitude = _mills < 0 ? 0 - static_cast<std::uint64_t>( _mills ) : static_cast<std::uint64_t>( _mills );
+    auto const    whole     = magnitude / MILLS_PER_DOLLAR;
+    auto          fraction  = magnitude % MILLS_PER_DOLLAR;
+
+    std::size_t fractionDigits = 3;                                                   // drop trailing zeros, "%g" does
+    while( fractionDigits > 0  &&  fraction % 10 == 0 )   { fraction /= 10;  --fractionDigits; }
+
+    char buffer[48];                                                                  // sign, 19 whole digits, point, 3 fraction digits, and then some
+    char * next = buffer;
+    if( _mills < 0 ) *next++ = '-';
+    auto const wholeStart  = next;
+    next                   = std::to_chars( next, buffer + sizeof( buffer ), whole ).ptr;
+    auto const wholeDigits = static_cast<std::size_t>( next - wholeStart );
+
+    // Significant digits:  all the whole digits and the fraction, or with no whole part only the fraction less its leading zeros
+    char               fractionText[4] = {};
+    auto const         fractionEnd     = std::to_chars( fractionText, fractionText + sizeof( fractionText ), fraction ).ptr;
+    auto const         fractionLength  = static_cast<std::size_t>( fractionEnd - fractionText );
+    std::size_t const  significant     = whole > 0 ? wholeDigits + fractionDigits : fractionLength;
+    auto const         limit           = static_cast<std::size_t>( precision );
+
+    if( significant <= limit  &&  ( whole == 0  ||  wholeDigits <= limit ) )
+    {
+      if( fractionDigits > 0 )
+      {
+        *next++ = '.';
+        for( auto zeros = fractionDigits - fractionLength;  zeros > 0;  --zeros )   *next++ = '0';
+        for( auto digit = fractionText;  digit != fractionEnd;  ++digit )          *next++ = *digit;
+      }
+
+      auto const length = static_cast<std::size_t>( next - buffer );
+      if( length > static_cast<std::size_t>( last - first ) )   return { last, std::errc::value_too_large };
+      return { std::copy( buffer, next, first ), std::errc{} };
+    }
+  }
+
+  return std::to_chars( first, last, toDollars(), std::chars_format::general, precision );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Arithmetic
+*******************************************************************************/
+
+// operator+=()
+Money & Money::operator+=( Money rhs )
+{
+  if( __builtin_add_overflow( _mills, rhs._mills, &_mills ) )   throw Overflow_Ex( "Sum of money overflowed" exception_location );
+  return *this;
+}
+
+
+
+// operator-=()
+Money & Money::operator-=( Money rhs )
+{
+  if( __builtin_sub_overflow( _mills, rhs._mills, &_mills ) )   throw Overflow_Ex( "Difference of money overflowed" exception_location );
+  return *this;
+}
+
+
+
+// operator*()
+Money operator*( Money lhs, std::int64_t quantity )
+{
+  Money::Mills product = 0;
+  if( __builtin_mul_overflow( lhs.mills(), quantity, &product ) )   throw Money::Overflow_Ex( "Product of money overflowed" exception_location );
+  return Money::fromMills( product );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Insertion and Extraction Operators
+*******************************************************************************/
+
+// operator<<()
+std::ostream & operator<<( std::ostream & stream, Money const & money )
+{
+  // Under the default floating point format a double prints as "%g" would, which is what toChars() writes.  Everything else -
+  // fixed, scientific, showpoint, a non-classic locale, more digits than fit - is left to the stream.
+  static std::locale const classic = std::locale::classic();
+
+  auto const precision = stream.precision();
+  if( ( stream.flags() & ( std::ios::floatfield | std::ios::showpoint | std::ios::showpos ) ) == 0
+   && precision >= 1  &&  precision <= 15
+   && stream.getloc() == classic )
+  {
+    char       buffer[48];                                                            // sign, 19 whole digits, point, 3 fraction digits, and then some
+    auto const result = money.toChars( buffer, buffer + sizeof( buffer ), static_cast<int>( precision ) );
+    if( result.ec == std::errc{} )   return stream << std::string_view( buffer, static_cast<std::size_t>( result.ptr - buffer ) );
+  }
+
+  return stream << money.toDollars();
+}
+
+
+
+// operator>>()
+std::istream & operator>>( std::istream & stream, Money & money )
+{
+  double dollars = 0.0;
+  if( stream >> dollars )
+  {
+    try
+    {
+      money = Money::fromDollars( dollars );
+    }
+    catch( Money::Overflow_Ex const & )
+    {
+      stream.setstate( std::ios::failbit );
+    }
+  }
+  return stream;
+}
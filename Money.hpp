@@ -0,0 +1,146 @@
+#pragma once                                                                                  // include guard
+
+#include <charconv>                                                                           // to_chars_result
+#include <compare>                                                                            // strong_ordering
+#include <cstddef>                                                                            // size_t
+#include <cstdint>                                                                            // int64_t, uint64_t
+#include <functional>                                                                         // hash, identity, invoke()
+#include <iterator>                                                                           // ranges::next()
+#include <iostream>                                                                           // istream, ostream
+#include <ranges>                                                                             // forward_range, range_difference_t, begin(), end()
+#include <stdexcept>                                                                          // overflow_error
+
+
+// An amount of US money held exactly, as a whole number of mills (thousandths of a dollar, a tenth of a cent).  Unlike a double,
+// equal amounts are identical, so comparing, ordering, and hashing all agree with each other, and sums are exact.  Arithmetic is
+// checked:  a result that doesn't fit throws Overflow_Ex rather than silently wrapping.
+//
+// Amounts convert from dollars (a double) by rounding to the nearest mill, and print like a double would (56.69, 0.005, 12) so text
+// written before and after stays the same.
+class Money
+{
+  public:
+    using Mills = std::int64_t;
+
+    static constexpr Mills MILLS_PER_DOLLAR = 1'000;
+
+    // Exceptions
+    struct Overflow_Ex : std::overflow_error { using overflow_error::overflow_error; };      // Thrown if an amount or result can't be represented
+
+
+    // Constructors
+    constexpr Money() noexcept = default;                                                    // $0.00
+    static constexpr Money fromMills  ( Mills  mills   ) noexcept;
+    static           Money fromDollars( double dollars );                                    // rounds to the nearest mill
+
+
+    // Queries
+    constexpr Mills  mills    () const noexcept;
+              double toDollars() const noexcept;                                             // the nearest double, exactly 56.69 for 56.690 for example
+
+    std::to_chars_result toChars( char * first, char * last, int precision = 6 ) const noexcept;  // writes what "%.*g" (and so an ostream in its default
+                                                                                              // state) writes for the equivalent double, from the exact
+                                                                                              // digits whenever they fit in precision
+
+
+    // Arithmetic
+    Money & operator+=( Money rhs );
+    Money & operator-=( Money rhs );
+
+    friend Money operator+( Money lhs, Money        rhs      )  { return lhs += rhs; }
+    friend Money operator-( Money lhs, Money        rhs      )  { return lhs -= rhs; }
+    friend Money operator*( Money lhs, std::int64_t quantity );                              // extended price, quantity units at lhs each
+
+    template<std::ranges::forward_range Range, typename Projection = std::identity>
+    static Money sum( Range && amounts, Projection projection = {} );                        // exact total of a range of amounts (or of whatever projection maps each
+                                                                                              // element to), written so the common case vectorizes
+
+
+    // Relational Operators
+    constexpr std::strong_ordering operator<=>( Money const & ) const noexcept = default;
+    constexpr bool                 operator== ( Money const & ) const noexcept = default;
+
+
+  private:
+    // Instance Attributes
+    Mills _mills = 0;
+};
+
+
+
+// Insertion and Extraction Operators
+std::ostream & operator<<( std::ostream & stream, Money const & money );                     // formats as the equivalent double would be, under the stream's own flags
+std::istream & operator>>( std::istream & stream, Money       & money );                     // reads a number of dollars, sets failbit if it's not representable
+
+
+
+// Hash support, consistent with operator== since every amount has exactly one representation
+template<>
+struct std::hash<Money>
+{
+  std::size_t operator()( Money const & money ) const noexcept { return std::hash<Money::Mills>{}( money.mills() ); }
+};
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Inline and template definitions
+*******************************************************************************/
+
+// fromMills()
+constexpr Money Money::fromMills( Mills mills ) noexcept
+{
+  Money money;
+  money._mills = mills;
+  return money;
+}
+
+
+
+// mills() const
+constexpr Money::Mills Money::mills() const noexcept
+{
+  return _mills;
+}
+
+
+
+// sum()
+template<std::ranges::forward_range Range, typename Projection>
+Money Money::sum( Range && amounts, Projection projection )
+{
+  // Checking every addition for overflow would keep the loop from vectorizing.  Instead, sum blocks with plain (wrapping, so never
+  // undefined) unsigned additions while OR-ing together every amount's magnitude.  If no amount in a block reaches 2^42 mills
+  // (over four billion dollars), a block of 2^20 of them can't reach 2^62 and the block's sum is exact.  Only a block that fails
+  // that test is summed again, one checked addition at a time.  Block totals are always added with a check.
+  constexpr std::size_t BLOCK_SIZE     = std::size_t{ 1 } << 20;
+  constexpr unsigned    MAGNITUDE_BITS = 42;
+
+  Money total;
+  auto       current = std::ranges::begin( amounts );
+  auto const last    = std::ranges::end  ( amounts );
+  while( current != last )
+  {
+    // Finding the block's end first (constant time for random access ranges) leaves the loop a single exit test, so it vectorizes
+    auto const    blockStart = current;
+    auto const    blockEnd   = std::ranges::next( current, static_cast<std::ranges::range_difference_t<Range>>( BLOCK_SIZE ), last );
+    std::uint64_t blockSum   = 0;
+    std::uint64_t magnitudes = 0;
+    for( ; current != blockEnd;  ++current )
+    {
+      Mills const mills = std::invoke( projection, *current ).mills();
+      blockSum   += static_cast<std::uint64_t>( mills );
+      magnitudes |= static_cast<std::uint64_t>( mills ^ ( mills >> 63 ) );                   // |mills|, less one if negative
+    }
+
+    if( ( magnitudes >> MAGNITUDE_BITS ) == 0 )   total += fromMills( static_cast<Mills>( blockSum ) );
+    else for( auto amount = blockStart;  amount != current;  ++amount )   total += std::invoke( projection, *amount );
+  }
+
+  return total;
+}
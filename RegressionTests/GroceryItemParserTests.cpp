@@ -0,0 +1,157 @@
+#include <cstddef>                                                                          // size_t
+#include <exception>
+#include <iomanip>                                                                          // setprecision()
+#include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog
+#include <sstream>                                                                          // istringstream, ostringstream
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "RegressionTests/CheckResults.hpp"
+#include "GroceryItem.hpp"
+#include "GroceryItemParser.hpp"
+
+
+
+
+namespace  // anonymous
+{
+  class GroceryItemParserRegressionTest
+  {
+    public:
+      GroceryItemParserRegressionTest();
+
+    private:
+      void parsing();
+      void malformedRecords();
+
+      Regression::CheckResults affirm;
+  } run_grocery_item_parser_tests;
+
+
+
+
+  void GroceryItemParserRegressionTest::parsing()
+  {
+    {  // Same input the extraction operator is tested with, the parser must agree with it record for record
+      std::string_view const text = R"~~( "00072250018548","Nature's Own","Nature's Own Butter Buns Hotdog - 8 Ct",56.69
+
+                                        "00028000517205", "Nestle"             ,
+                                        "Nestle \"Media Crema\" Table Cream"       ,
+                                        118.07
+
+                                        "00034000020706"    ,
+                                        "York",
+                                        "York Peppermint Patties Dark Chocolate Covered Snack Size",
+                                        31.57 "00038000570742",
+                                        "Kellogg's", "Kellogg's Cereal Krave Chocolate",
+                                          65.65
+
+                                        "00014100072331" , "Pepperidge  \"Home Town\"  Farm", "Pepperidge Farm Classic Cookie Favorites", 26.45
+                                 )~~";
+
+      std::istringstream stream{ std::string( text ) };
+      GroceryItemParser  parser( text );
+
+      std::size_t records = 0;
+      bool        agree   = true;
+      for( GroceryItem expected, actual;  stream >> expected;  ++records )
+      {
+        agree = parser.next( actual )  &&  agree  &&  expected == actual;
+      }
+
+      GroceryItem unchanged{ "unchanged" };
+      affirm.is_equal( "Parser agrees with extraction operator            ", 5U, records );
+      affirm.is_true ( "Parser agrees with extraction operator - content  ", agree );
+      affirm.is_true ( "Parser end of input                               ", !parser.next( unchanged ) && unchanged == GroceryItem{ "unchanged" } );
+    }
+
+    {  // grocery items read by one parser share each brand name, and keep it once the parser is gone
+      std::vector<GroceryItem> read( 2 );
+      {
+        GroceryItemParser parser( R"( "1", "Heinz", "Ketchup", 1.99   "2", "Heinz", "Mustard", 2.49 )" );
+        parser.next( read[0] );
+        parser.next( read[1] );
+      }
+      affirm.is_true( "Parsed brand names shared                         ", &read[0].brandName() == &read[1].brandName()  &&  read[1].brandName() == "Heinz" );
+    }
+
+    {  // read what you write, including escaped quotes and backslashes
+      std::vector<GroceryItem> const written = { {},
+                                                 { "product \"name\"", "brand \\ name", "012345678905", 123.79 },
+                                                 { "\\\"",             "\"",            "",             0.01   },
+                                                 { "multi\nline",      "tab\tbed",      "x",            1.0e7  } };
+
+      std::ostringstream stream;
+      for( auto const & gItem : written )   stream << gItem << '\n';
+      auto const text = stream.str();
+
+      std::vector<GroceryItem> read;
+      GroceryItemParser        parser( text );
+      for( GroceryItem gItem;  parser.next( gItem ); )   read.push_back( gItem );
+
+      affirm.is_true( "Symmetrical insertion and parsing                 ", read == written );
+    }
+
+    {  // An empty or all whitespace buffer has no records
+      GroceryItem gItem;
+      affirm.is_true( "Empty buffer                                      ", !GroceryItemParser( ""          ).next( gItem ) );
+      affirm.is_true( "Whitespace only buffer                            ", !GroceryItemParser( " \n\t\r\n " ).next( gItem ) );
+    }
+  }
+
+
+
+  void GroceryItemParserRegressionTest::malformedRecords()
+  {
+    // Returns "line:column" of the reported problem, or "none" if the whole buffer parsed
+    auto whereFails = []( std::string_view text ) -> std::string
+    {
+      try
+      {
+        GroceryItemParser parser( text );
+        for( GroceryItem gItem;  parser.next( gItem ); ) {}
+        return "none";
+      }
+      catch( GroceryItemParser::MalformedRecord_Ex const & ex )
+      {
+        return std::to_string( ex.line ) + ':' + std::to_string( ex.column );
+      }
+    };
+
+    affirm.is_equal( "Malformed - well formed                           ", "none", whereFails( "\"1\", \"b\", \"p\", 1.5\n\"2\", \"b\", \"p\", 2.5"   ) );
+    affirm.is_equal( "Malformed - missing opening quote                 ", "2:6",  whereFails( "\"1\", \"b\", \"p\", 1.5\n\"2\", b, \"p\", 2.5"       ) );
+    affirm.is_equal( "Malformed - missing comma                         ", "1:11", whereFails( "\"1\", \"b\"  \"p\", 1.5"                             ) );
+    affirm.is_equal( "Malformed - missing closing quote                 ", "3:13", whereFails( "\n\n  \"1\", \"b\", \"p, 1.5"                         ) );
+    affirm.is_equal( "Malformed - dangling escape                       ", "1:1",  whereFails( "\"1\\"                                                ) );
+    affirm.is_equal( "Malformed - missing price                         ", "2:1",  whereFails( "\"1\", \"b\", \"p\", \n"                              ) );
+    affirm.is_equal( "Malformed - mangled price                         ", "1:19", whereFails( "\"1\", \"b\", \"p\", 1.5x"                            ) );
+    affirm.is_equal( "Malformed - truncated record                      ", "2:9",  whereFails( "\"1\", \"b\", \"p\", 1.5\n\"2\", \"b\""               ) );
+  }
+
+
+
+  GroceryItemParserRegressionTest::GroceryItemParserRegressionTest()
+  {
+    // affirm.policy = Regression::CheckResults::ReportingPolicy::ALL;
+    std::clog << std::boolalpha << std::showpoint << std::fixed << std::setprecision( 2 );
+
+
+    try
+    {
+      std::clog << "\nGroceryItemParser Regression Test:  Parsing\n";
+      parsing();
+
+      std::clog << "\nGroceryItemParser Regression Test:  Malformed records\n";
+      malformedRecords();
+
+
+      std::clog << "\n\nGroceryItemParser Regression Test " << affirm << "\n\n";
+    }
+    catch( const std::exception & ex )
+    {
+      std::clog << "FAILURE:  Regression test for \"class GroceryItemParser\" failed with an unhandled exception. \n\n\n"
+                << ex.what() << std::endl;
+    }
+  }
+} // namespace
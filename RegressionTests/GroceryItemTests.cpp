@@ -1,12 +1,18 @@
 #include <cmath>                                                                            // abs(), ceil(), log10()
 #include <exception>
+#include <functional>                                                                       // hash
 #include <iomanip>                                                                          // setprecision()
 #include <iostream>                                                                         // boolalpha(), showpoint(), fixed(), clog, ios, streamsize
+#include <limits>                                                                           // numeric_limits
 #include <sstream>                                                                          // istringstream, stringstream
+#include <string>
 #include <utility>                                                                          // move()
+#include <vector>
 
 #include "RegressionTests/CheckResults.hpp"
 #include "GroceryItem.hpp"
+#include "Money.hpp"
+#include "UpcCode.hpp"
 
 
 
@@ -25,6 +31,8 @@ namespace  // anonymous
       void io();
       void comparison();
       void copyVsMoveSemantics();
+      void compactAttributes();
+      void exactPrices();
 
       Regression::CheckResults affirm;
   } run_grocery_item_tests;
@@ -159,14 +167,19 @@ namespace  // anonymous
     // Be careful - using affirm.xxx() may hide the class-under-test overloaded operators.  But affirm.is_true() doesn't provide as
     // much information when the test fails.
     affirm.is_equal    ( "Equality test - is equal                          ", less, more );
-    affirm.is_equal    ( "Equality test - floating point lower limit        ", less, GroceryItem {"a1", "a1", "a1", less.price() - EPSILON} );
-    affirm.is_equal    ( "Equality test - floating point upper limit        ", less, GroceryItem {"a1", "a1", "a1", less.price() + EPSILON} );
+    affirm.is_equal    ( "Equality test - rounds to the nearest mill, lower ", less, GroceryItem {"a1", "a1", "a1", less.price() - 4 * EPSILON} );
+    affirm.is_equal    ( "Equality test - rounds to the nearest mill, upper ", less, GroceryItem {"a1", "a1", "a1", less.price() + 4 * EPSILON} );
 
     affirm.is_not_equal( "Inequality Product Name test                      ", less, GroceryItem {"b1", "a1", "a1", 10.0} );
     affirm.is_not_equal( "Inequality Brand Name test                        ", less, GroceryItem {"a1", "b1", "a1", 10.0} );
     affirm.is_not_equal( "Inequality UPC test                               ", less, GroceryItem {"a1", "a1", "b1", 10.0} );
-    affirm.is_not_equal( "Inequality Price test - lower limit               ", less, GroceryItem {"a1", "a1", "a1", less.price() - ( 2 * EPSILON )} );
-    affirm.is_not_equal( "Inequality Price test - upper limit               ", less, GroceryItem {"a1", "a1", "a1", less.price() + ( 2 * EPSILON )} );
+    affirm.is_not_equal( "Inequality Price test - one mill lower            ", less, GroceryItem {"a1", "a1", "a1", less.price() - 0.001} );
+    affirm.is_not_equal( "Inequality Price test - one mill higher           ", less, GroceryItem {"a1", "a1", "a1", less.price() + 0.001} );
+
+    // Prices are exact, so equal grocery items hash alike and equality never disagrees with ordering
+    GroceryItem const rounded( "a1", "a1", "a1", 10.0004 );
+    affirm.is_true     ( "Equality agrees with ordering and hashing         ",
+                         less == rounded  &&  ( less <=> rounded ) == 0  &&  std::hash<GroceryItem>{}( less ) == std::hash<GroceryItem>{}( rounded ) );
 
 
     auto check = [&]()
@@ -230,6 +243,124 @@ namespace  // anonymous
 
 
 
+  void GroceryItemRegressionTest::compactAttributes()
+  {
+    // Brand names are shared by copies, and compare by text when grocery items were constructed independently
+    GroceryItem const heinz1( "Heinz Tomato Ketchup - 2 Ct",   std::string( "Heinz" ), "00013000001236" ),
+                      heinz2( "Heinz Tomato Ketchup - 2 Ct",   std::string( "Heinz" ), "00013000001236" ),
+                      copied( heinz1 );
+    affirm.is_true( "Copies share brand names                          ", &heinz1.brandName() == &copied.brandName() );
+    affirm.is_true( "Separate brand names compare by text              ", &heinz1.brandName() != &heinz2.brandName()  &&  heinz1 == heinz2
+                                                                              &&  std::hash<GroceryItem>{}( heinz1 ) == std::hash<GroceryItem>{}( heinz2 ) );
+
+
+    // UPC codes are packed when they're all digits and not too long, held in a shared heap block otherwise.  Either way they must read back exactly,
+    // leading zeros and all, and order just as their text does.
+    std::vector<std::string> const codes = { "", "0", "00", "000123", "00013000001236", "00013000001236000", "051600080015", "05017402006207",
+                                             "1", "10", "100", "123456789012345", "1234567890123456", "5", "9", "99999999999999",
+                                             "999999999999999", "A12", "grocery item's UPC code", "11-13-15", "SKU-12", "SKU-1234",
+                                             "ABCDEFG", "ABCDEFGH", "A", "a", "0A", "A\xFF", std::string( "A\0", 2 ), std::string( "A\0B", 3 ) };
+
+    bool roundTrips = true,  ordered = true;
+    for( auto const & lhs : codes )
+    {
+      GroceryItem const lhsItem( "product", "brand", lhs );
+      roundTrips = roundTrips  &&  lhsItem.upcCode() == lhs;
+
+      for( auto const & rhs : codes )
+      {
+        GroceryItem const rhsItem( "product", "brand", rhs );
+        ordered = ordered  &&  ( lhsItem <=> rhsItem ) == ( lhs <=> rhs )  &&  ( lhsItem == rhsItem ) == ( lhs == rhs );
+      }
+    }
+    affirm.is_true( "Packed UPC codes read back unchanged              ", roundTrips );
+    affirm.is_true( "Packed UPC codes order as their text does         ", ordered    );
+    affirm.is_true( "Short codes packed, long ones held by address     ", UpcCode( "SKU-12" ).packed()  &&  UpcCode( "ABCDEFG" ).packed()
+                                                                              &&  !UpcCode( "ABCDEFGH" ).packed() );
+
+    // Long codes made separately are separate blocks, but equal and hashed alike.  Copies and moves share a block, and the last one
+    // to go frees it
+    UpcCode const longCode( "grocery item's UPC code" );
+    UpcCode       copies[] = { UpcCode( "grocery item's UPC code" ), longCode, longCode };
+    copies[1] = copies[2];
+    copies[2] = std::move( copies[1] );
+    affirm.is_true( "Long codes compare and hash by text               ", copies[0] == longCode  &&  copies[0].hash() == longCode.hash()
+                                                                              &&  copies[2] == longCode  &&  copies[1].empty() );
+
+
+    // Product names are mostly compared by a prefix of their first 8 characters.  Names shorter than, exactly, and longer than the
+    // prefix, sharing it, characters above 0x7F, and embedded nulls must all still order just as their text does.
+    std::vector<std::string> const names = { "", "a", "ab", "abcdefg", "abcdefgh", "abcdefghi", "abcdefgh\xFF", "abcdefgi", "abcdefh",
+                                             "b", "\xE9" "clair", "Z", std::string( "ab\0", 3 ), std::string( "abcdefgh\0", 9 ),
+                                             "Heinz Tomato Ketchup - 2 Ct", "Heinz Tomato Ketchup - 20 Oz" };
+
+    bool namesOrdered = true;
+    for( auto const & lhs : names )
+    {
+      GroceryItem lhsItem;
+      lhsItem.productName( lhs );                                                   // through the modifier, not the constructor
+
+      for( auto const & rhs : names )
+      {
+        GroceryItem const rhsItem( rhs );
+        namesOrdered = namesOrdered  &&  ( lhsItem <=> rhsItem ) == ( lhs <=> rhs )  &&  ( lhsItem == rhsItem ) == ( lhs == rhs );
+      }
+    }
+    affirm.is_true( "Product names order as their text does            ", namesOrdered );
+
+    GroceryItem donor( "abcdefghijklmnop" ),  recipient( std::move( donor ) );
+    GroceryItem taken( "abcdefghijklmnop" );
+    auto const  name = std::move( taken ).productName();
+    affirm.is_true( "Product name prefixes follow moves                ", donor     == GroceryItem{ donor.productName() }     // whatever moving left behind
+                                                                         && taken     == GroceryItem{ taken.productName() }
+                                                                         && recipient == GroceryItem{ name } );
+  }
+
+
+
+  void GroceryItemRegressionTest::exactPrices()
+  {
+    // Money prints just as the equivalent double would, whatever the stream's formatting, so text written before and after prices
+    // became exact is the same
+    bool formatsLikeDouble = true;
+    for( double const dollars : { 0.0, 0.005, 0.01, 0.1, 0.25, 1.0, 2.29, 10.0, 56.69, 118.07, 1234.5, 99999.9, 123456.0, 123456.7,
+                                  1234567.0, 1e12, -2.5, -0.001 } )
+    {
+      auto const money = Money::fromDollars( dollars );
+      for( int format = 0; format < 3; ++format )
+      {
+        std::ostringstream expected, actual;
+        if( format == 1 )   { expected << std::fixed << std::setprecision( 2 );   actual << std::fixed << std::setprecision( 2 ); }
+        if( format == 2 )   { expected << std::setprecision( 3 );                  actual << std::setprecision( 3 );                  }
+        expected << dollars;
+        actual   << money;
+        formatsLikeDouble = formatsLikeDouble  &&  expected.str() == actual.str();
+      }
+    }
+    affirm.is_true( "Money formats like a double                       ", formatsLikeDouble );
+
+
+    // Sums are exact, a million dimes is exactly $100,000.00, and overflow is reported rather than wrapped
+    std::vector<Money> const dimes( 1'000'000, Money::fromDollars( 0.10 ) );
+    affirm.is_equal( "Money sum - exact                                 ", Money::fromMills( 100'000'000 ), Money::sum( dimes ) );
+
+    std::vector<Money> const large = { Money::fromMills( 1 ), Money::fromMills( std::numeric_limits<Money::Mills>::max() ), Money::fromMills( -2 ) };
+    affirm.is_equal( "Money sum - large amounts, checked one at a time  ", Money::fromMills( std::numeric_limits<Money::Mills>::max() - 1 ), Money::sum( std::vector<Money>{ large[1], large[2], large[0] } ) );
+
+    auto overflows = []( auto operation )
+    {
+      try                               { operation();  return false; }
+      catch( Money::Overflow_Ex const & ) { return true;                }
+    };
+    affirm.is_true( "Money arithmetic - overflow detected              ",
+                         overflows( [&] { return Money::sum( std::vector<Money>{ large[1], large[0] } ); } )
+                     &&  overflows( [&] { return large[1] + large[0];                                  } )
+                     &&  overflows( [&] { return large[1] * 2;                                         } )
+                     &&  overflows( [ ] { return Money::fromDollars( 1e300 );                          } ) );
+  }
+
+
+
   GroceryItemRegressionTest::GroceryItemRegressionTest()
   {
     // affirm.policy = Regression::CheckResults::ReportingPolicy::ALL;
@@ -270,6 +401,14 @@ namespace  // anonymous
       copyVsMoveSemantics();
 
 
+      std::clog << "\nGroceryItem Regression Test:  Compact attributes\n";
+      compactAttributes();
+
+
+      std::clog << "\nGroceryItem Regression Test:  Exact prices\n";
+      exactPrices();
+
+
       std::clog << "\n\nGroceryItem Regression Test " << affirm << "\n\n";
     }
     catch( const std::exception & ex )
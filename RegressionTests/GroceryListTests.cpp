@@ -1,19 +1,41 @@
-#include <algorithm>                                                      // move( range ), move_backward( range )
-#include <array>
-#include <cstddef>                                                        // size_t
+#include <algorithm>                                                      // equal(), max(), reverse(), rotate()
+#include <atomic>
+#include <cstddef>                                                        // size_t, ptrdiff_t
 #include <exception>
+#include <filesystem>                                                     // temp_directory_path(), remove()
 #include <forward_list>
+#include <fstream>                                                        // ofstream
 #include <iomanip>                                                        // setprecision()
 #include <iostream>                                                       // boolalpha(), showpoint(), fixed(), setw()
+#include <iterator>                                                       // istreambuf_iterator
+#include <limits>                                                         // numeric_limits
 #include <list>
-#include <sstream>                                                        // ostringstream
+#include <memory_resource>                                                // monotonic_buffer_resource, set_default_resource(), null_memory_resource()
+#include <new>                                                            // bad_alloc
+#include <sstream>                                                        // ostringstream, stringstream
+#include <span>
 #include <string>                                                         // string, to_string()
+#include <system_error>
+#include <thread>                                                         // jthread
+#include <unordered_set>
 #include <utility>                                                        // move( object )
 #include <vector>
 
+#include <fcntl.h>                                                        // open()
+#include <unistd.h>                                                       // getpid(), close()
+
 #include "CheckResults.hpp"
+#include "ConcurrentGroceryList.hpp"
+#include "GroceryCatalog.hpp"
 #include "GroceryItem.hpp"
+#include "GroceryItemQueue.hpp"
 #include "GroceryList.hpp"
+#include "GroceryListImage.hpp"
+#include "GroceryListStorage.hpp"
+#include "GroceryListWriter.hpp"
+#include "Money.hpp"
+#include "SmallVector.hpp"
+#include "UpcCode.hpp"
 
 
 
@@ -25,6 +47,7 @@ namespace    // anonymous
       GroceryListRegressionTest();
 
     private:
+      template<typename List>
       void test();
       void deepArrayInterrogationTest();
 
@@ -34,6 +57,7 @@ namespace    // anonymous
 
 
 
+  template<typename List>
   void GroceryListRegressionTest::test()
   {
     const GroceryItem gItem_1( "gItem_1" ),
@@ -44,41 +68,41 @@ namespace    // anonymous
                       gItem_6( "gItem_6" );
 
     {
-      GroceryList list;
+      List list;
       affirm.is_equal( "Default construction:  Size", 0U, list.size() );
     }
 
     {
-      GroceryList list1 = { gItem_2, gItem_3, gItem_1, gItem_4 };
-      GroceryList list2( list1 );
+      List list1 = { gItem_2, gItem_3, gItem_1, gItem_4 };
+      List list2( list1 );
       affirm.is_equal( "Copy construction and equality", list1, list2 );
 
-      GroceryList list3 = { gItem_3, gItem_1, gItem_4, gItem_5 };
+      List list3 = { gItem_3, gItem_1, gItem_4, gItem_5 };
       affirm.is_less_than   ("Relational 1", list1, list3);
       affirm.is_greater_than("Relational 2", list3, list1);
     }
 
     {
-      GroceryList list;
-      list.insert( gItem_3                             );
-      list.insert( gItem_4, GroceryList::Position::BOTTOM );
-      list.insert( gItem_1, 1                          );
-      list.insert( gItem_2                             );
+      List list;
+      list.insert( gItem_3                         );
+      list.insert( gItem_4, List::Position::BOTTOM );
+      list.insert( gItem_1, 1                      );
+      list.insert( gItem_2                         );
 
-      GroceryList expected = {gItem_2, gItem_3, gItem_1, gItem_4};
+      List expected = {gItem_2, gItem_3, gItem_1, gItem_4};
 
       affirm.is_equal( "Initializer list constructor:  Size",    4U,       list.size() );
       affirm.is_equal( "Initializer list constructor:  content", expected, list        );
     }
 
     {
-      GroceryList list1 = {gItem_2, gItem_3, gItem_1, gItem_4};
+      List list1 = {gItem_2, gItem_3, gItem_1, gItem_4};
       list1 += {gItem_3, gItem_1, gItem_2, gItem_5};
 
-      GroceryList list2 = {gItem_2, gItem_6, gItem_1, gItem_4};
+      List list2 = {gItem_2, gItem_6, gItem_1, gItem_4};
       list1 += list2;
 
-      GroceryList expected = {gItem_2, gItem_3, gItem_1, gItem_4, gItem_5, gItem_6};
+      List expected = {gItem_2, gItem_3, gItem_1, gItem_4, gItem_5, gItem_6};
 
       affirm.is_equal( "Initializer list concatenation:  Size",    6U,       list1.size() );
       affirm.is_equal( "Initializer list concatenation:  content", expected, list1        );
@@ -93,45 +117,45 @@ namespace    // anonymous
     }
 
     {
-      GroceryList list = { gItem_3, gItem_3, gItem_3 };
+      List list = { gItem_3, gItem_3, gItem_3 };
       affirm.is_equal( "Silently ignore duplicates - size", list.size(), 1U );
-      affirm.is_equal( "Silently ignore duplicates - content", list, GroceryList {gItem_3} );
+      affirm.is_equal( "Silently ignore duplicates - content", list, List {gItem_3} );
     }
 
     {
-      GroceryList list = {gItem_2, gItem_1, gItem_4, gItem_5, gItem_6};
+      List list = {gItem_2, gItem_1, gItem_4, gItem_5, gItem_6};
 
       list.remove( gItem_1 );
-      affirm.is_equal( "Remove by grocery item - middle", GroceryList {gItem_2, gItem_4, gItem_5, gItem_6}, list );
+      affirm.is_equal( "Remove by grocery item - middle", List {gItem_2, gItem_4, gItem_5, gItem_6}, list );
 
       list.remove( gItem_6 );
-      affirm.is_equal( "Remove by grocery item - bottom", GroceryList {gItem_2, gItem_4, gItem_5}, list );
+      affirm.is_equal( "Remove by grocery item - bottom", List {gItem_2, gItem_4, gItem_5}, list );
 
       list.remove( gItem_2 );
-      affirm.is_equal( "Remove by grocery item - top", GroceryList {gItem_4, gItem_5}, list );
+      affirm.is_equal( "Remove by grocery item - top", List {gItem_4, gItem_5}, list );
 
       list.remove( {"not there"} );
-      affirm.is_equal( "Remove by grocery item - not there", GroceryList {gItem_4, gItem_5}, list );
+      affirm.is_equal( "Remove by grocery item - not there", List {gItem_4, gItem_5}, list );
     }
 
     {
-      GroceryList list = {gItem_2, gItem_1, gItem_4, gItem_5, gItem_6};
+      List list = {gItem_2, gItem_1, gItem_4, gItem_5, gItem_6};
 
       list.remove( 1 );
-      affirm.is_equal( "Remove by position - middle", GroceryList {gItem_2, gItem_4, gItem_5, gItem_6}, list );
+      affirm.is_equal( "Remove by position - middle", List {gItem_2, gItem_4, gItem_5, gItem_6}, list );
 
       list.remove( 3 );
-      affirm.is_equal( "Remove by position - bottom", GroceryList {gItem_2, gItem_4, gItem_5}, list );
+      affirm.is_equal( "Remove by position - bottom", List {gItem_2, gItem_4, gItem_5}, list );
 
       list.remove( 0 );
-      affirm.is_equal( "Remove by position - top", GroceryList {gItem_4, gItem_5}, list );
+      affirm.is_equal( "Remove by position - top", List {gItem_4, gItem_5}, list );
 
       list.remove( 10 );
-      affirm.is_equal( "Remove by position - bad index", GroceryList {gItem_4, gItem_5}, list );
+      affirm.is_equal( "Remove by position - bad index", List {gItem_4, gItem_5}, list );
     }
 
     {
-      GroceryList list = {gItem_2, gItem_1, gItem_4, gItem_5, gItem_6};
+      List list = {gItem_2, gItem_1, gItem_4, gItem_5, gItem_6};
 
       list.moveToTop( gItem_5        );
       list.moveToTop( gItem_6        );
@@ -140,21 +164,760 @@ namespace    // anonymous
       list.moveToTop( gItem_4        );
       list.moveToTop( {"not there"} );
 
-      GroceryList expected = {gItem_4, gItem_5, gItem_6, gItem_2, gItem_1};
+      List expected = {gItem_4, gItem_5, gItem_6, gItem_2, gItem_1};
       affirm.is_equal( "Move to top", expected, list );
     }
 
     {
-      GroceryList list;
+      // A batch must land exactly where inserting its grocery items one at a time would have put them
+      std::vector<GroceryItem> batch = {gItem_5, gItem_2, gItem_6, gItem_5, gItem_3};
+
+      List bulk       = {gItem_1, gItem_2, gItem_4};
+      List oneAtATime = bulk;
+      bulk.insert( batch.begin(), batch.end(), 2 );
+      for( std::size_t offset = 2; auto const & gItem : batch )   if( oneAtATime.find( gItem ) == oneAtATime.size() ) oneAtATime.insert( gItem, offset++ );
+
+      affirm.is_equal( "Bulk insert - middle with duplicates", List {gItem_1, gItem_2, gItem_5, gItem_6, gItem_3, gItem_4}, bulk );
+      affirm.is_equal( "Bulk insert - same as one at a time",  oneAtATime,                                                   bulk );
+
+      bulk.insert( batch.begin(), batch.begin(), 0 );
+      affirm.is_equal( "Bulk insert - empty range", oneAtATime, bulk );
+
+      bulk += bulk;
+      affirm.is_equal( "Bulk insert - append to itself", oneAtATime, bulk );
+
+      List list;
+      list.appendRange( batch );
+      affirm.is_equal( "Bulk insert - append range", List {gItem_5, gItem_2, gItem_6, gItem_3}, list );
+
+      try
+      {
+        list.insert( batch.begin(), batch.end(), list.size() + 1 );
+        affirm.is_true( "Bulk insert - invalid offset", false );
+      }
+      catch( const typename List::InvalidOffset_Ex & )  // expected
+      {
+        affirm.is_true( "Bulk insert - invalid offset", true );
+      }
+    }
+
+    {
+      // Loading a file must give the same grocery list as extracting the same text from a stream
+      auto const path = std::filesystem::temp_directory_path() / ( "GroceryListTests-" + std::to_string( ::getpid() ) + ".txt" );
+      std::string const text = R"( "00072250018548", "Nature's Own", "Nature's Own Butter Buns Hotdog - 8 Ct", 56.69
+                                   "00028000517205", "Nestle",       "Nestle \"Media Crema\" Table Cream",     118.07
+                                   "00072250018548", "Nature's Own", "Nature's Own Butter Buns Hotdog - 8 Ct", 56.69
+                                   "00034000020706", "York",         "York Peppermint Patties",                31.57 )";
+
+      std::ofstream( path ) << text;
+      auto loaded = List::loadFile( path );
+
+      List              extracted;
+      std::stringstream stream( text );
+      stream >> extracted;
+
+      affirm.is_equal( "Load file - content", extracted, loaded );
+      affirm.is_equal( "Load file - size",    3U,        loaded.size() );
+
+      std::ofstream( path, std::ios::trunc ).flush();
+      affirm.is_equal( "Load file - empty file", 0U, List::loadFile( path ).size() );
+      std::filesystem::remove( path );
+
+      try
+      {
+        List::loadFile( path );
+        affirm.is_true( "Load file - missing file", false );
+      }
+      catch( const std::system_error & )  // expected
+      {
+        affirm.is_true( "Load file - missing file", true );
+      }
+    }
+
+    {
+      // The writer's text must be byte for byte what the insertion operator writes, whether to a string or a file descriptor
+      List list = { {"Nestle \"Media Crema\" Table Cream", "Nestle",       "00028000517205", 118.07     },
+                    {"Back\\slash \\\"both\\\"",         "",             "ABC-123",        0.005      },
+                    {"Loose Bananas"                                                                  },
+                    {"Bulk Saffron",                     "Spice \"Co\"", "00000000000001", 1234567.891} };
+      for( unsigned i = 0; i < 12; ++i )   list.insert( GroceryItem{ "Item " + std::to_string( i ), "Brand", std::to_string( i ), i * 1.25 }, List::Position::BOTTOM );
+
+      std::ostringstream listText, itemText;
+      listText << list;
+      itemText << gItem_1;
+
+      std::string text;
+      GroceryListWriter( text ).write( list ).write( gItem_1 );
+      affirm.is_equal( "Writer - same text as operator<<", listText.str() + itemText.str(), text );
+
+      auto const path = std::filesystem::temp_directory_path() / ( "GroceryListTests-" + std::to_string( ::getpid() ) + ".out" );
+      auto const fileDescriptor = ::open( path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600 );
+      GroceryListWriter( fileDescriptor ).write( list ).flush();
+      ::close( fileDescriptor );
+
+      std::ifstream file( path );
+      affirm.is_equal( "Writer - file descriptor", listText.str(), std::string( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() ) );
+      std::filesystem::remove( path );
+    }
+
+    {
+      // A binary image must read back as the grocery list it was written from, and anything else must be refused
+      auto const path = std::filesystem::temp_directory_path() / ( "GroceryListTests-" + std::to_string( ::getpid() ) + ".glst" );
+      List const original = { {"Nature's Own Butter Buns Hotdog - 8 Ct", "Nature's Own", "00072250018548", 56.69},
+                              {"Nestle \"Media Crema\" Table Cream",      "Nestle",       "00028000517205", 118.07},
+                              {"Nature's Own Honey Wheat Bread",          "Nature's Own", "00072250011150", 3.005},
+                              {"Loose Bananas"                                                                } };
+      original.saveImage( path );
+      auto const loaded = List::loadImage( path );
+      affirm.is_true( "Image - round trip", loaded == original  &&  loaded.total() == original.total() );
+
+      List{}.saveImage( path );
+      affirm.is_equal( "Image - empty list", 0U, List::loadImage( path ).size() );
+      std::filesystem::remove( path );
+
+      GroceryListImage::Builder builder( 1 );
+      builder.add( gItem_1 );
+      auto const image = std::move( builder ).finish();
+
+      auto refused = []( std::string const & bytes )
+      {
+        try                                                  { GroceryListImage{ bytes };  return false; }
+        catch( GroceryListImage::MalformedImage_Ex const & ) { return true;                              }
+      };
+      auto wrongVersion = image;
+      wrongVersion[4] = '\x7F';
+      affirm.is_true( "Image - malformed",  GroceryListImage{ image }[0].productName == gItem_1.productName()
+                                        &&  refused( image.substr( 0, image.size() - 1 ) )
+                                        &&  refused( image + '\0' )
+                                        &&  refused( wrongVersion )
+                                        &&  refused( "not an image, but long enough for a header" ) );
+    }
+
+    {
+      // Indexed and non-indexed lists must agree after every kind of modification.  A storage policy that locates its own grocery
+      // items is always indexed.
+      constexpr bool locating = LocatingStorage<typename List::Storage>;
+
+      List indexed = {gItem_2, gItem_1, gItem_4};
+      List plain   = indexed;
+      indexed.indexed( true );
+
+      auto agree = [&]()
+      {
+        for( auto const & gItem : { gItem_1, gItem_2, gItem_3, gItem_4, gItem_5, gItem_6 } )
+        {
+          if( indexed.find( gItem ) != plain.find( gItem ) ) return false;
+        }
+        return indexed == plain;
+      };
+
+      affirm.is_true( "Hash index - enabled",              indexed.indexed() && plain.indexed() == locating );
+      affirm.is_true( "Hash index - build",                agree() );
+
+      indexed.insert( gItem_3, 1 );                 plain.insert( gItem_3, 1 );
+      indexed.insert( gItem_3, 0 );                 plain.insert( gItem_3, 0 );
+      affirm.is_true( "Hash index - insert middle",        agree() );
+
+      indexed.remove( 1 );                          plain.remove( 1 );
+      indexed.remove( gItem_4 );                    plain.remove( gItem_4 );
+      affirm.is_true( "Hash index - remove",               agree() );
+
+      indexed.moveToTop( gItem_1 );                 plain.moveToTop( gItem_1 );
+      affirm.is_true( "Hash index - move to top",          agree() );
+
+      indexed += {gItem_5, gItem_2, gItem_6};       plain += {gItem_5, gItem_2, gItem_6};
+      indexed += List {gItem_4, gItem_3};           plain += List {gItem_4, gItem_3};
+      affirm.is_true( "Hash index - concatenation",        agree() );
+
+      indexed.remove( gItem_5 );                    plain.remove( gItem_5 );
+      indexed.remove( gItem_6 );                    plain.remove( gItem_6 );
+      std::vector<GroceryItem> batch = {gItem_6, gItem_1, gItem_5, gItem_6};
+      indexed.insert( batch.begin(), batch.end(), 1 );  plain.insert( batch.begin(), batch.end(), 1 );
+      affirm.is_true( "Hash index - bulk insert middle",   agree() );
+
+      indexed.indexed( false );
+      affirm.is_true( "Hash index - disabled",             indexed.indexed() == locating && agree() );
+    }
+
+    {
+      // Scattered insertions and removals in the middle of a long list, checked against a plain vector doing the same
+      List                     list;
+      std::vector<GroceryItem> expected;
+      std::size_t              position = 0;
+      for( unsigned i = 0; i < 600; ++i )
+      {
+        position = ( position * 31 + 17 ) % ( expected.size() + 1 );
+        GroceryItem gItem( "GroceryItem-" + std::to_string( i ) );
+        list.insert( gItem, position );
+        expected.insert( expected.begin() + static_cast<std::ptrdiff_t>( position ), gItem );
+
+        if( i % 3 == 2 )
+        {
+          auto const victim = ( position * 7 ) % expected.size();
+          list.remove( victim );
+          expected.erase( expected.begin() + static_cast<std::ptrdiff_t>( victim ) );
+        }
+      }
+
+      List reference;
+      reference.insert( expected.begin(), expected.end(), 0 );
+      affirm.is_equal( "Positional edits - contents", reference, list );
+
+      // Promote grocery items to the top in a scattered order, then copy the list and keep promoting both, so the copy's nodes are
+      // known to be its own
+      auto promote = [&expected]( List & groceryList, std::size_t offset )
+      {
+        groceryList.moveToTop( expected[offset] );
+        std::rotate( expected.begin(), expected.begin() + static_cast<std::ptrdiff_t>( offset ), expected.begin() + static_cast<std::ptrdiff_t>( offset ) + 1 );
+      };
+      for( std::size_t i = 0; i < 200; ++i )   promote( list, ( i * 37 + 11 ) % expected.size() );
+
+      List copy = list;
+      promote( list, expected.size() - 1 );                                 // the bottom grocery item, in both lists
+      copy.moveToTop( expected.front() );
+      reference = List{};
+      reference.insert( expected.begin(), expected.end(), 0 );
+      affirm.is_true( "Most recently used - contents", list == reference  &&  copy == reference );
+
+      bool found = true;
+      for( std::size_t offset = 0; offset < expected.size(); ++offset )   found = found  &&  list.find( expected[offset] ) == offset;
+      affirm.is_true( "Positional edits - find",     found && list.find( GroceryItem( "absent" ) ) == list.size() );
+    }
+
+    {
+      // The content hash follows every modification, ignores order, and lets grocery lists be keys
+      List list1 = {gItem_1, gItem_2, gItem_3},  list2 = {gItem_3, gItem_1, gItem_2},  list3 = {gItem_1, gItem_2, gItem_4};
+      affirm.is_true( "Content hash - same grocery items, any order",  list1.hash() == list2.hash()  &&  list1 != list2 );
+      affirm.is_true( "Content hash - different grocery items",        list1.hash() != list3.hash()  &&  list1 != list3 );
+
+      auto const before = list1.hash();
+      list1.moveToTop( gItem_3 );
+      affirm.is_true( "Content hash - move to top",                    list1.hash() == before  &&  list1 == list2 );
+
+      list1.insert( gItem_5, 1 );
+      list1 += {gItem_6, gItem_4};
+      list1.remove( gItem_5 );
+      list1.remove( 3 );
+      list1.remove( gItem_4 );
+      affirm.is_true( "Content hash - insert and remove",              list1.hash() == before  &&  list1 == list2 );
+
+      List moved = std::move( list3 );
+      affirm.is_true( "Content hash - moved from",                     list3.hash() == List{}.hash() );   // moving leaves an empty list behind
+
+      std::unordered_set<List> lists = { list1, list2, moved, List{} };
+      affirm.is_equal( "Content hash - unordered container key", 3U, lists.size() );
+    }
+
+    {
+      // Union keeps each grocery item where it first occurs, whether done by one thread or several
+      std::vector<List> lists = { {gItem_1, gItem_2, gItem_3}, {gItem_3, gItem_4, gItem_1}, {}, {gItem_5, gItem_2, gItem_6} };
+      affirm.is_equal( "Union - small", List{gItem_1, gItem_2, gItem_3, gItem_4, gItem_5, gItem_6}, List::unionOf( lists ) );
+      affirm.is_equal( "Union - none",  List{},                                                     List::unionOf( {} )    );
+
+      // Large enough to be split across threads, with every list overlapping the others
+      std::vector<std::vector<GroceryItem>> items( 3 );
+      for( unsigned i = 0; i < 60'000; ++i )   items[i % 3].emplace_back( "GroceryItem-" + std::to_string( ( i * 7 ) % 50'000 ) );
+
+      std::vector<List> households( 3 );
+      for( std::size_t i = 0; i < 3; ++i )   households[i].appendRange( items[i] );
+
+      List expected;
+      for( auto const & household : households )   expected += household;
+      affirm.is_equal( "Union - threaded", expected, List::unionOf( households, 4 ) );
+    }
+
+    {
+      // Copies kept as an undo history must each stay as they were, however the list or the other copies change afterwards
+      List              list    = {gItem_1, gItem_2};
+      std::vector<List> history = {list};
+
+      list.insert   ( gItem_3, List::Position::BOTTOM );   history.push_back( list );
+      list.remove   ( gItem_1                         );   history.push_back( list );
+      list.moveToTop( gItem_3                         );   history.push_back( list );
+      list.insert   ( gItem_1, 1                      );   history.push_back( list );
+
+      auto branch = history[1];
+      branch.remove( 0 );
+      branch.insert( gItem_4 );
+
+      std::vector<List> expected = { {gItem_1, gItem_2}, {gItem_1, gItem_2, gItem_3}, {gItem_2, gItem_3}, {gItem_3, gItem_2}, {gItem_3, gItem_1, gItem_2} };
+      affirm.is_true ( "Snapshots - undo history",           history == expected                      );
+      affirm.is_equal( "Snapshots - branch from an old copy", ( List{gItem_4, gItem_2, gItem_3} ), branch );
+      affirm.is_equal( "Snapshots - find in an old copy",     2U,                                   history[1].find( gItem_3 ) );
+    }
+
+    if constexpr( AllocatorAwareStorage<typename List::Storage> )
+    {
+      // A grocery list given an arena allocates there and nowhere else, its grocery items' product names included:  with no default
+      // resource to fall back on, it still takes every change.  Copies leave the arena, and assigning to the arena's grocery list
+      // copies into it.
+      std::pmr::monotonic_buffer_resource arena;
+      List                                list( &arena );
+      bool                                allocated = true;
+      GroceryItem const                   longName ( "A product name too long to be stored inline" ),
+                                          longBatch( "Another product name too long to be stored inline" );
+      {
+        struct NoDefaultResource
+        {
+          std::pmr::memory_resource * previous = std::pmr::set_default_resource( std::pmr::null_memory_resource() );
+         ~NoDefaultResource() { std::pmr::set_default_resource( previous ); }
+        } const noDefaultResource;
+
+        try
+        {
+          list += {gItem_1, gItem_2, gItem_3, gItem_4};
+          list.insert     ( gItem_5,  List::Position::BOTTOM );
+          list.insert     ( longName, List::Position::BOTTOM );
+          list.appendRange( std::span( &longBatch, 1 ) );
+          list.remove     ( gItem_2 );
+          list.moveToTop  ( gItem_4 );
+          list.moveToTop  ( longName );
+        }
+        catch( const std::bad_alloc & )
+        {
+          allocated = false;
+        }
+      }
+
+      List copy = list;
+      list = List{gItem_6};
+
+      affirm.is_true ( "Arena - from the arena only",       allocated                                                                  );
+      affirm.is_equal( "Arena - copies leave the arena",    ( List{longName, gItem_4, gItem_1, gItem_3, gItem_5, longBatch} ), copy );
+      affirm.is_equal( "Arena - assigning into the arena",  List{gItem_6},                                                       list );
+    }
+
+    {
+      // A patch turns one grocery list into the other with edits only for what changed, and survives a round trip through text,
+      // prices with more significant digits than a stream shows by default included
+      GroceryItem const pricey( "Pricey", "Brand", "pricey", 1'234'567.891 );
+      List from = {gItem_1, gItem_2, gItem_3, gItem_4, gItem_5};
+      List to   = {gItem_4, gItem_1, gItem_2, gItem_6, pricey, gItem_3};
+
+      auto const patch   = List::diff( from, to );
+      auto       replica = from;
+      replica.apply( patch );
+
+      std::stringstream text;
+      GroceryListPatch  extracted;
+      text << patch;
+      text >> extracted;
+      auto fromText = from;
+      fromText.apply( extracted );
+
+      affirm.is_equal( "Patch - apply",                   to, replica                          );
+      affirm.is_equal( "Patch - one edit per change",     4U, patch.edits().size()             );  // gItem_5 removed, gItem_4 moved, gItem_6 and pricey inserted
+      affirm.is_true ( "Patch - round trip through text", extracted == patch                   );
+      affirm.is_equal( "Patch - apply from text",         to, fromText                         );
+      affirm.is_true ( "Patch - equal lists",             List::diff( to, to ).empty()         );
+      affirm.is_equal( "Patch - to empty and back",       from,
+                       [&] { List empty;  empty.apply( List::diff( empty, from ) );  return empty; }() );
+
+      // Larger lists, rearranged every which way:  a block reversed, a block rotated, some removed, and some new
+      std::vector<GroceryItem> items;
+      for( unsigned i = 0; i < 300; ++i )   items.emplace_back( "Patch item " + std::to_string( i ), "Brand", std::to_string( i ), i * 0.25 );
+
+      List before, after;
+      before.appendRange( std::span( items ).first( 240 ) );
+      std::reverse( items.begin() +  20, items.begin() +  60 );
+      std::rotate ( items.begin() + 100, items.begin() + 130, items.begin() + 180 );
+      for( std::size_t i = 0; i < items.size(); ++i )   if( i % 17 != 5 ) after.insert( items[i], List::Position::BOTTOM );
+
+      auto forward = before, backward = after;
+      forward .apply( List::diff( before, after ) );
+      backward.apply( List::diff( after, before ) );
+      affirm.is_equal( "Patch - rearranged",           after,  forward  );
+      affirm.is_equal( "Patch - rearranged, reversed", before, backward );
+
+      try
+      {
+        from.apply( List::diff( to, from ) );
+        affirm.is_true( "Patch - wrong grocery list", false );
+      }
+      catch( const GroceryListPatch::Mismatch_Ex & )  // expected
+      {
+        affirm.is_equal( "Patch - wrong grocery list", ( List{gItem_1, gItem_2, gItem_3, gItem_4, gItem_5} ), from );
+      }
+
+      // The same grocery items rearranged aren't the grocery list the patch was made from.  Nor does a patch apply whose edits don't
+      // fit, even part way:  here, read from text, a removal that fits followed by an insertion past the bottom.
+      auto refused = [&]( List list, GroceryListPatch const & wrong )
+      {
+        auto const unchanged = list;
+        try                                                 { list.apply( wrong );  return false; }
+        catch( const GroceryListPatch::Mismatch_Ex & )      { return list == unchanged;           }
+      };
+
+      std::stringstream malformed;
+      malformed << patch.baseSize() << ' ' << patch.baseHash() << ' ' << patch.resultHash() << " 2\n- 4 " << gItem_5 << "\n+ 9 " << gItem_6 << '\n';
+      GroceryListPatch outOfRange;
+      malformed >> outOfRange;
+
+      affirm.is_true( "Patch - rearranged grocery list", refused( {gItem_5, gItem_4, gItem_3, gItem_2, gItem_1}, patch ) );
+      affirm.is_true( "Patch - malformed, nothing applied", malformed  &&  outOfRange.edits().size() == 2  &&  refused( from, outOfRange ) );
+      auto edited = [&]( std::vector<GroceryListPatch::Edit> edits )
+      {
+        return GroceryListPatch( patch.baseSize(), patch.baseHash(), patch.resultHash(), std::move( edits ) );
+      };
+      using Operation = GroceryListPatch::Operation;
+      affirm.is_true( "Patch - removal of another item",   refused( from, edited( { { Operation::REMOVE,      0, gItem_2 } } ) ) );
+      affirm.is_true( "Patch - move of a missing item",    refused( from, edited( { { Operation::REMOVE,      4, gItem_5 },
+                                                                                    { Operation::MOVE_TO_TOP, 0, gItem_5 } } ) ) );
+      affirm.is_true( "Patch - insertion already there",   refused( from, edited( { { Operation::INSERT,      0, gItem_6 },
+                                                                                    { Operation::INSERT,      0, gItem_3 } } ) ) );
+      affirm.is_true( "Patch - insertion twice",           refused( from, edited( { { Operation::INSERT,      0, gItem_6 },
+                                                                                    { Operation::INSERT,      3, gItem_6 } } ) ) );
+      affirm.is_true( "Patch - edits out of order",        refused( from, edited( { { Operation::MOVE_TO_TOP, 0, gItem_4 },
+                                                                                    { Operation::REMOVE,      4, gItem_5 } } ) ) );
+
+      // A replica kept in sync patch after patch, each checked against the hash the one before left, and then edited directly
+      List       synced    = from;
+      List const steps[]   = { to, {gItem_6, gItem_2}, {gItem_2, gItem_6, gItem_1}, {} };
+      List       previous  = from;
+      bool       inStep    = true;
+      for( auto const & step : steps )
+      {
+        synced.apply( List::diff( previous, step ) );
+        inStep   = inStep  &&  synced == step;
+        previous = step;
+      }
+      synced.insert( gItem_3, List::Position::TOP );
+      previous.insert( gItem_3, List::Position::TOP );
+      synced.apply( List::diff( previous, List{gItem_4} ) );
+      affirm.is_true( "Patch - patch after patch", inStep  &&  synced == List{gItem_4} );
+    }
+
+    {
+      // A catalog holds the same grocery items column by column, converts back unchanged, and scans its columns as a grocery list's
+      // queries would answer
+      GroceryItem const ketchup( "Heinz Tomato Ketchup - 2 Ct",            "Heinz",         "00013000001243", 4.49 ),
+                        mustard( "Heinz Yellow Mustard",                   "Heinz",         "013000006309",   1.99 ),
+                        dinner ( "Boston Market Spaghetti With Meatballs", "Boston Market", "051600080015",   5.29 ),
+                        oddUpc ( "Store Brand Salt",                       "",              "SKU-1234",       0.50 );
+
+      List const     list = {ketchup, mustard, dinner, oddUpc};
+      GroceryCatalog catalog( list );
+      auto const     toList = [&] { return catalog.template toGroceryList<typename List::Storage>(); };
+
+      affirm.is_equal( "Catalog - round trip",         list,                      toList()                                           );
+      affirm.is_equal( "Catalog - grocery item",       dinner,                    catalog.groceryItem( 2 )                           );
+      affirm.is_equal( "Catalog - brands stored once", 3U,                        catalog.brandCount()                               );
+      affirm.is_equal( "Catalog - total",              list.total(),              catalog.total()                                    );
+      affirm.is_equal( "Catalog - total of a brand",   Money::fromMills( 6'480 ), catalog.total( catalog.brandId( "Heinz" ).value() ) );
+      affirm.is_equal( "Catalog - find by UPC",        3U,                        catalog.find( UpcCode( "SKU-1234" ) )              );
+      affirm.is_equal( "Catalog - count priced",       2U,                        catalog.countPriced( Money::fromDollars( 1.99 ), Money::fromDollars( 4.49 ) ) );
+      affirm.is_true ( "Catalog - price range",        catalog.priceRange( Money::fromDollars( 1.00 ), Money::fromDollars( 5.00 ) ) == std::vector<std::size_t>{ 0, 1 } );
+      affirm.is_true ( "Catalog - not found",          catalog.find( UpcCode( "999" ) ) == catalog.size()  &&  !catalog.brandId( "Kraft" ) );
+
+      catalog.append( ketchup );
+      affirm.is_equal( "Catalog - duplicates kept",    5U,                        catalog.size()                                     );
+      affirm.is_equal( "Catalog - skipped converting", list,                      toList()                                           );
+      affirm.is_equal( "Catalog - empty round trip",   List{},                    GroceryCatalog( List{} ).template toGroceryList<typename List::Storage>() );
+    }
+
+    {
+      // A concurrent grocery list behaves as a grocery list does, one version at a time, and a snapshot never changes once taken
+      using Concurrent = BasicConcurrentGroceryList<typename List::Storage>;
+
+      List       list = {gItem_1, gItem_2, gItem_3};
+      Concurrent shared( list );
+      auto const before = shared.snapshot();
+
+      list  .insert( gItem_4, List::Position::BOTTOM );   shared.insert( gItem_4, List::Position::BOTTOM );
+      list  .insert( gItem_5, 1                      );   shared.insert( gItem_5, 1                      );
+      list  .moveToTop( gItem_3 );                        shared.moveToTop( gItem_3 );
+      list  .remove( gItem_1 );                           shared.remove( gItem_1 );
+      list  .remove( 2 );                                 shared.remove( 2 );
+      shared.update( [&]( List & groceryList ) { groceryList.insert( gItem_6 );  groceryList.remove( gItem_6 ); } );
+
+      std::ostringstream expected, actual;
+      expected << list;
+      actual   << shared;
+
+      affirm.is_equal( "Concurrent - same as a grocery list", list, *shared.snapshot() );
+      affirm.is_equal( "Concurrent - size and find",          list.find( gItem_4 ) + list.size(), shared.find( gItem_4 ) + shared.size() );
+      affirm.is_equal( "Concurrent - insertion operator",     expected.str(), actual.str() );
+      affirm.is_equal( "Concurrent - snapshot unchanged",     ( List{gItem_1, gItem_2, gItem_3} ), *before );
+      affirm.is_equal( "Concurrent - nested read",            list.size() * 2,
+                       shared.read( [&]( List const & outer ) { shared.insert( gItem_6 );  return outer.size() + shared.size() - 1; } ) );
 
       try
       {
-        for( unsigned i = 0; i < 100; ++i ) list.insert( GroceryItem{ "GroceryItem-" + std::to_string( i ) } );
-        affirm.is_true( "Fixed size array capacity check", false );
+        shared.update( [&]( List & groceryList ) { groceryList.remove( 0 );  groceryList.insert( gItem_1, 10 ); } );
+        affirm.is_true( "Concurrent - failed update not published", false );
       }
-      catch ( const GroceryList::CapacityExceeded_Ex & )  // expected
+      catch( const typename List::InvalidOffset_Ex & )  // expected
       {
-        affirm.is_true( "Fixed size array capacity check", true );
+        affirm.is_equal( "Concurrent - failed update not published", list.size() + 1, shared.size() );
+      }
+
+      // Neither the reading thread nor the list holds on to a version once it's been replaced and no read() is using it
+      auto const read = shared.snapshot();
+      shared.read( []( List const & groceryList ) { return groceryList.size(); } );
+      shared.insert( gItem_6 );
+      affirm.is_equal( "Concurrent - replaced version let go", 1L, read.use_count() );
+    }
+
+    {
+      // Stress:  writers add and remove grocery items two at a time, and move them about, while readers check every version they
+      // see has both of each pair or neither, and that a snapshot held across writes doesn't change
+      using Concurrent = BasicConcurrentGroceryList<typename List::Storage>;
+      constexpr unsigned writers = 2,  readers = 4,  pairs = 300;
+
+      Concurrent             shared( List{gItem_1, gItem_2} );
+      std::atomic<unsigned>  writing    = writers;
+      std::atomic<unsigned>  violations = 0;
+      std::vector<std::jthread> threads;
+
+      for( unsigned w = 0; w < writers; ++w )   threads.emplace_back( [&, w]
+      {
+        auto item = [w]( unsigned k, char half ) { return GroceryItem( "Writer " + std::to_string( w ) + " pair " + std::to_string( k ) + half ); };
+        for( unsigned k = 0; k < pairs; ++k )
+        {
+          shared.update( [&]( List & groceryList ) { groceryList.insert( item( k, 'a' ), List::Position::BOTTOM );  groceryList.insert( item( k, 'b' ) ); } );
+          shared.moveToTop( k % 2 == 0 ? gItem_1 : gItem_2 );
+          if( k % 3 == 2 )   shared.update( [&]( List & groceryList ) { groceryList.remove( item( k - 1, 'b' ) );  groceryList.remove( item( k - 1, 'a' ) ); } );
+        }
+        --writing;
+      } );
+
+      for( unsigned r = 0; r < readers; ++r )   threads.emplace_back( [&]
+      {
+        while( writing > 0 )
+        {
+          auto const held = shared.snapshot();
+          auto const size = held->size();
+
+          shared.read( [&]( List const & groceryList )
+          {
+            if( groceryList.size() % 2 != 0 )   ++violations;
+            for( unsigned k = 0; k < pairs; k += 7 )
+            {
+              GroceryItem const a( "Writer 0 pair " + std::to_string( k ) + 'a' ), b( "Writer 0 pair " + std::to_string( k ) + 'b' );
+              if( ( groceryList.find( a ) == groceryList.size() ) != ( groceryList.find( b ) == groceryList.size() ) )   ++violations;
+            }
+          } );
+
+          if( held->size() != size  ||  shared.find( gItem_1 ) == shared.size() )   ++violations;
+        }
+      } );
+
+      threads.clear();                                                              // joins them all
+
+      affirm.is_equal( "Concurrent - stress, whole versions only", 0U,                                 violations.load() );
+      affirm.is_equal( "Concurrent - stress, final size",          2 + writers * 2 * ( pairs - pairs / 3 ), shared.size()  );
+    }
+
+    {
+      // Draining a queue is the same as inserting its grocery items at the bottom one at a time, in the order they were pushed,
+      // including across segments and in batches
+      GroceryItemQueue queue;
+      List             drained = {gItem_1}, expected = {gItem_1};
+
+      std::vector<GroceryItem> pushed = {gItem_2, gItem_1, gItem_3, gItem_2};
+      for( std::size_t i = 0; i < 2 * GroceryItemQueue::SEGMENT_SIZE + 3; ++i )   pushed.emplace_back( "Queued " + std::to_string( i % 1'000 ) );
+
+      for( auto const & groceryItem : pushed )   queue.push( groceryItem );
+      for( auto const & groceryItem : pushed )   expected.insert( groceryItem, List::Position::BOTTOM );
+
+      affirm.is_equal( "Queue - batch limit",                  5U,                  queue.drainInto( drained, 5 ) );
+      affirm.is_equal( "Queue - drain the rest",               pushed.size() - 5,   queue.drainInto( drained    ) );
+      affirm.is_equal( "Queue - nothing left",                 0U,                  queue.drainInto( drained    ) );
+      affirm.is_equal( "Queue - arrival order, no duplicates", expected,            drained                      );
+    }
+
+    if constexpr( AllocatorAwareStorage<typename List::Storage> )
+    {
+      // A batch the grocery list refuses stays in the queue:  a grocery list with nowhere to allocate throws, and the next grocery
+      // list drained into still gets every grocery item, in arrival order.  The product names are too long to be stored inline, so
+      // even a storage holding the grocery items inline has to allocate them.
+      GroceryItemQueue  queue;
+      List              full( std::pmr::null_memory_resource() ), drained;
+      GroceryItem const long_1( "A product name too long to be stored inline, 1" ),
+                        long_2( "A product name too long to be stored inline, 2" ),
+                        long_3( "A product name too long to be stored inline, 3" ),
+                        long_4( "A product name too long to be stored inline, 4" );
+
+      for( auto const & groceryItem : {long_1, long_2, long_3} )   queue.push( groceryItem );
+
+      bool refused = false;
+      try                              { queue.drainInto( full, 2 ); }
+      catch( const std::bad_alloc & )  { refused = true;             }
+      queue.push( long_4 );
+
+      affirm.is_true ( "Queue - refused batch, thrown",     refused                                            );
+      affirm.is_equal( "Queue - refused batch, retried",    4U,                                queue.drainInto( drained ) );
+      affirm.is_equal( "Queue - refused batch, not lost",   ( List{long_1, long_2, long_3, long_4} ), drained );
+    }
+
+    {
+      // Many producers pushing while the consumer drains:  nothing lost or repeated, and each producer's grocery items arrive in
+      // the order it pushed them
+      constexpr unsigned producers = 4,  pushes = 3'000;
+
+      GroceryItemQueue          queue;
+      List                      drained;
+      std::atomic<unsigned>     producing = producers;
+      std::vector<std::jthread> threads;
+
+      for( unsigned p = 0; p < producers; ++p )   threads.emplace_back( [&, p]
+      {
+        for( unsigned k = 0; k < pushes; ++k )   queue.push( GroceryItem( "Producer " + std::to_string( p ), "Brand", std::to_string( k ) ) );
+        --producing;
+      } );
+
+      while( producing > 0 )   queue.drainInto( drained, 100 );
+      threads.clear();
+      queue.drainInto( drained );
+
+      // Product names say which producer, UPC codes which push
+      std::vector<long> last( producers, -1 );
+      bool              inOrder = true;
+      for( auto const * groceryItem : drained.startingWith( "Producer " ) )
+      {
+        auto const p = std::stoul( std::string( std::string_view( groceryItem->productName() ).substr( 9 ) ) );
+        auto const k = std::stol ( groceryItem->upcCode    ()             );
+        if( k <= last[p] ) inOrder = false;
+        last[p] = k;
+      }
+
+      affirm.is_equal( "Queue - stress, nothing lost or repeated", producers * pushes, drained.size() );
+      affirm.is_true ( "Queue - stress, each producer in order",   inOrder                            );
+    }
+
+    {
+      // Producers that never pause must not keep drained segments from being freed:  drain 128 segments' worth while they push
+      // without letup, and the segments waiting to be freed must not pile up.  How many wait at once depends on when producers get
+      // descheduled part way through a push(), so the bound is loose, but segments never freed would all still be waiting
+      constexpr std::size_t drainSegments = 128;
+      constexpr std::size_t drainCount    = drainSegments * GroceryItemQueue::SEGMENT_SIZE;
+
+      GroceryItemQueue          queue;
+      List                      drained;
+      std::atomic<bool>         stop = false;
+      std::vector<std::jthread> threads;
+      for( unsigned p = 0; p < 2; ++p )   threads.emplace_back( [&, p]
+      {
+        for( unsigned k = 0; !stop  &&  k < 4 * drainCount; ++k )   queue.push( GroceryItem( "Sustained " + std::to_string( p ), "Brand", std::to_string( k ) ) );
+      } );
+
+      std::size_t mostRetired = 0;
+      while( drained.size() < drainCount )
+      {
+        queue.drainInto( drained, 256 );
+        mostRetired = std::max( mostRetired, queue.retired() );
+      }
+      stop = true;
+
+      affirm.is_true( "Queue - sustained pushes, segments freed", mostRetired < drainSegments / 2 );
+    }
+
+    {
+      // Price and product name queries agree whether answered by sorted indexes or by sorting on demand, before and after edits,
+      // with ties coming out in list order
+      auto names = []( typename List::Items const & items )
+      {
+        std::vector<std::string> result;
+        for( auto item : items )   result.emplace_back( item->productName() );
+        return result;
+      };
+      using Names = std::vector<std::string>;
+
+      List unordered = { {"milk", "", "", 1.50}, {"bread", "", "", 0.99}, {"apples", "", "", 1.50}, {"eggs", "", "", 2.25}, {"bread", "Wonder", "", 0.99} };
+      List ordered   = unordered;
+      ordered.ordered( true );
+
+      bool agree = ordered.ordered()  &&  !unordered.ordered();
+      for( auto const & list : { &unordered, &ordered } )
+      {
+        agree = agree  &&  names( list->priceRange( Money::fromDollars( 0.99 ), Money::fromDollars( 1.50 ) ) ) == Names{ "bread", "bread", "milk", "apples" }
+                       &&  names( list->priceRange( Money::fromDollars( 2.00 ), Money::fromDollars( 1.00 ) ) ).empty()
+                       &&  names( list->cheapest  ( 3                                                        ) ) == Names{ "bread", "bread", "milk" }
+                       &&  names( list->cheapest  ( 99                                                       ) ).size() == list->size()
+                       &&  names( list->byName    (                                                          ) ) == Names{ "apples", "bread", "bread", "eggs", "milk" };
+      }
+      affirm.is_true( "Ordered queries - price range, cheapest, by name", agree );
+
+      for( auto list : { &unordered, &ordered } )
+      {
+        list->insert( GroceryItem{ "butter", "", "", 3.10 }, 2 );
+        list->remove( GroceryItem{ "eggs", "", "", 2.25 } );
+        list->moveToTop( GroceryItem{ "apples", "", "", 1.50 } );
+        *list += { GroceryItem{ "cereal", "", "", 0.50 }, GroceryItem{ "bread", "", "", 0.99 }, GroceryItem{ "apples", "Gala", "", 1.50 } };
+      }
+      affirm.is_true( "Ordered queries - after edits",  names( ordered.cheapest( 4 ) ) == Names{ "cereal", "bread", "bread", "apples" }
+                                                    &&  names( ordered.byName()      ) == names( unordered.byName() )
+                                                    &&  ordered.priceRange( Money{}, Money::fromDollars( 99 ) ) == ordered.cheapest( ordered.size() ) );
+
+      ordered.ordered( false );
+      affirm.is_true( "Ordered queries - opt out",      !ordered.ordered()  &&  names( ordered.byName() ) == names( unordered.byName() ) );
+    }
+
+    {
+      // Name searches agree whether answered by the search index or by looking at every grocery item, before and after edits, and
+      // ignore letter case
+      auto names = []( typename List::Items const & items )
+      {
+        std::vector<std::string> result;
+        for( auto item : items )   result.emplace_back( item->productName() );
+        return result;
+      };
+      using Names = std::vector<std::string>;
+
+      List plain = { {"Potato Chips", "Lay's"}, {"Sweet Potatoes", "Farm Fresh"}, {"Tortilla Chips", "Tostitos"}, {"Chocolate Milk", "Potomac Dairy"} };
+      List searchable = plain;
+      searchable.searchable( true );
+
+      bool agree = searchable.searchable()  &&  !plain.searchable();
+      for( auto const & list : { &plain, &searchable } )
+      {
+        agree = agree  &&  names( list->startingWith( "POTATO CH" ) ) == Names{ "Potato Chips" }
+                       &&  names( list->startingWith( "pot"       ) ) == Names{ "Potato Chips", "Chocolate Milk" }    // by product and by brand name
+                       &&  names( list->containing  ( "chips"     ) ) == Names{ "Potato Chips", "Tortilla Chips" }
+                       &&  names( list->containing  ( "to"        ) ) == Names{ "Potato Chips", "Sweet Potatoes", "Tortilla Chips", "Chocolate Milk" }
+                       &&  list->containing  ( "potato chips!" ).empty()
+                       &&  list->startingWith( ""              ).size() == list->size();
+      }
+      affirm.is_true( "Search - prefix and substring", agree );
+
+      for( auto list : { &plain, &searchable } )
+      {
+        list->insert( GroceryItem{ "Potato Salad", "Deli" }, 1 );
+        list->remove( GroceryItem{ "Potato Chips", "Lay's" } );
+        list->moveToTop( GroceryItem{ "Chocolate Milk", "Potomac Dairy" } );
+        *list += { GroceryItem{ "Kettle Chips", "Cape Cod" }, GroceryItem{ "Potato Chips", "Lay's" } };
+      }
+      affirm.is_true( "Search - after edits",  names( searchable.startingWith( "potato" ) ) == Names{ "Potato Salad", "Potato Chips" }
+                                           &&  names( searchable.containing  ( "chips"  ) ) == Names{ "Tortilla Chips", "Kettle Chips", "Potato Chips" }
+                                           &&  names( searchable.containing  ( "potat"  ) ) == names( plain.containing( "POTAT" ) ) );
+    }
+
+    {
+      List list;
+      for( unsigned i = 0; i < 100; ++i ) list.insert( GroceryItem{ "GroceryItem-" + std::to_string( i ) } );
+      affirm.is_equal( "Unbounded capacity check", 100U, list.size() );
+    }
+
+    {
+      // Ten dimes and two dollars are exactly $3.00, where adding up doubles drifts
+      List list;
+      for( unsigned i = 0; i < 10; ++i ) list.insert( GroceryItem{ "dime-" + std::to_string( i ), "", "", 0.10 }, List::Position::BOTTOM );
+      list.insert( GroceryItem{ "two dollars", "", "", 2.00 } );
+      affirm.is_equal( "Total - exact", Money::fromMills( 3'000 ), list.total() );
+      affirm.is_equal( "Total - empty", Money{},                   List{}.total() );
+
+      GroceryItem yacht( "yacht" ),  jet( "jet" );
+      yacht.price( Money::fromMills( std::numeric_limits<Money::Mills>::max() / 2 + 1 ) );
+      jet  .price( Money::fromMills( std::numeric_limits<Money::Mills>::max() / 2 + 1 ) );
+      List expensive = { yacht, jet };
+      try
+      {
+        expensive.total();
+        affirm.is_true( "Total - overflow", false );
+      }
+      catch( Money::Overflow_Ex const & )
+      {
+        affirm.is_true( "Total - overflow", true );
       }
     }
   }  // GroceryListRegressionTest::test()
@@ -164,27 +927,27 @@ namespace    // anonymous
 
   void GroceryListRegressionTest::deepArrayInterrogationTest()
   {
-    // Inserting and removing from the array attribute is particularly error prone.  Let's dig deeper into this looking for
-    // hard-to-spot logic errors.  The attributes of the GroceryList are private, so I can't get to them in the usual way.  If
-    // you're reading this, don't do what I'm about to do - this is strictly for testing, and then only in a very controlled
-    // environment. If the order of attributes in GroceryList, or if other attributes are added - I'm screwed.  Not to mention I'm
-    // depending on GroceryList.hpp including what I need here.  By creating a struct that mirrors the attribute layout of the
-    // GroceryList I ensure proper attribute alignment and offset while gaining visibility.
-    struct Attributes                                                                         // must exactly match the type and order of GroceryList's instance attributes
-    {
-      std::array       <GroceryItem, 11>    _gList_array;
-      std::vector      <GroceryItem    >    _gList_vector;
-      std::list        <GroceryItem    >    _gList_dll;
-      std::forward_list<GroceryItem    >    _gList_sll;
-      std::size_t                           _gList_array_size = 0;
+    // Inserting and removing from the shadow storage's small vector attribute is particularly error prone, especially as it
+    // outgrows its inline buffer and moves to the heap.  Let's dig deeper into this looking for hard-to-spot logic errors.  The
+    // attributes of the GroceryList are private, so I can't get to them in the usual way.  If you're reading this, don't do what
+    // I'm about to do - this is strictly for testing, and then only in a very controlled environment. If the order of attributes
+    // in GroceryList, or if other attributes are added - I'm screwed.  Not to mention I'm depending on GroceryList.hpp including
+    // what I need here.  By creating a struct that mirrors the attribute layout of the GroceryList I ensure proper attribute
+    // alignment and offset while gaining visibility.  The storage is the grocery list's first attribute, so the storage's
+    // attributes are at the very beginning of the grocery list.
+    struct Attributes                                                                         // must exactly match the type and order of ShadowStorage's instance attributes
+    {
+      SmallVector      <GroceryItem, defaultInlineCapacity>   _gList_array;
+      std::vector      <GroceryItem                       >   _gList_vector;
+      std::list        <GroceryItem                       >   _gList_dll;
+      std::forward_list<GroceryItem                       >   _gList_sll;
     };
 
 
 
-    // Convert an array to string.  The STL does not define an insertion operator for std::array, which is needed if an std::array
-    // is passed to Regression::CheckResults::is_equal.  So instead of passing standard arrays, let's convert the array to a string
-    // and pass the string to Regression::CheckResults::is_equal.  Perhaps a better approach would be to create insertion operator
-    // templates in Regression::CheckResults, but this gets the job done with less ripple effect, for now ...
+    // Convert a container to string.  Neither SmallVector nor the STL containers define an insertion operator, which is needed if
+    // a container is passed to Regression::CheckResults::is_equal.  So instead of passing containers, let's convert them to a
+    // string and pass the string to Regression::CheckResults::is_equal.
     auto to_string = []( const auto & container ) -> std::string
     {
       std::ostringstream s;
@@ -198,58 +961,61 @@ namespace    // anonymous
 
     // Create a grocery list and access its private instance attributes, something we should never do outside of a controlled
     // white-box test like this
-    GroceryList   list;
+    BasicGroceryList<ShadowStorage<>> list;
     auto &        list_attributes = reinterpret_cast<Attributes &>( list );    // direct access to list's private parts
     auto &        actual_array    = list_attributes._gList_array;
-    auto &        actual_size     = list_attributes._gList_array_size;
 
-    decltype( Attributes::_gList_array      ) expected_array;
-    decltype( Attributes::_gList_array_size ) expected_size = 0;
+    std::vector<GroceryItem> expected_array;                                                  // the reference model
 
 
 
     auto verify_arrays = [&]( char const * const message, std::size_t id )
     {
       // Only tally the mismatches and don't flood results with the matches
-      if( expected_array != actual_array )
+      if( !std::equal( expected_array.begin(), expected_array.end(), actual_array.begin(), actual_array.end() ) )
       {
         // native containers don't have an insertion operator, so convert to string and then compare the strings
         affirm.is_equal( "Array management deep interrogation (array) #" + std::to_string( id ) + " :  " + message, to_string( expected_array ), to_string( actual_array ) );
       }
 
-      if( actual_size != expected_size )
+      if( actual_array.size() != expected_array.size() )
       {
-        affirm.is_equal( "Array management deep interrogation (size) #" + std::to_string( id ) + " :  " + message, expected_size, actual_size );
+        affirm.is_equal( "Array management deep interrogation (size) #" + std::to_string( id ) + " :  " + message, expected_array.size(), actual_array.size() );
       }
     };
 
 
 
-    // The tests below assume all unused spots of the expected array are filled with default constructed items.  Tests fail when
-    // unused spots have something other than a default constructed item. Spots are filled with items that leave a residue after
-    // moving, making then easy to detect if not cleaned up.
+    // Grocery items are created with a price that leaves a residue after moving, making them easy to detect if not cleaned up.
 
 
     // fill it up from the top ...
-    while( expected_size < expected_array.size() )                                            // yes, all the way to capacity, not just _gList_array_size
+    while( expected_array.size() < defaultInlineCapacity )                                    // all the way to the inline capacity
     {
-      GroceryItem gItem{ "item #" + std::to_string( expected_size ), "", "", 9876543.21 };    // something that will be recognizable after a move.  Strings will be cleared but not the price
+      GroceryItem gItem{ "item #" + std::to_string( expected_array.size() ), "", "", 9876543.21 };  // something that will be recognizable after a move.  Strings will be cleared but not the price
 
       list.insert( gItem, GroceryList::Position::TOP );
+      expected_array.insert( expected_array.begin(), std::move( gItem ) );
+
+      verify_arrays( "Fill to inline capacity", __LINE__ );
+    }
+    affirm.is_true( "Array management deep interrogation (inline when full)", actual_array.isInline() );
 
-      std::move_backward( expected_array.begin(), expected_array.end() - 1, expected_array.end() );
-      expected_array[0] = std::move( gItem );
-      ++expected_size;
 
-      verify_arrays( "Fill to capacity", __LINE__ );
+    { // Grow past the inline capacity at the top
+      GroceryItem gItem{ "item #" + std::to_string( __LINE__ ), "", "", 9876543.21 };
+
+      list.insert( gItem, GroceryList::Position::TOP );
+      expected_array.insert( expected_array.begin(), std::move( gItem ) );
+
+      verify_arrays( "Grow past inline capacity at top", __LINE__ );
+      affirm.is_true( "Array management deep interrogation (moved to heap)", !actual_array.isInline() );
     }
 
 
     { // Remove from the top
       list.remove( 0 );
-      std::move( expected_array.begin() + 1, expected_array.end(), expected_array.begin() );
-      *( expected_array.end() - 1 ) = {};
-      --expected_size;
+      expected_array.erase( expected_array.begin() );
 
       verify_arrays( "Remove from top", __LINE__ );
     }
@@ -257,90 +1023,98 @@ namespace    // anonymous
 
     { // Remove the one after the top
       list.remove( 1 );
-      std::move( expected_array.begin() + 2, expected_array.end(), expected_array.begin() + 1 );
-      *( expected_array.end() - 1 ) = {};
-      --expected_size;
+      expected_array.erase( expected_array.begin() + 1 );
 
       verify_arrays( "Remove 1st after top", __LINE__ );
     }
 
 
-    { // Insert at the bottom with 2 empty slots available
+    { // Insert at the bottom
       GroceryItem gItem{ "item #" + std::to_string( __LINE__ ), "", "", 9876543.21 };
 
       list.insert( gItem, GroceryList::Position::BOTTOM );
-      *( expected_array.end() - 2 ) = std::move( gItem );
-      ++expected_size;
+      expected_array.push_back( std::move( gItem ) );
 
-      verify_arrays( "Insert at bottom with extra capacity", __LINE__ );
+      verify_arrays( "Insert at bottom", __LINE__ );
     }
 
 
-    { // Insert at the bottom with 1 empty slot available
+    { // Insert just above the bottom
       GroceryItem gItem{ "item #" + std::to_string( __LINE__ ), "", "", 9876543.21 };
 
-      list.insert( gItem, actual_size - 1 );
-      std::move_backward( expected_array.end() - 2, expected_array.end() - 1, expected_array.end() );
-      *( expected_array.end() - 2 ) = std::move( gItem );
-      ++expected_size;
+      list.insert( gItem, list.size() - 1 );
+      expected_array.insert( expected_array.end() - 1, std::move( gItem ) );
 
-      verify_arrays( "Insert at bottom with no extra capacity", __LINE__ );
+      verify_arrays( "Insert just above bottom", __LINE__ );
     }
 
 
-    { // Remove first-from-bottom of a full list
-      list.remove( actual_size - 2 );
-
-      std::move( expected_array.end() - 1, expected_array.end(), expected_array.end() - 2 );
-      *( expected_array.end() - 1 ) = {};
-      --expected_size;
+    { // Remove first-from-bottom
+      list.remove( list.size() - 2 );
+      expected_array.erase( expected_array.end() - 2 );
 
-      verify_arrays( "Remove first-from-bottom of a full list", __LINE__ );
+      verify_arrays( "Remove first-from-bottom", __LINE__ );
     }
 
 
-    { // Remove bottom of a full list
-      GroceryItem gItem{ "item #" + std::to_string( __LINE__ ), "", "", 9876543.21 };
+    { // Remove bottom
+      list.remove( list.size() - 1 );
+      expected_array.pop_back();
 
-      list.insert( gItem, GroceryList::Position::BOTTOM );                                    // fill the list back up to capacity (replace the item removed above)
-      affirm.is_equal( "Array management deep interrogation (capacity)", actual_array.size(), actual_size );
+      verify_arrays( "Remove bottom", __LINE__ );
+    }
 
-      list.remove( actual_array.size() - 1);
 
-      verify_arrays( "Remove bottom of a full list", __LINE__ );
+    { // Keep growing, in the middle, well past several reallocations
+      for( unsigned i = 0; i < 10 * defaultInlineCapacity; ++i )
+      {
+        GroceryItem gItem{ "item #" + std::to_string( __LINE__ ) + '.' + std::to_string( i ), "", "", 9876543.21 };
+
+        list.insert( gItem, list.size() / 2 );
+        expected_array.insert( expected_array.begin() + static_cast<std::ptrdiff_t>( expected_array.size() / 2 ), std::move( gItem ) );
+      }
+
+      verify_arrays( "Growing in the middle", __LINE__ );
     }
 
-    { //  Moving too much when erasing?
-      // start with a half full list
-      while( list.size() > actual_array.size() / 2 ) list.remove( 0 );
-      expected_array = actual_array;
-      expected_size  = actual_size;
 
-      // Fill the upper half with recognizable junk
-      for( auto i = actual_size; i < actual_array.size(); ++i )
+    { // Batches shorter than, longer than, and big enough to outgrow what follows the insertion point
+      for( std::size_t count : { std::size_t{ 2 }, std::size_t{ 5 }, 4 * actual_array.capacity() } )
       {
-        actual_array[i] = expected_array[i] = { "item #" + std::to_string( __LINE__ ) + '.' +  std::to_string(i), "", "", 9876543.21 };
+        std::vector<GroceryItem> batch;
+        for( std::size_t i = 0; i < count; ++i ) batch.push_back( { "item #" + std::to_string( __LINE__ ) + '.' + std::to_string( count ) + '.' + std::to_string( i ), "", "", 9876543.21 } );
+
+        auto const offset = list.size() - 3;
+        list.insert( batch.begin(), batch.end(), offset );
+        expected_array.insert( expected_array.begin() + static_cast<std::ptrdiff_t>( offset ), batch.begin(), batch.end() );
+
+        verify_arrays( "Bulk insert near the bottom", __LINE__ );
       }
+    }
 
-      // now remove something from the lower half
-      list.remove( 2 );
 
-      std::move( expected_array.begin() + 3, expected_array.begin() + expected_size, expected_array.begin() + 2 );
-      --expected_size;
-      actual_array[expected_size] = expected_array[expected_size] = {};                       // ignore the "hole" differences, this was checked above and gives false positives when whole not cleaned
+    { // Shrink from the middle back to empty
+      while( list.size() > 0 )
+      {
+        list.remove( list.size() / 2 );
+        expected_array.erase( expected_array.begin() + static_cast<std::ptrdiff_t>( expected_array.size() / 2 ) );
+      }
 
-      verify_arrays( "Moving too much when erasing", __LINE__ );
+      verify_arrays( "Shrinking from the middle", __LINE__ );
     }
 
-    { //  Moving too much when inserting?
-      GroceryItem gItem{ "item #" + std::to_string( __LINE__ ), "", "", 9876543.21 };
-      list.insert( gItem, 1 );
 
-      std::move_backward( expected_array.begin() + 1, expected_array.begin() + expected_size, expected_array.begin() + expected_size + 1 );
-      expected_array[1] = gItem;
-      ++expected_size;
+    { // Copies of a grown grocery list are independent, and copies of a short one stay inline
+      BasicGroceryList<ShadowStorage<>> copy;
+      for( unsigned i = 0; i < 2 * defaultInlineCapacity; ++i ) copy.insert( GroceryItem{ "item #" + std::to_string( i ) }, GroceryList::Position::BOTTOM );
+
+      list = copy;
+      copy.remove( 0 );
+      affirm.is_equal( "Array management deep interrogation (independent copies)", 2 * defaultInlineCapacity, list.size() );
 
-      verify_arrays( "Moving too much when inserting", __LINE__ );
+      BasicGroceryList<ShadowStorage<>> shortList = { GroceryItem{ "item #1" }, GroceryItem{ "item #2" } };
+      list = std::move( shortList );
+      affirm.is_true( "Array management deep interrogation (short copies inline)", actual_array.isInline() && actual_array.size() == 2 );
     }
   }    // GroceryListRegressionTest::deepArrayInterrogationTest()
 
@@ -355,8 +1129,23 @@ namespace    // anonymous
 
     try
     {
-      std::clog << "\nGroceryList Regression Tests:\n";
-      test();
+      std::clog << "\nGroceryList Regression Tests (SmallVectorStorage):\n";
+      test<GroceryList>();
+
+      std::clog << "\nGroceryList Regression Tests (VectorStorage):\n";
+      test<BasicGroceryList<VectorStorage>>();
+
+      std::clog << "\nGroceryList Regression Tests (ListStorage):\n";
+      test<BasicGroceryList<ListStorage>>();
+
+      std::clog << "\nGroceryList Regression Tests (TreeStorage):\n";
+      test<BasicGroceryList<TreeStorage>>();
+
+      std::clog << "\nGroceryList Regression Tests (PersistentStorage):\n";
+      test<BasicGroceryList<PersistentStorage>>();
+
+      std::clog << "\nGroceryList Regression Tests (ShadowStorage):\n";
+      test<BasicGroceryList<ShadowStorage<>>>();
 
       std::clog << "\nGroceryList Deep Array Interrogation Tests:\n";
       deepArrayInterrogationTest();
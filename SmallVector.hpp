@@ -0,0 +1,528 @@
+#pragma once                                                                                  // include guard
+
+#include <algorithm>                                                                          // move(), move_backward(), copy(), equal(), max()
+#include <concepts>                                                                           // derived_from
+#include <cstddef>                                                                            // size_t, ptrdiff_t, byte
+#include <initializer_list>
+#include <iterator>                                                                           // iterator_traits, forward_iterator_tag, distance(), next()
+#include <memory>                                                                             // allocator, allocator_traits, uninitialized_move(), make_obj_using_allocator()
+#include <new>                                                                                // launder()
+#include <stdexcept>                                                                          // length_error
+#include <type_traits>                                                                        // is_nothrow_move_constructible_v
+#include <utility>                                                                            // move(), exchange()
+
+
+// Multi-pass iterators as std::vector::insert sees them.  Unlike std::forward_iterator, this accepts std::move_iterator over
+// a forward iterator, so a range can be moved in.
+template<typename It>
+concept legacyForwardIterator = std::derived_from<typename std::iterator_traits<It>::iterator_category, std::forward_iterator_tag>;
+
+
+
+// A contiguous sequence container that keeps its first N elements inside the object itself and only goes to the heap when it grows
+// beyond that.  Short sequences never allocate, long ones grow geometrically (doubling) just like std::vector.  Once on the heap it
+// stays there until assigned a short enough sequence - shrinking back inline as elements are erased isn't worth the churn.
+//
+// Like std::vector, the heap block comes from the allocator and new elements are constructed with it, so an allocator aware element
+// type given a std::pmr::polymorphic_allocator allocates from its resource too.  The allocator is fixed for the SmallVector's
+// lifetime, as it is for the std::pmr containers:  copies select theirs with select_on_container_copy_construction() unless given
+// one, and assigning keeps this one's.
+//
+// Only the handful of operations the grocery lists need are provided, with std::vector's names and semantics.
+template<typename T, std::size_t N, typename Allocator = std::allocator<T>>   requires ( N > 0 )
+class SmallVector
+{
+  private:
+    using Traits = std::allocator_traits<Allocator>;
+
+  public:
+    // Types
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T       &;
+    using const_reference = T const &;
+    using iterator        = T       *;
+    using const_iterator  = T const *;
+    using allocator_type  = Allocator;
+
+    static constexpr size_type inlineCapacity = N;
+
+
+    // Constructors, assignments, and destructor
+    SmallVector() noexcept = default;
+    explicit SmallVector( Allocator const & allocator ) noexcept;
+    SmallVector( std::initializer_list<T> initList, Allocator const & allocator = Allocator() );
+
+    SmallVector            ( SmallVector const  & other );
+    SmallVector            ( SmallVector const  & other, Allocator const & allocator );
+    SmallVector            ( SmallVector       && other ) noexcept( std::is_nothrow_move_constructible_v<T> );
+    SmallVector            ( SmallVector       && other, Allocator const & allocator );           // moves the elements one at a time if the allocators differ
+    SmallVector & operator=( SmallVector const  & rhs   ) &;
+    SmallVector & operator=( SmallVector       && rhs   ) & noexcept( std::is_nothrow_move_constructible_v<T>  &&  Traits::is_always_equal::value );
+   ~SmallVector            (                            ) noexcept;
+
+
+    // Queries
+    size_type size    () const noexcept  { return _size;                    }
+    size_type capacity() const noexcept  { return _capacity;                }
+    bool      empty   () const noexcept  { return _size == 0;               }
+    bool      isInline() const noexcept  { return _data == inlineBuffer();  }                // true if the elements live inside this object (no heap allocation)
+
+    allocator_type get_allocator() const noexcept  { return _allocator;     }
+
+
+    // Accessors
+    iterator        begin ()       noexcept  { return _data;                }
+    iterator        end   ()       noexcept  { return _data + _size;        }
+    const_iterator  begin () const noexcept  { return _data;                }
+    const_iterator  end   () const noexcept  { return _data + _size;        }
+    const_iterator  cbegin() const noexcept  { return _data;                }
+    const_iterator  cend  () const noexcept  { return _data + _size;        }
+
+    reference       operator[]( size_type offset )       noexcept  { return _data[offset]; }
+    const_reference operator[]( size_type offset ) const noexcept  { return _data[offset]; }
+
+
+    // Modifiers
+    iterator insert   ( const_iterator position, T const & value );                           // inserts before position, returns an iterator to the inserted element
+
+    template<typename ForwardIt>  requires legacyForwardIterator<ForwardIt>                  // [first, last) must not refer to this SmallVector's own elements
+    iterator insert   ( const_iterator position, ForwardIt first, ForwardIt last );           // inserts the range before position, returns an iterator to the first inserted element
+    iterator erase    ( const_iterator position                  );                           // returns an iterator to the element following the removed one
+    void     push_back( T const & value                          );
+    void     pop_back (                                          ) noexcept;
+    void     reserve  ( size_type newCapacity                    );
+    void     clear    (                                          ) noexcept;
+
+
+    // Relational Operators
+    bool operator==( SmallVector const & rhs ) const  { return std::equal( begin(), end(), rhs.begin(), rhs.end() ); }
+
+
+  private:
+    // Instance Attributes
+    alignas( T ) std::byte _buffer[N * sizeof( T )];                                          // raw inline storage, elements constructed in place as needed
+    T *                    _data     = inlineBuffer();                                        // the elements, either inside _buffer or on the heap
+    size_type              _size     = 0;
+    size_type              _capacity = N;
+    [[no_unique_address]]
+    Allocator              _allocator;                                                        // the heap block and every new element are allocated with this
+
+
+    // Helper member functions
+    T       * inlineBuffer()       noexcept  { return std::launder( reinterpret_cast<T       *>( _buffer ) ); }
+    T const * inlineBuffer() const noexcept  { return std::launder( reinterpret_cast<T const *>( _buffer ) ); }
+
+    void      release     () noexcept;                                                        // destroys all elements and frees the heap block, if any, going back inline
+    void      takeFrom    ( SmallVector && other );                                           // assumes this is empty and inline, and other's allocator equal to this one's.
+                                                                                              // Leaves other empty and inline
+    size_type grownCapacity() const;                                                          // the next (geometric) capacity
+
+    template<typename InputIt>
+    void      constructAt ( T * destination, InputIt first, InputIt last );                  // constructs [first, last) with the allocator starting at destination, all or none
+};
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Constructors, assignments, and destructor
+*******************************************************************************/
+
+// Allocator Constructor
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+SmallVector<T, N, Allocator>::SmallVector( Allocator const & allocator ) noexcept
+  : _allocator( allocator )
+{}
+
+
+
+// Initializer List Constructor
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+SmallVector<T, N, Allocator>::SmallVector( std::initializer_list<T> initList, Allocator const & allocator )
+  : _allocator( allocator )
+{
+  reserve( initList.size() );
+  constructAt( _data, initList.begin(), initList.end() );
+  _size = initList.size();
+}
+
+
+
+// Copy constructor
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+SmallVector<T, N, Allocator>::SmallVector( SmallVector const & other )
+  : SmallVector( other, Traits::select_on_container_copy_construction( other._allocator ) )
+{}
+
+
+
+// Allocator extended copy constructor
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+SmallVector<T, N, Allocator>::SmallVector( SmallVector const & other, Allocator const & allocator )
+  : _allocator( allocator )
+{
+  reserve( other._size );
+  constructAt( _data, other.begin(), other.end() );
+  _size = other._size;
+}
+
+
+
+// Move constructor
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+SmallVector<T, N, Allocator>::SmallVector( SmallVector && other ) noexcept( std::is_nothrow_move_constructible_v<T> )
+  : _allocator( other._allocator )
+{
+  takeFrom( std::move( other ) );
+}
+
+
+
+// Allocator extended move constructor
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+SmallVector<T, N, Allocator>::SmallVector( SmallVector && other, Allocator const & allocator )
+  : _allocator( allocator )
+{
+  if( _allocator == other._allocator )
+  {
+    takeFrom( std::move( other ) );
+    return;
+  }
+
+  // The heap block (or the elements in it) can't change allocators, so the elements are moved into one of this one's
+  reserve( other._size );
+  constructAt( _data, std::make_move_iterator( other.begin() ), std::make_move_iterator( other.end() ) );
+  _size = other._size;
+  other.clear();
+}
+
+
+
+// Copy Assignment Operator
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+SmallVector<T, N, Allocator> & SmallVector<T, N, Allocator>::operator=( SmallVector const & rhs ) &
+{
+  if( this != &rhs )
+  {
+    SmallVector temp( rhs, _allocator );                                                      // copy and swap, via the move assignment
+    *this = std::move( temp );
+  }
+  return *this;
+}
+
+
+
+// Move Assignment Operator
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+SmallVector<T, N, Allocator> & SmallVector<T, N, Allocator>::operator=( SmallVector && rhs ) & noexcept( std::is_nothrow_move_constructible_v<T>  &&  Traits::is_always_equal::value )
+{
+  if( this != &rhs )
+  {
+    if( _allocator == rhs._allocator )
+    {
+      release();
+      takeFrom( std::move( rhs ) );
+    }
+    else
+    {
+      SmallVector temp( std::move( rhs ), _allocator );                                       // into this one's allocator first, so a throw leaves this untouched
+      release();
+      takeFrom( std::move( temp ) );
+    }
+  }
+  return *this;
+}
+
+
+
+// Destructor
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+SmallVector<T, N, Allocator>::~SmallVector() noexcept
+{
+  release();
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// insert()
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+typename SmallVector<T, N, Allocator>::iterator SmallVector<T, N, Allocator>::insert( const_iterator position, T const & value )
+{
+  auto const offset = static_cast<size_type>( position - cbegin() );
+
+  if( _size == _capacity )
+  {
+    // Out of room.  Build the new, larger, block in one pass - the elements before the insertion point, then the new value, then
+    // the elements after - so nothing gets moved twice.
+    auto const newCapacity = grownCapacity();
+    T *        newData     = Traits::allocate( _allocator, newCapacity );
+
+    try
+    {
+      Traits::construct( _allocator, newData + offset, value );
+    }
+    catch( ... )
+    {
+      Traits::deallocate( _allocator, newData, newCapacity );
+      throw;
+    }
+
+    // Our own elements were constructed with the allocator, so they keep it moving as they are
+    std::uninitialized_move( begin(),          begin() + offset, newData              );
+    std::uninitialized_move( begin() + offset, end(),            newData + offset + 1 );
+
+    auto const newSize = _size + 1;
+    release();
+    _data     = newData;
+    _size     = newSize;
+    _capacity = newCapacity;
+  }
+
+  else if( offset == _size )
+  {
+    Traits::construct( _allocator, end(), value );
+    ++_size;
+  }
+
+  else
+  {
+    // value may refer to one of our own elements, which is about to move, so take a copy first (with the allocator, so it moves
+    // into place rather than being copied again).  Then open a hole by moving the last element into the raw slot at the end and
+    // shifting everything else at and after the insertion point right one slot.
+    T temp = std::make_obj_using_allocator<T>( _allocator, value );
+
+    new( end() ) T( std::move( *( end() - 1 ) ) );
+    std::move_backward( begin() + offset, end() - 1, end() );
+    ++_size;
+
+    _data[offset] = std::move( temp );
+  }
+
+  return begin() + offset;
+}
+
+
+
+// insert( range )
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+template<typename ForwardIt>  requires legacyForwardIterator<ForwardIt>
+typename SmallVector<T, N, Allocator>::iterator SmallVector<T, N, Allocator>::insert( const_iterator position, ForwardIt first, ForwardIt last )
+{
+  auto const offset = static_cast<size_type>( position - cbegin() );
+  auto const count  = static_cast<size_type>( std::distance( first, last ) );
+
+  if( count == 0 ) return begin() + offset;                                                   // not just a shortcut, shifting by zero would self-move
+
+  if( count > _capacity - _size )
+  {
+    // Out of room.  Just like inserting a single element, build the new block in one pass, but make sure it's big enough for the
+    // whole range.
+    auto const maxSize = Traits::max_size( _allocator );
+    if( count > maxSize - _size )   throw std::length_error( "SmallVector capacity exceeded" );
+
+    auto const newCapacity = std::max( grownCapacity(), _size + count );
+    T *        newData     = Traits::allocate( _allocator, newCapacity );
+
+    try
+    {
+      constructAt( newData + offset, first, last );
+    }
+    catch( ... )
+    {
+      Traits::deallocate( _allocator, newData, newCapacity );
+      throw;
+    }
+
+    std::uninitialized_move( begin(),          begin() + offset, newData                  );
+    std::uninitialized_move( begin() + offset, end(),            newData + offset + count );
+
+    auto const newSize = _size + count;
+    release();
+    _data     = newData;
+    _size     = newSize;
+    _capacity = newCapacity;
+  }
+
+  else
+  {
+    // Open a gap of count slots in one shift.  Elements landing beyond the current end are constructed in raw memory, the rest are
+    // assigned over (moved from) elements.
+    auto const tail   = _size - offset;                                                       // elements at and after the insertion point
+    T * const  oldEnd = end();
+
+    if( count <= tail )
+    {
+      std::uninitialized_move( oldEnd - count, oldEnd, oldEnd );
+      _size += count;
+      std::move_backward( begin() + offset, oldEnd - count, oldEnd );
+      std::copy( first, last, begin() + offset );
+    }
+    else
+    {
+      auto const middle = std::next( first, static_cast<difference_type>( tail ) );
+
+      constructAt( oldEnd, middle, last );
+      _size += count - tail;
+      std::uninitialized_move( begin() + offset, oldEnd, end() );
+      _size += tail;
+      std::copy( first, middle, begin() + offset );
+    }
+  }
+
+  return begin() + offset;
+}
+
+
+
+// erase()
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+typename SmallVector<T, N, Allocator>::iterator SmallVector<T, N, Allocator>::erase( const_iterator position )
+{
+  auto const offset = static_cast<size_type>( position - cbegin() );
+
+  // Close the hole by shifting everything after the removal point left one slot, then destroy the (now moved from) last element
+  std::move( begin() + offset + 1, end(), begin() + offset );
+  pop_back();
+
+  return begin() + offset;
+}
+
+
+
+// push_back()
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+void SmallVector<T, N, Allocator>::push_back( T const & value )
+{
+  insert( cend(), value );
+}
+
+
+
+// pop_back()
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+void SmallVector<T, N, Allocator>::pop_back() noexcept
+{
+  --_size;
+  Traits::destroy( _allocator, end() );
+}
+
+
+
+// reserve()
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+void SmallVector<T, N, Allocator>::reserve( size_type newCapacity )
+{
+  if( newCapacity <= _capacity ) return;
+
+  if( newCapacity > Traits::max_size( _allocator ) )   throw std::length_error( "SmallVector capacity exceeded" );
+
+  T * newData = Traits::allocate( _allocator, newCapacity );
+  std::uninitialized_move( begin(), end(), newData );
+
+  auto const size = _size;
+  release();
+  _data     = newData;
+  _size     = size;
+  _capacity = newCapacity;
+}
+
+
+
+// clear()
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+void SmallVector<T, N, Allocator>::clear() noexcept
+{
+  for( auto & element : *this )   Traits::destroy( _allocator, &element );
+  _size = 0;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Private member functions
+*******************************************************************************/
+
+// release()
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+void SmallVector<T, N, Allocator>::release() noexcept
+{
+  clear();
+
+  if( !isInline() )   Traits::deallocate( _allocator, _data, _capacity );
+
+  _data     = inlineBuffer();
+  _capacity = N;
+}
+
+
+
+// takeFrom()
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+void SmallVector<T, N, Allocator>::takeFrom( SmallVector && other )
+{
+  if( other.isInline() )
+  {
+    // Inline elements can't be stolen, they have to be moved one at a time
+    std::uninitialized_move( other.begin(), other.end(), _data );
+    _size = other._size;
+    other.clear();
+  }
+  else
+  {
+    // Steal the heap block and leave other empty and inline
+    _data     = std::exchange( other._data,     other.inlineBuffer() );
+    _size     = std::exchange( other._size,     0                    );
+    _capacity = std::exchange( other._capacity, N                    );
+  }
+}
+
+
+
+// grownCapacity() const
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+typename SmallVector<T, N, Allocator>::size_type SmallVector<T, N, Allocator>::grownCapacity() const
+{
+  auto const maxSize = Traits::max_size( _allocator );
+  if( _capacity >= maxSize )   throw std::length_error( "SmallVector capacity exceeded" );
+
+  return _capacity > maxSize / 2 ? maxSize : 2 * _capacity;
+}
+
+
+
+// constructAt()
+template<typename T, std::size_t N, typename Allocator>   requires ( N > 0 )
+template<typename InputIt>
+void SmallVector<T, N, Allocator>::constructAt( T * destination, InputIt first, InputIt last )
+{
+  T * next = destination;
+  try
+  {
+    for( ;  first != last;  ++first, ++next )   Traits::construct( _allocator, next, *first );
+  }
+  catch( ... )
+  {
+    while( next != destination )   Traits::destroy( _allocator, --next );
+    throw;
+  }
+}
@@ -0,0 +1,65 @@
+#include <cstddef>                                                                    // size_t
+#include <functional>                                                                 // hash
+#include <memory>                                                                     // make_shared(), shared_ptr
+#include <string>
+#include <string_view>
+#include <utility>                                                                    // move()
+
+#include "StringPool.hpp"
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Constructors
+*******************************************************************************/
+
+// HashedString
+HashedString::HashedString( std::string value ) noexcept
+  : text( std::move( value ) ), hash( std::hash<std::string_view>{}( text ) )
+{}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// size() const
+std::size_t StringPool::size() const noexcept
+{
+  return _strings ? _strings->size() : 0;
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Modifiers
+*******************************************************************************/
+
+// intern()
+std::shared_ptr<HashedString const> StringPool::intern( std::string_view text )
+{
+  if( !_strings )   _strings = std::make_shared<Strings>();
+
+  // Almost every lookup finds a string already interned, so look first and make a string only to add one.  The pointer handed out
+  // shares ownership of the whole set, so the string it points to outlives the pool if need be.
+  auto found = _strings->find( text );
+  if( found == _strings->end() )   found = _strings->emplace( std::string( text ) ).first;
+
+  return std::shared_ptr<HashedString const>( _strings, &*found );
+}
@@ -0,0 +1,62 @@
+#pragma once                                                                                  // include guard
+
+#include <cstddef>                                                                            // size_t
+#include <functional>                                                                         // hash
+#include <memory>                                                                             // shared_ptr
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+
+// An immutable string and its hash (as std::hash<std::string_view> would give), worked out once, so hashing whatever holds it
+// doesn't have to look at the text again
+struct HashedString
+{
+  explicit HashedString( std::string value ) noexcept;
+
+  std::string const text;
+  std::size_t const hash;
+};
+
+
+
+// A set of immutable strings, each stored once, for one loader (a GroceryItemParser, for example) to share among everything it
+// builds.  Interning a string returns a shared pointer to the pool's only copy of it, so strings interned from the same pool are
+// equal exactly when their addresses are, and copying one around is copying a shared pointer.  The pool's strings are released
+// together once the pool and every pointer into it are gone, so they last only as long as what was built from them.
+//
+// Not safe to intern from several threads at once.  Each loader has a pool of its own, so there's no lock to take.
+//
+// Meant for values that repeat a lot - brand names, for example - where a few distinct strings are shared by a great many objects.
+class StringPool
+{
+  public:
+    // Queries
+    std::size_t size() const noexcept;                                                        // returns the number of distinct strings interned so far
+
+
+    // Modifiers
+    std::shared_ptr<HashedString const> intern( std::string_view text );                     // returns the pool's copy of text, adding it if needed
+
+  private:
+    struct Hash                                                                               // heterogeneous lookup, so looking up a string_view doesn't make a string
+    {
+      using is_transparent = void;
+      std::size_t operator()( std::string_view     text   ) const noexcept { return std::hash<std::string_view>{}( text ); }
+      std::size_t operator()( HashedString const & string ) const noexcept { return string.hash; }
+    };
+
+    struct Equal
+    {
+      using is_transparent = void;
+      bool operator()( std::string_view lhs, std::string_view rhs ) const noexcept { return lhs == rhs; }
+      bool operator()( HashedString const & lhs, std::string_view rhs ) const noexcept { return lhs.text == rhs; }
+      bool operator()( std::string_view lhs, HashedString const & rhs ) const noexcept { return lhs == rhs.text; }
+      bool operator()( HashedString const & lhs, HashedString const & rhs ) const noexcept { return lhs.text == rhs.text; }
+    };
+
+    using Strings = std::unordered_set<HashedString, Hash, Equal>;                            // node based, so a string never moves once interned
+
+    // Instance Attributes
+    std::shared_ptr<Strings> _strings;                                                        // made by the first intern(), and owned by every pointer it hands out too
+};
@@ -0,0 +1,238 @@
+#include <atomic>
+#include <compare>                                                                    // strong_ordering
+#include <cstddef>                                                                    // size_t
+#include <cstdint>                                                                    // uint64_t, uintptr_t
+#include <functional>                                                                 // hash
+#include <string>
+#include <string_view>
+
+#include "UpcCode.hpp"
+
+
+
+
+/*******************************************************************************
+**  Implementation of non-member private types, objects, and functions
+*******************************************************************************/
+namespace    // unnamed, anonymous namespace
+{
+  // A code that can't be packed, shared by the copies of the UpcCode that made it
+  struct Unpacked
+  {
+    explicit Unpacked( std::string_view code ) : text( code ) {}
+
+    std::atomic<std::size_t> references = 1;
+    std::string const        text;
+  };
+
+
+
+  constexpr std::uint64_t powerOf10( std::size_t exponent ) noexcept
+  {
+    std::uint64_t result = 1;
+    while( exponent-- > 0 )   result *= 10;
+    return result;
+  }
+
+
+
+  // The low two bits say how a code is held:  x1 digits, 10 characters, 00 the address of a shared heap block (or 0, the empty code)
+  constexpr std::uint64_t TAG_MASK         = 0b11;
+  constexpr std::uint64_t DIGITS_TAG       = 0b01;                                    // low bit set marks digits
+  constexpr unsigned      LENGTH_POS       = 1;                                       // 4 bits of length ...
+  constexpr std::uint64_t LENGTH_MASK      = 0xF;
+  constexpr unsigned      VALUE_POS        = 5;                                       // ... then the value
+
+  constexpr std::uint64_t CHARACTERS_TAG   = 0b10;
+  constexpr unsigned      TEXT_LENGTH_POS  = 2;                                       // 3 bits of length, then the characters in the top 7 bytes, first
+  constexpr std::uint64_t TEXT_LENGTH_MASK = 0x7;                                     // character highest, zero padded
+  constexpr std::size_t   MAX_CHARACTERS   = 7;
+
+  static_assert( alignof( Unpacked ) >= 4, "shared heap blocks' addresses must leave the tag bits clear" );
+}    // unnamed, anonymous namespace
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Constructors
+*******************************************************************************/
+
+UpcCode::UpcCode( std::string_view code )
+{
+  if( code.empty() ) return;
+
+  std::uint64_t value    = 0;
+  bool          isDigits = code.size() <= MAX_PACKED_DIGITS;
+  for( std::size_t i = 0;  isDigits  &&  i < code.size();  ++i )
+  {
+    isDigits = code[i] >= '0'  &&  code[i] <= '9';
+    value    = value * 10 + static_cast<std::uint64_t>( code[i] - '0' );
+  }
+
+  if( isDigits )
+  {
+    _bits = ( value << VALUE_POS )  |  ( std::uint64_t{ code.size() } << LENGTH_POS )  |  DIGITS_TAG;
+  }
+  else if( code.size() <= MAX_CHARACTERS )
+  {
+    // SKU style codes (Ex: SKU-12, A12) are held as their characters, so they never allocate
+    _bits = ( std::uint64_t{ code.size() } << TEXT_LENGTH_POS )  |  CHARACTERS_TAG;
+    for( std::size_t i = 0; i < code.size(); ++i )   _bits |= std::uint64_t{ static_cast<unsigned char>( code[i] ) } << ( 56 - 8 * i );
+  }
+  else
+  {
+    _bits = reinterpret_cast<std::uintptr_t>( new Unpacked( code ) );
+  }
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Queries
+*******************************************************************************/
+
+// empty() const
+bool UpcCode::empty() const noexcept
+{
+  return _bits == 0;
+}
+
+
+
+// packed() const
+bool UpcCode::packed() const noexcept
+{
+  return ( _bits & TAG_MASK ) != 0;
+}
+
+
+
+// toString() const
+std::string UpcCode::toString() const
+{
+  Digits buffer;
+  return std::string( text( buffer ) );
+}
+
+
+
+// hash() const
+std::size_t UpcCode::hash() const noexcept
+{
+  // Packed digits and packed characters are unique per code, so mixing the bits is enough.  The multiply spreads them over the whole
+  // word (Fibonacci hashing), the shift brings the well mixed high bits down.  Equal long codes may be held in different blocks, so
+  // their text is hashed.
+  if( shared() )   return std::hash<std::string_view>{}( reinterpret_cast<Unpacked const *>( _bits )->text );
+
+  auto const mixed = _bits * 0x9e37'79b9'7f4a'7c15ULL;
+  return mixed ^ ( mixed >> 32 );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Relational Operators
+*******************************************************************************/
+
+// operator<=>()
+std::strong_ordering UpcCode::operator<=>( UpcCode const & rhs ) const noexcept
+{
+  if( _bits == rhs._bits ) return std::strong_ordering::equal;
+
+  // Characters are held first character highest with the length below them, so the words order just as the text does
+  if( ( _bits & TAG_MASK ) == CHARACTERS_TAG  &&  ( rhs._bits & TAG_MASK ) == CHARACTERS_TAG )   return _bits <=> rhs._bits;
+
+  if( ( _bits & DIGITS_TAG ) != 0  &&  ( rhs._bits & DIGITS_TAG ) != 0 )
+  {
+    // Text order for digit strings:  pad the shorter with trailing zeros and compare the values, and if they're still equal one is
+    // a prefix of the other (followed by zeros) and the shorter comes first.
+    auto const lhsLength = std::size_t{ ( _bits     >> LENGTH_POS ) & LENGTH_MASK };
+    auto const rhsLength = std::size_t{ ( rhs._bits >> LENGTH_POS ) & LENGTH_MASK };
+    auto const length    = lhsLength > rhsLength ? lhsLength : rhsLength;
+
+    auto const lhsValue  = ( _bits     >> VALUE_POS ) * powerOf10( length - lhsLength );
+    auto const rhsValue  = ( rhs._bits >> VALUE_POS ) * powerOf10( length - rhsLength );
+
+    if( auto const result = lhsValue <=> rhsValue;  result != 0 ) return result;
+    return lhsLength <=> rhsLength;
+  }
+
+  Digits lhsBuffer, rhsBuffer;
+  return text( lhsBuffer ) <=> rhs.text( rhsBuffer );
+}
+
+
+
+
+
+
+
+
+/*******************************************************************************
+**  Private member functions
+*******************************************************************************/
+
+// text() const
+std::string_view UpcCode::text( Digits & buffer ) const noexcept
+{
+  if( empty() ) return {};
+  if( !packed() ) return reinterpret_cast<Unpacked const *>( _bits )->text;
+
+  if( ( _bits & TAG_MASK ) == CHARACTERS_TAG )
+  {
+    auto const length = std::size_t{ ( _bits >> TEXT_LENGTH_POS ) & TEXT_LENGTH_MASK };
+    for( std::size_t i = 0; i < length; ++i )   buffer[i] = static_cast<char>( ( _bits >> ( 56 - 8 * i ) ) & 0xFF );
+    return { buffer.data(), length };
+  }
+
+  auto const length = std::size_t{ ( _bits >> LENGTH_POS ) & LENGTH_MASK };
+  auto       value  = _bits >> VALUE_POS;
+  for( auto i = length; i > 0; --i )
+  {
+    buffer[i - 1] = static_cast<char>( '0' + value % 10 );
+    value        /= 10;
+  }
+  return { buffer.data(), length };
+}
+
+
+
+// sameText() const
+bool UpcCode::sameText( UpcCode const & other ) const noexcept
+{
+  return reinterpret_cast<Unpacked const *>( _bits )->text == reinterpret_cast<Unpacked const *>( other._bits )->text;
+}
+
+
+
+// addReference() const
+void UpcCode::addReference() const noexcept
+{
+  // Only a copy being made from a holder adds a reference, so the count is never zero here and nothing needs ordering
+  reinterpret_cast<Unpacked *>( _bits )->references.fetch_add( 1, std::memory_order_relaxed );
+}
+
+
+
+// dropReference()
+void UpcCode::dropReference() noexcept
+{
+  // The last holder frees the block, after every other holder's use of it (acquire of their releases)
+  auto const unpacked = reinterpret_cast<Unpacked *>( _bits );
+  if( unpacked->references.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )   delete unpacked;
+}
@@ -0,0 +1,67 @@
+#pragma once                                                                                  // include guard
+
+#include <array>
+#include <compare>                                                                            // strong_ordering
+#include <cstddef>                                                                            // size_t
+#include <cstdint>                                                                            // uint64_t
+#include <string>
+#include <string_view>
+#include <utility>                                                                            // exchange()
+
+
+// A Universal Product Code held in a single 64-bit word.  Real UPCs are 12 or 14 decimal digits (Ex: 051600080015, 05017402006207),
+// so any all-digit code up to 15 digits long is packed as its value and its length (the length keeps the leading zeros).  Other
+// codes of up to 7 characters (Ex: SKU-12) are packed as the characters themselves.  Either way each packed code has exactly one
+// representation, so equality is a single integer compare, and ordering two packed codes of the same kind is integer arithmetic
+// that agrees with comparing their text.
+//
+// Anything longer is held by address, in a heap block shared by reference count among the copies of the code that made it and
+// freed with the last of them.  Long codes made separately are separate blocks, so they're compared by their text.  Real UPCs and
+// short codes never allocate.
+//
+// Text returned by toString() is at most 15 characters for packed codes, short enough for every standard library's small string
+// buffer, so it never allocates.
+class UpcCode
+{
+  public:
+    // Constructors, assignments, and destructor
+    UpcCode() noexcept = default;                                                             // the empty code
+    explicit UpcCode( std::string_view code );
+
+    UpcCode            ( UpcCode const & other ) noexcept : _bits( other._bits )                   { retain();  }
+    UpcCode            ( UpcCode      && other ) noexcept : _bits( std::exchange( other._bits, 0 ) ) {}
+    UpcCode & operator=( UpcCode const & rhs   ) noexcept { rhs.retain();  release();  _bits = rhs._bits;  return *this; }
+    UpcCode & operator=( UpcCode      && rhs   ) noexcept { if( this != &rhs ) { release();  _bits = std::exchange( rhs._bits, 0 ); }  return *this; }
+   ~UpcCode            (                       ) noexcept { release(); }
+
+
+    // Queries
+    bool        empty   () const noexcept;
+    bool        packed  () const noexcept;                                                    // true if held in the word itself rather than in a shared heap block
+    std::string toString() const;
+    std::size_t hash    () const noexcept;
+
+
+    // Relational Operators
+    std::strong_ordering operator<=>( UpcCode const & rhs ) const noexcept;                   // same order as comparing the codes' text
+    bool                 operator== ( UpcCode const & rhs ) const noexcept { return _bits == rhs._bits  ||  ( shared()  &&  rhs.shared()  &&  sameText( rhs ) ); }
+
+
+  private:
+    static constexpr std::size_t MAX_PACKED_DIGITS = 15;                                      // 10^15 fits in 50 bits, and 15 characters fit every small string buffer
+
+    using Digits = std::array<char, MAX_PACKED_DIGITS>;
+
+    // Instance Attributes
+    std::uint64_t _bits = 0;                                                                  // 0 is the empty code.  Low bit set:  value << 5 | length << 1 | 1.  Low bits 10:
+                                                                                              // the characters.  Low bits 00:  the address of the shared heap block
+
+    // Helper member functions
+    std::string_view text         ( Digits & buffer       ) const noexcept;                   // the code's text, packed codes are spelled out into buffer
+    bool             shared       (                       ) const noexcept { return _bits != 0  &&  ( _bits & 0b11 ) == 0; }
+    bool             sameText     ( UpcCode const & other ) const noexcept;                   // both shared, compares their text
+    void             retain       (                       ) const noexcept { if( shared() )   addReference();  }
+    void             release      (                       )       noexcept { if( shared() )   dropReference(); }
+    void             addReference (                       ) const noexcept;                   // one more copy shares the heap block
+    void             dropReference(                       )       noexcept;                   // one fewer does, and the last one frees it
+};